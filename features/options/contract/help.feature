@@ -12,6 +12,9 @@ Feature: osrm-contract command line options: help
         And stdout should contain "--threads"
         And stdout should contain "--core"
         And stdout should contain "--level-cache"
+        And stdout should contain "--renumber-nodes"
+        And stdout should contain "--witness-search-nodes"
+        And stdout should contain "--witness-search-hops"
         And stdout should contain "--segment-speed-file"
         And it should exit with an error
 
@@ -26,6 +29,9 @@ Feature: osrm-contract command line options: help
         And stdout should contain "--threads"
         And stdout should contain "--core"
         And stdout should contain "--level-cache"
+        And stdout should contain "--renumber-nodes"
+        And stdout should contain "--witness-search-nodes"
+        And stdout should contain "--witness-search-hops"
         And stdout should contain "--segment-speed-file"
         And it should exit successfully
 
@@ -40,5 +46,8 @@ Feature: osrm-contract command line options: help
         And stdout should contain "--threads"
         And stdout should contain "--core"
         And stdout should contain "--level-cache"
+        And stdout should contain "--renumber-nodes"
+        And stdout should contain "--witness-search-nodes"
+        And stdout should contain "--witness-search-hops"
         And stdout should contain "--segment-speed-file"
         And it should exit successfully
@@ -10,6 +10,7 @@ Feature: osrm-customize command line options: help
         And stdout should contain "--help"
         And stdout should contain "Configuration:"
         And stdout should contain "--threads"
+        And stdout should contain "--cch"
         And it should exit with an error
 
     Scenario: osrm-customize - Help, short
@@ -21,6 +22,7 @@ Feature: osrm-customize command line options: help
         And stdout should contain "--help"
         And stdout should contain "Configuration:"
         And stdout should contain "--threads"
+        And stdout should contain "--cch"
         And it should exit successfully
 
     Scenario: osrm-customize - Help, long
@@ -32,4 +34,5 @@ Feature: osrm-customize command line options: help
         And stdout should contain "--help"
         And stdout should contain "Configuration:"
         And stdout should contain "--threads"
+        And stdout should contain "--cch"
         And it should exit successfully
@@ -15,6 +15,10 @@ Feature: osrm-extract command line options: help
         And stdout should contain "--profile"
         And stdout should contain "--threads"
         And stdout should contain "--small-component-size"
+        And stdout should contain "--sort-memory"
+        And stdout should contain "--change-file"
+        And stdout should contain "--stages"
+        And stdout should contain "--resume"
         And it should exit successfully
 
     Scenario: osrm-extract - Help, short
@@ -28,6 +32,10 @@ Feature: osrm-extract command line options: help
         And stdout should contain "--profile"
         And stdout should contain "--threads"
         And stdout should contain "--small-component-size"
+        And stdout should contain "--sort-memory"
+        And stdout should contain "--change-file"
+        And stdout should contain "--stages"
+        And stdout should contain "--resume"
         And it should exit successfully
 
     Scenario: osrm-extract - Help, long
@@ -41,4 +49,8 @@ Feature: osrm-extract command line options: help
         And stdout should contain "--profile"
         And stdout should contain "--threads"
         And stdout should contain "--small-component-size"
+        And stdout should contain "--sort-memory"
+        And stdout should contain "--change-file"
+        And stdout should contain "--stages"
+        And stdout should contain "--resume"
         And it should exit successfully
@@ -0,0 +1,50 @@
+@extract @options @stages
+Feature: osrm-extract command line options: stages
+
+    Background:
+        Given the profile "testbot"
+        And the node map
+            """
+            a b
+            """
+        And the ways
+            | nodes |
+            | ab    |
+        And the data has been saved to disk
+
+    Scenario: osrm-extract - Running the stages separately
+        When I run "osrm-extract {osm_file} --profile {profile_file} --stages parse"
+        Then it should exit successfully
+        When I run "osrm-extract {osm_file} --profile {profile_file} --stages expand"
+        Then it should exit successfully
+        When I run "osrm-extract {osm_file} --profile {profile_file} --stages rtree"
+        Then it should exit successfully
+        And stdout should contain "finished r-tree construction"
+
+    Scenario: osrm-extract - Resuming after the last completed stage
+        When I run "osrm-extract {osm_file} --profile {profile_file} --stages parse,expand"
+        Then it should exit successfully
+        When I run "osrm-extract {osm_file} --profile {profile_file} --resume"
+        Then it should exit successfully
+        And stdout should contain "parse_checkpoint is up to date"
+        And stdout should contain "expand_checkpoint is up to date"
+        And stdout should contain "finished r-tree construction"
+
+    Scenario: osrm-extract - Resuming with different options
+        When I run "osrm-extract {osm_file} --profile {profile_file} --stages parse,expand"
+        Then it should exit successfully
+        When I run "osrm-extract {osm_file} --profile {profile_file} --resume --small-component-size 5"
+        Then it should exit successfully
+        And stdout should contain "parse_checkpoint is up to date"
+        And stdout should contain "expand_checkpoint was written with different options"
+        And stdout should contain "finished r-tree construction"
+
+    Scenario: osrm-extract - Missing checkpoint of an earlier stage
+        When I try to run "osrm-extract {osm_file} --profile {profile_file} --stages rtree"
+        Then stderr should contain "expand_checkpoint not found"
+        And it should exit with an error
+
+    Scenario: osrm-extract - Unknown stage
+        When I try to run "osrm-extract {osm_file} --profile {profile_file} --stages contract"
+        Then stderr should contain "Unknown stage contract"
+        And it should exit with an error
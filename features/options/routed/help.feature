@@ -21,6 +21,8 @@ Feature: osrm-routed command line options: help
         And stdout should contain "--max-trip-size"
         And stdout should contain "--max-table-size"
         And stdout should contain "--max-matching-size"
+        And stdout should contain "--max-queue-size"
+        And stdout should contain "--phantom-node-cache-size"
         And it should exit successfully
 
     Scenario: osrm-routed - Help, short
@@ -40,6 +42,8 @@ Feature: osrm-routed command line options: help
         And stdout should contain "--max-trip-size"
         And stdout should contain "--max-table-size"
         And stdout should contain "--max-matching-size"
+        And stdout should contain "--max-queue-size"
+        And stdout should contain "--phantom-node-cache-size"
         And it should exit successfully
 
     Scenario: osrm-routed - Help, long
@@ -59,4 +63,6 @@ Feature: osrm-routed command line options: help
         And stdout should contain "--max-table-size"
         And stdout should contain "--max-table-size"
         And stdout should contain "--max-matching-size"
+        And stdout should contain "--max-queue-size"
+        And stdout should contain "--phantom-node-cache-size"
         And it should exit successfully
@@ -39,6 +39,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <vector>
 
 #include <cstddef>
+#include <cstdint>
 
 namespace osrm
 {
@@ -65,9 +66,14 @@ class Contractor
                        std::vector<EdgeWeight> &&node_weights,
                        std::vector<bool> &is_core_node,
                        std::vector<float> &inout_node_levels) const;
-    void WriteCoreNodeMarker(std::vector<bool> &&is_core_node) const;
-    void WriteContractedGraph(unsigned number_of_edge_based_nodes,
+    void WriteCoreNodeMarker(const std::string &path, std::vector<bool> &&is_core_node) const;
+    void WriteContractedGraph(const std::string &path,
+                              unsigned number_of_edge_based_nodes,
                               util::DeallocatingVector<QueryEdge> contracted_edge_list);
+    // Writes the renumbered files next to the original ones, see stagedPath, and returns the
+    // paths of the original files
+    std::vector<std::string>
+    RenumberEdgeBasedNodes(const std::vector<std::uint32_t> &permutation) const;
 
   private:
     ContractorConfig config;
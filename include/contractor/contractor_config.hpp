@@ -33,6 +33,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/filesystem/path.hpp>
 
 #include <string>
+#include <vector>
 
 namespace osrm
 {
@@ -41,7 +42,11 @@ namespace contractor
 
 struct ContractorConfig
 {
-    ContractorConfig() : requested_num_threads(0) {}
+    ContractorConfig()
+        : renumber_nodes(true), requested_num_threads(0), witness_search_nodes{2000},
+          witness_search_hops{0}
+    {
+    }
 
     // Infer the output names from the path of the .osrm file
     void UseDefaultOutputNames()
@@ -50,6 +55,8 @@ struct ContractorConfig
         core_output_path = osrm_input_path.string() + ".core";
         graph_output_path = osrm_input_path.string() + ".hsgr";
         node_file_path = osrm_input_path.string() + ".enw";
+        cnbg_ebg_mapping_path = osrm_input_path.string() + ".cnbg_to_ebg";
+        partition_path = osrm_input_path.string() + ".partition";
         updater_config.osrm_input_path = osrm_input_path;
         updater_config.UseDefaultOutputNames();
     }
@@ -63,9 +70,15 @@ struct ContractorConfig
     std::string graph_output_path;
 
     std::string node_file_path;
+    std::string cnbg_ebg_mapping_path;
+    std::string partition_path;
 
     bool use_cached_priority;
 
+    // Renumber the edge-based nodes in the order of the hierarchy to improve the cache locality
+    // of queries. Skipped if the nodes were already renumbered for the cells of osrm-partition.
+    bool renumber_nodes;
+
     unsigned requested_num_threads;
 
     // A percentage of vertices that will be contracted for the hierarchy.
@@ -73,6 +86,13 @@ struct ContractorConfig
     // The remaining vertices form the core of the hierarchy
     //(e.g. 0.8 contracts 80 percent of the hierarchy, leaving a core of 20%)
     double core_factor;
+
+    // Limits of the witness searches for the phases of the contraction. The lists are spread
+    // evenly over the contracted nodes, e.g. {1, 2, 3, 5} hops limit the witness searches to
+    // a single hop while the first quarter of the nodes is contracted.
+    // A hop limit of 0 means unlimited hops.
+    std::vector<unsigned> witness_search_nodes;
+    std::vector<unsigned> witness_search_hops;
 };
 }
 }
@@ -6,21 +6,45 @@
 #include "util/typedefs.hpp"
 
 #include <cstddef>
+#include <cstdint>
 
 namespace osrm
 {
 namespace contractor
 {
 
+// counters of the witness searches of a thread
+struct WitnessSearchStats
+{
+    std::uint64_t searches = 0;
+    std::uint64_t settled_nodes = 0;
+    // searches that reached the limit of settled nodes before settling all targets
+    std::uint64_t stopped_at_node_limit = 0;
+    // settled nodes whose edges were not relaxed because of the hop limit
+    std::uint64_t pruned_at_hop_limit = 0;
+    double seconds = 0;
+
+    WitnessSearchStats &operator+=(const WitnessSearchStats &other)
+    {
+        searches += other.searches;
+        settled_nodes += other.settled_nodes;
+        stopped_at_node_limit += other.stopped_at_node_limit;
+        pruned_at_hop_limit += other.pruned_at_hop_limit;
+        seconds += other.seconds;
+        return *this;
+    }
+};
+
 // allow access to the heap itself, add Dijkstra functionality on top
 class ContractorDijkstra
 {
   public:
     ContractorDijkstra(std::size_t heap_size);
 
-    // search the graph up
+    // search the graph up, a hop limit of 0 does not restrict the number of edges of a path
     void Run(const unsigned number_of_targets,
              const int node_limit,
+             const unsigned hop_limit,
              const int weight_limit,
              const NodeID forbidden_node,
              const ContractorGraph &graph);
@@ -35,6 +59,8 @@ class ContractorDijkstra
     // cannot be const due to node-hash access in the binary heap :(
     ContractorHeap::WeightType GetKey(const NodeID node);
 
+    WitnessSearchStats &GetStats() { return stats; }
+
   private:
     void RelaxNode(const NodeID node,
                    const int node_weight,
@@ -42,6 +68,7 @@ class ContractorDijkstra
                    const ContractorGraph &graph);
 
     ContractorHeap heap;
+    WitnessSearchStats stats;
 };
 
 } // namespace contractor
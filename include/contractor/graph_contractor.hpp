@@ -30,6 +30,16 @@ namespace osrm
 namespace contractor
 {
 
+// Limits of the witness searches by contraction progress. Each list splits the contraction into
+// phases with equal numbers of contracted nodes and the i-th entry applies to the i-th phase.
+// Searches to evaluate the priority of a node settle at most half as many nodes.
+struct WitnessSearchSchedule
+{
+    std::vector<unsigned> settled_nodes{2000};
+    // 0 does not limit the number of edges of a witness
+    std::vector<unsigned> hops{0};
+};
+
 class GraphContractor
 {
   private:
@@ -92,7 +102,8 @@ class GraphContractor
     GraphContractor(int nodes,
                     std::vector<ContractorEdge> edges,
                     std::vector<float> &&node_levels_,
-                    std::vector<EdgeWeight> &&node_weights_);
+                    std::vector<EdgeWeight> &&node_weights_,
+                    WitnessSearchSchedule witness_search_schedule_ = {});
 
     /* Flush all data from the contraction to disc and reorder stuff for better locality */
     void FlushDataAndRebuildContractorGraph(ThreadDataContainer &thread_data_list,
@@ -274,21 +285,15 @@ class GraphContractor
                 }
             }
 
-            if (RUNSIMULATION)
-            {
-                const int constexpr SIMULATION_SEARCH_SPACE_SIZE = 1000;
-                dijkstra.Run(number_of_targets,
-                             SIMULATION_SEARCH_SPACE_SIZE,
-                             max_weight,
-                             node,
-                             *contractor_graph);
-            }
-            else
-            {
-                const int constexpr FULL_SEARCH_SPACE_SIZE = 2000;
-                dijkstra.Run(
-                    number_of_targets, FULL_SEARCH_SPACE_SIZE, max_weight, node, *contractor_graph);
-            }
+            const auto &limits = witness_search_phases.back();
+            const int search_space_size =
+                RUNSIMULATION ? limits.settled_nodes / 2 : limits.settled_nodes;
+            dijkstra.Run(number_of_targets,
+                         search_space_size,
+                         limits.hops,
+                         max_weight,
+                         node,
+                         *contractor_graph);
             for (auto out_edge : contractor_graph->GetAdjacentEdgeRange(node))
             {
                 const ContractorEdgeData &out_data = contractor_graph->GetEdgeData(out_edge);
@@ -379,6 +384,10 @@ class GraphContractor
 
     void DeleteIncomingEdges(ContractorThreadData *data, const NodeID node);
 
+    // Removes the new edges that duplicate a shortcut with the same direction, either in the
+    // graph or earlier in the list, and keeps the smaller weight. `edges` is sorted by source.
+    void MergeDuplicateShortcuts(std::vector<ContractorEdge> &edges);
+
     bool UpdateNodeNeighbours(std::vector<float> &priorities,
                               std::vector<NodeDepth> &node_depth,
                               ContractorThreadData *const data,
@@ -391,6 +400,26 @@ class GraphContractor
     // This bias function takes up 22 assembly instructions in total on X86
     bool Bias(const NodeID a, const NodeID b) const;
 
+    // Applies the limits of the phase of the contraction progress
+    void UpdateWitnessSearchLimits(const NodeID number_of_contracted_nodes,
+                                   const NodeID number_of_nodes);
+
+    // Adds the counters of all threads to the current phase and resets them
+    void CollectWitnessSearchStats(ThreadDataContainer &thread_data_list);
+
+    void LogWitnessSearchStats() const;
+
+    struct WitnessSearchPhase
+    {
+        double progress;
+        unsigned settled_nodes;
+        unsigned hops;
+        WitnessSearchStats stats;
+    };
+
+    WitnessSearchSchedule witness_search_schedule;
+    std::vector<WitnessSearchPhase> witness_search_phases;
+
     std::shared_ptr<ContractorGraph> contractor_graph;
     stxxl::vector<QueryEdge> external_edge_list;
     std::vector<NodeID> orig_node_id_from_new_node_id_map;
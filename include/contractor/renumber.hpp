@@ -0,0 +1,70 @@
+#ifndef OSRM_CONTRACTOR_RENUMBER_HPP
+#define OSRM_CONTRACTOR_RENUMBER_HPP
+
+#include "contractor/query_edge.hpp"
+
+#include "extractor/edge_based_edge.hpp"
+#include "extractor/nbg_to_ebg.hpp"
+
+#include "util/deallocating_vector.hpp"
+#include "util/renumber.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace osrm
+{
+namespace contractor
+{
+
+using util::renumber;
+
+// Computes a permutation of the nodes of the contracted graph that keeps nodes close in the
+// hierarchy close in memory. The nodes are numbered in the preorder of a depth-first search that
+// starts at the top of the hierarchy (the core, then all nodes without edges to higher nodes) and
+// descends to lower nodes. The upward searches of a query settle a node and the nodes above it,
+// which end up in a few contiguous ranges instead of being spread over the whole graph.
+std::vector<std::uint32_t> makePermutation(const std::size_t number_of_nodes,
+                                           const util::DeallocatingVector<QueryEdge> &edges,
+                                           const std::vector<bool> &is_core_node);
+
+inline void renumber(util::DeallocatingVector<QueryEdge> &edges,
+                     const std::vector<std::uint32_t> &permutation)
+{
+    for (auto &edge : edges)
+    {
+        edge.source = permutation[edge.source];
+        edge.target = permutation[edge.target];
+        // only shortcuts store a node, other edges store the id of the turn
+        if (edge.data.shortcut)
+            edge.data.turn_id = permutation[edge.data.turn_id];
+    }
+}
+
+inline void renumber(std::vector<extractor::EdgeBasedEdge> &edges,
+                     const std::vector<std::uint32_t> &permutation)
+{
+    for (auto &edge : edges)
+    {
+        edge.source = permutation[edge.source];
+        edge.target = permutation[edge.target];
+    }
+}
+
+inline void renumber(std::vector<extractor::NBGToEBG> &mapping,
+                     const std::vector<std::uint32_t> &permutation)
+{
+    for (auto &entry : mapping)
+    {
+        entry.forward_ebg_node = permutation[entry.forward_ebg_node];
+        if (entry.backward_ebg_node != SPECIAL_NODEID)
+            entry.backward_ebg_node = permutation[entry.backward_ebg_node];
+    }
+}
+}
+}
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef OSRM_CUSTOMIZER_CUSTOMIZABLE_HIERARCHY_HPP
+#define OSRM_CUSTOMIZER_CUSTOMIZABLE_HIERARCHY_HPP
+
+#include "contractor/query_edge.hpp"
+#include "extractor/edge_based_edge.hpp"
+#include "partition/multi_level_partition.hpp"
+
+#include "util/deallocating_vector.hpp"
+#include "util/typedefs.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace osrm
+{
+namespace customizer
+{
+
+// Ranks the nodes in the nested dissection order of the partition. A node with an edge to another
+// cell on level l separates the cells of that level and is ranked above all nodes that only
+// separate cells of lower levels. The separators of the same cell are ranked together, inside of
+// them the nodes with the fewest neighbours are contracted first.
+std::vector<NodeID> makeNestedDissectionOrder(const std::size_t number_of_nodes,
+                                              const partition::MultiLevelPartition &mlp,
+                                              const std::vector<extractor::EdgeBasedEdge> &edges);
+
+// A customizable contraction hierarchy (CCH): the shortcuts only depend on the order of the nodes.
+// Contracting a node connects all of its higher neighbours without witness searches, so the arcs
+// are built once for the order and Customize computes their weights for any metric bottom-up
+// over the lower triangles of every arc. The customized arcs form a contraction hierarchy that
+// the CH queries use unchanged.
+class CustomizableHierarchy
+{
+  public:
+    CustomizableHierarchy(std::vector<NodeID> ranks,
+                          const std::vector<extractor::EdgeBasedEdge> &edges);
+
+    // Computes the weights of all arcs for the weights of the edges, which need to be the edges
+    // the hierarchy was built from. Loops are only kept if they are cheaper than the node weight.
+    void Customize(const std::vector<extractor::EdgeBasedEdge> &edges,
+                   const std::vector<EdgeWeight> &node_weights);
+
+    // Every arc is stored at its lower node, arcs without a path are skipped
+    util::DeallocatingVector<contractor::QueryEdge> GetEdges() const;
+
+    std::size_t GetNumberOfNodes() const { return ranks.size(); }
+    std::size_t GetNumberOfArcs() const { return arc_head.size(); }
+
+  private:
+    // the weight of a direction of an arc, either of an edge or of a shortcut over a lower node
+    struct ArcMetric
+    {
+        EdgeWeight weight;
+        EdgeWeight duration;
+        // the id of the turn of an edge, the rank of the middle node of a shortcut
+        NodeID id;
+        bool shortcut;
+    };
+
+    std::uint32_t FindArc(const NodeID lower, const NodeID upper) const;
+
+    // all arrays below are indexed by rank
+    std::vector<NodeID> ranks;
+    std::vector<NodeID> nodes;
+
+    // the arcs to higher nodes, sorted by the rank of the higher node
+    std::vector<std::uint32_t> first_arc;
+    std::vector<NodeID> arc_head;
+    std::vector<NodeID> arc_tail;
+
+    // the arcs from lower nodes
+    std::vector<std::uint32_t> first_lower_arc;
+    std::vector<std::uint32_t> lower_arcs;
+
+    // Nodes in the order of the customization: the arcs of a node only depend on the arcs of its
+    // lower neighbours, which are all in earlier steps. The nodes of a step are independent.
+    std::vector<NodeID> customization_order;
+    std::vector<std::uint32_t> first_in_step;
+
+    std::vector<ArcMetric> upward;
+    std::vector<ArcMetric> downward;
+    std::vector<ArcMetric> loops;
+};
+}
+}
+
+#endif
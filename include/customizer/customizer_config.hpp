@@ -15,7 +15,7 @@ namespace customizer
 
 struct CustomizationConfig
 {
-    CustomizationConfig() : requested_num_threads(0) {}
+    CustomizationConfig() : requested_num_threads(0), customize_cch(false) {}
 
     void UseDefaults()
     {
@@ -36,6 +36,9 @@ struct CustomizationConfig
         mld_partition_path = basepath + ".osrm.partition";
         mld_storage_path = basepath + ".osrm.cells";
         mld_graph_path = basepath + ".osrm.mldgr";
+        node_weights_path = basepath + ".osrm.enw";
+        cch_graph_path = basepath + ".osrm.hsgr";
+        cch_core_path = basepath + ".osrm.core";
 
         updater_config.osrm_input_path = basepath + ".osrm";
         updater_config.UseDefaultOutputNames();
@@ -47,9 +50,16 @@ struct CustomizationConfig
     boost::filesystem::path mld_partition_path;
     boost::filesystem::path mld_storage_path;
     boost::filesystem::path mld_graph_path;
+    boost::filesystem::path node_weights_path;
+    boost::filesystem::path cch_graph_path;
+    boost::filesystem::path cch_core_path;
 
     unsigned requested_num_threads;
 
+    // Build a customizable contraction hierarchy in the order of the partition and write it for
+    // the CH algorithm instead of customizing the cells for MLD
+    bool customize_cch;
+
     updater::UpdaterConfig updater_config;
 };
 }
@@ -88,6 +88,9 @@ template <> struct HasDirectShortestPathSearch<corech::Algorithm> final : std::t
 template <> struct HasMapMatching<corech::Algorithm> final : std::true_type
 {
 };
+template <> struct HasManyToManySearch<corech::Algorithm> final : std::true_type
+{
+};
 template <> struct HasGetTileTurns<corech::Algorithm> final : std::true_type
 {
 };
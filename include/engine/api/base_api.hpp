@@ -5,6 +5,7 @@
 #include "engine/datafacade/datafacade_base.hpp"
 
 #include "engine/api/json_factory.hpp"
+#include "engine/api/results.hpp"
 #include "engine/hint.hpp"
 
 #include <boost/assert.hpp>
@@ -66,6 +67,35 @@ class BaseAPI
         }
     }
 
+    std::vector<Waypoint>
+    MakeWaypointResults(const std::vector<PhantomNodes> &segment_end_coordinates) const
+    {
+        BOOST_ASSERT(parameters.coordinates.size() > 0);
+        BOOST_ASSERT(parameters.coordinates.size() == segment_end_coordinates.size() + 1);
+
+        std::vector<Waypoint> waypoints;
+        waypoints.reserve(parameters.coordinates.size());
+        waypoints.push_back(MakeWaypointResult(segment_end_coordinates.front().source_phantom));
+        for (const auto &phantom_pair : segment_end_coordinates)
+        {
+            waypoints.push_back(MakeWaypointResult(phantom_pair.target_phantom));
+        }
+        return waypoints;
+    }
+
+    Waypoint MakeWaypointResult(const PhantomNode &phantom) const
+    {
+        Waypoint waypoint{
+            phantom.location,
+            facade.GetNameForID(facade.GetNameIndex(phantom.forward_segment_id.id)).to_string(),
+            boost::none};
+        if (parameters.generate_hints)
+        {
+            waypoint.hint = Hint{phantom, facade.GetCheckSum()};
+        }
+        return waypoint;
+    }
+
     const datafacade::BaseDataFacade &facade;
     const BaseParameters &parameters;
 };
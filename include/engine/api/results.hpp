@@ -0,0 +1,89 @@
+#ifndef ENGINE_API_RESULTS_HPP
+#define ENGINE_API_RESULTS_HPP
+
+#include "engine/hint.hpp"
+#include "util/coordinate.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace api
+{
+
+/**
+ * Plain result types for C++ users that only need the numbers of a response.
+ *
+ * They are filled directly from the internal results without building a JSON object.
+ * Errors are reported with the same code and message the JSON response would contain.
+ */
+struct Waypoint
+{
+    util::Coordinate location;
+    std::string name;
+    // only set if the parameters have generate_hints set
+    boost::optional<Hint> hint;
+};
+
+struct RouteLeg
+{
+    // in meters
+    double distance;
+    // in seconds
+    double duration;
+    double weight;
+};
+
+struct Route
+{
+    // in meters
+    double distance;
+    // in seconds
+    double duration;
+    double weight;
+    std::vector<RouteLeg> legs;
+    // overview geometry, empty if the overview was disabled
+    std::vector<util::Coordinate> geometry;
+};
+
+struct RouteResult
+{
+    std::string code;
+    std::string message;
+    std::vector<Waypoint> waypoints;
+    // the first route is the recommended one, followed by alternatives
+    std::vector<Route> routes;
+};
+
+struct TableResult
+{
+    std::string code;
+    std::string message;
+    std::vector<Waypoint> sources;
+    std::vector<Waypoint> destinations;
+    std::size_t number_of_sources = 0;
+    std::size_t number_of_destinations = 0;
+    // row-major matrix of durations in deci-seconds, MAXIMAL_EDGE_DURATION if unreachable
+    std::vector<EdgeWeight> durations;
+
+    EdgeWeight GetDuration(const std::size_t source, const std::size_t destination) const
+    {
+        BOOST_ASSERT(source < number_of_sources);
+        BOOST_ASSERT(destination < number_of_destinations);
+        return durations[source * number_of_destinations + destination];
+    }
+};
+
+} // ns api
+} // ns engine
+} // ns osrm
+
+#endif
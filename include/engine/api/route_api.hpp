@@ -65,6 +65,27 @@ class RouteAPI : public BaseAPI
         response.values["code"] = "Ok";
     }
 
+    void MakeResponse(const InternalManyRoutesResult &raw_routes, RouteResult &response) const
+    {
+        BOOST_ASSERT(!raw_routes.routes.empty());
+
+        response.routes.clear();
+        for (const auto &route : raw_routes.routes)
+        {
+            if (!route.is_valid())
+                continue;
+
+            response.routes.push_back(MakeRouteResult(route.segment_end_coordinates,
+                                                      route.unpacked_path_segments,
+                                                      route.source_traversed_in_reverse,
+                                                      route.target_traversed_in_reverse));
+        }
+
+        response.waypoints =
+            BaseAPI::MakeWaypointResults(raw_routes.routes[0].segment_end_coordinates);
+        response.code = "Ok";
+    }
+
   protected:
     template <typename ForwardIter>
     util::json::Value MakeGeometry(ForwardIter begin, ForwardIter end) const
@@ -96,6 +117,58 @@ class RouteAPI : public BaseAPI
         return annotations_store;
     }
 
+    // Only assembles what the plain result needs: no steps, annotations or encoded geometries
+    Route MakeRouteResult(const std::vector<PhantomNodes> &segment_end_coordinates,
+                          const std::vector<std::vector<PathData>> &unpacked_path_segments,
+                          const std::vector<bool> &source_traversed_in_reverse,
+                          const std::vector<bool> &target_traversed_in_reverse) const
+    {
+        const auto number_of_legs = segment_end_coordinates.size();
+        std::vector<guidance::RouteLeg> legs;
+        std::vector<guidance::LegGeometry> leg_geometries;
+        legs.reserve(number_of_legs);
+        leg_geometries.reserve(number_of_legs);
+
+        for (auto idx : util::irange<std::size_t>(0UL, number_of_legs))
+        {
+            const auto &phantoms = segment_end_coordinates[idx];
+            const auto &path_data = unpacked_path_segments[idx];
+
+            auto leg_geometry = guidance::assembleGeometry(BaseAPI::facade,
+                                                           path_data,
+                                                           phantoms.source_phantom,
+                                                           phantoms.target_phantom,
+                                                           source_traversed_in_reverse[idx],
+                                                           target_traversed_in_reverse[idx]);
+            legs.push_back(guidance::assembleLeg(facade,
+                                                 path_data,
+                                                 leg_geometry,
+                                                 phantoms.source_phantom,
+                                                 phantoms.target_phantom,
+                                                 target_traversed_in_reverse[idx],
+                                                 false));
+            leg_geometries.push_back(std::move(leg_geometry));
+        }
+
+        const auto route = guidance::assembleRoute(legs);
+        Route result{route.distance, route.duration, route.weight, {}, {}};
+
+        result.legs.reserve(legs.size());
+        for (const auto &leg : legs)
+        {
+            result.legs.push_back(RouteLeg{leg.distance, leg.duration, leg.weight});
+        }
+
+        if (parameters.overview != RouteParameters::OverviewType::False)
+        {
+            const auto use_simplification =
+                parameters.overview == RouteParameters::OverviewType::Simplified;
+            result.geometry = guidance::assembleOverview(leg_geometries, use_simplification);
+        }
+
+        return result;
+    }
+
     util::json::Object MakeRoute(const std::vector<PhantomNodes> &segment_end_coordinates,
                                  const std::vector<std::vector<PathData>> &unpacked_path_segments,
                                  const std::vector<bool> &source_traversed_in_reverse,
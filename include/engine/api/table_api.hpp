@@ -70,6 +70,40 @@ class TableAPI final : public BaseAPI
         response.values["code"] = "Ok";
     }
 
+    virtual void MakeResponse(const std::vector<EdgeWeight> &durations,
+                              const std::vector<PhantomNode> &phantoms,
+                              TableResult &response) const
+    {
+        const auto make_waypoints = [this, &phantoms](const std::vector<std::size_t> &indices) {
+            std::vector<Waypoint> waypoints;
+            if (indices.empty())
+            {
+                waypoints.reserve(phantoms.size());
+                for (const auto &phantom : phantoms)
+                    waypoints.push_back(BaseAPI::MakeWaypointResult(phantom));
+            }
+            else
+            {
+                waypoints.reserve(indices.size());
+                for (const auto index : indices)
+                {
+                    BOOST_ASSERT(index < phantoms.size());
+                    waypoints.push_back(BaseAPI::MakeWaypointResult(phantoms[index]));
+                }
+            }
+            return waypoints;
+        };
+
+        response.sources = make_waypoints(parameters.sources);
+        response.destinations = make_waypoints(parameters.destinations);
+        response.number_of_sources = response.sources.size();
+        response.number_of_destinations = response.destinations.size();
+        BOOST_ASSERT(durations.size() ==
+                     response.number_of_sources * response.number_of_destinations);
+        response.durations = durations;
+        response.code = "Ok";
+    }
+
   protected:
     virtual util::json::Array MakeWaypoints(const std::vector<PhantomNode> &phantoms) const
     {
@@ -30,14 +30,17 @@ template <typename AlgorithmT> class DataWatchdog final
     using FacadeT = datafacade::ContiguousInternalMemoryDataFacade<AlgorithmT>;
 
   public:
-    DataWatchdog() : active(true), timestamp(0)
+    // Every facade gets its own phantom node cache, so cached results never outlive their dataset
+    DataWatchdog(const std::size_t phantom_node_cache_size = 0)
+        : active(true), timestamp(0), phantom_node_cache_size(phantom_node_cache_size)
     {
         // create the initial facade before launching the watchdog thread
         {
             boost::interprocess::scoped_lock<mutex_type> current_region_lock(barrier.get_mutex());
 
             facade = std::make_shared<const FacadeT>(
-                std::make_unique<datafacade::SharedMemoryAllocator>(barrier.data().region));
+                std::make_unique<datafacade::SharedMemoryAllocator>(barrier.data().region),
+                phantom_node_cache_size);
             timestamp = barrier.data().timestamp;
         }
 
@@ -69,7 +72,8 @@ template <typename AlgorithmT> class DataWatchdog final
             {
                 auto region = barrier.data().region;
                 facade = std::make_shared<const FacadeT>(
-                    std::make_unique<datafacade::SharedMemoryAllocator>(region));
+                    std::make_unique<datafacade::SharedMemoryAllocator>(region),
+                    phantom_node_cache_size);
                 timestamp = barrier.data().timestamp;
                 util::Log() << "updated facade to region " << region << " with timestamp "
                             << timestamp;
@@ -83,6 +87,7 @@ template <typename AlgorithmT> class DataWatchdog final
     std::thread watcher;
     bool active;
     unsigned timestamp;
+    const std::size_t phantom_node_cache_size;
     std::shared_ptr<const FacadeT> facade;
 };
 }
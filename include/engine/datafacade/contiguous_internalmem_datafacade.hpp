@@ -8,6 +8,7 @@
 #include "engine/algorithm.hpp"
 #include "engine/approach.hpp"
 #include "engine/geospatial_query.hpp"
+#include "engine/phantom_node_cache.hpp"
 
 #include "customizer/edge_based_graph.hpp"
 
@@ -235,6 +236,8 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     std::unique_ptr<SharedRTree> m_static_rtree;
     std::unique_ptr<SharedGeospatialQuery> m_geospatial_query;
     boost::filesystem::path file_index_path;
+    // results are only valid for this dataset, so the cache lives and dies with the facade
+    PhantomNodeCache m_phantom_node_cache;
 
     util::NameTable m_name_table;
     // bearing classes by node based node
@@ -550,8 +553,9 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
   public:
     // allows switching between process_memory/shared_memory datafacade, based on the type of
     // allocator
-    ContiguousInternalMemoryDataFacadeBase(std::shared_ptr<ContiguousBlockAllocator> allocator_)
-        : allocator(std::move(allocator_))
+    ContiguousInternalMemoryDataFacadeBase(std::shared_ptr<ContiguousBlockAllocator> allocator_,
+                                           const std::size_t phantom_node_cache_size = 0)
+        : m_phantom_node_cache(phantom_node_cache_size), allocator(std::move(allocator_))
     {
         InitializeInternalPointers(allocator->GetLayout(), allocator->GetMemory());
     }
@@ -653,6 +657,26 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         return m_geospatial_query->Search(bbox);
     }
 
+    std::vector<PhantomNodeWithDistance>
+    PhantomNodeFromSegment(const util::Coordinate input_coordinate,
+                           const SegmentID forward_segment_id,
+                           const SegmentID reverse_segment_id,
+                           const unsigned short fwd_segment_position) const override final
+    {
+        BOOST_ASSERT(m_geospatial_query.get());
+
+        // ids from hints are user input and need to be checked before the lookup
+        const auto number_of_nodes = edge_based_node_data.GetNumberOfNodes();
+        if (forward_segment_id.id >= number_of_nodes ||
+            (reverse_segment_id.enabled && reverse_segment_id.id >= number_of_nodes))
+        {
+            return {};
+        }
+
+        return m_geospatial_query->PhantomNodeFromSegment(
+            input_coordinate, forward_segment_id, reverse_segment_id, fwd_segment_position);
+    }
+
     std::vector<PhantomNodeWithDistance>
     NearestPhantomNodesInRange(const util::Coordinate input_coordinate,
                                const float max_distance,
@@ -660,8 +684,12 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     {
         BOOST_ASSERT(m_geospatial_query.get());
 
-        return m_geospatial_query->NearestPhantomNodesInRange(
-            input_coordinate, max_distance, approach);
+        const PhantomNodeQuery query{
+            input_coordinate.lon, input_coordinate.lat, 0, max_distance, -1, -1, approach, false};
+        return m_phantom_node_cache.Get(query, [&] {
+            return m_geospatial_query->NearestPhantomNodesInRange(
+                input_coordinate, max_distance, approach);
+        });
     }
 
     std::vector<PhantomNodeWithDistance>
@@ -673,8 +701,18 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     {
         BOOST_ASSERT(m_geospatial_query.get());
 
-        return m_geospatial_query->NearestPhantomNodesInRange(
-            input_coordinate, max_distance, bearing, bearing_range, approach);
+        const PhantomNodeQuery query{input_coordinate.lon,
+                                     input_coordinate.lat,
+                                     0,
+                                     max_distance,
+                                     bearing,
+                                     bearing_range,
+                                     approach,
+                                     false};
+        return m_phantom_node_cache.Get(query, [&] {
+            return m_geospatial_query->NearestPhantomNodesInRange(
+                input_coordinate, max_distance, bearing, bearing_range, approach);
+        });
     }
 
     std::vector<PhantomNodeWithDistance>
@@ -684,7 +722,11 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     {
         BOOST_ASSERT(m_geospatial_query.get());
 
-        return m_geospatial_query->NearestPhantomNodes(input_coordinate, max_results, approach);
+        const PhantomNodeQuery query{
+            input_coordinate.lon, input_coordinate.lat, max_results, -1., -1, -1, approach, false};
+        return m_phantom_node_cache.Get(query, [&] {
+            return m_geospatial_query->NearestPhantomNodes(input_coordinate, max_results, approach);
+        });
     }
 
     std::vector<PhantomNodeWithDistance>
@@ -695,8 +737,18 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     {
         BOOST_ASSERT(m_geospatial_query.get());
 
-        return m_geospatial_query->NearestPhantomNodes(
-            input_coordinate, max_results, max_distance, approach);
+        const PhantomNodeQuery query{input_coordinate.lon,
+                                     input_coordinate.lat,
+                                     max_results,
+                                     max_distance,
+                                     -1,
+                                     -1,
+                                     approach,
+                                     false};
+        return m_phantom_node_cache.Get(query, [&] {
+            return m_geospatial_query->NearestPhantomNodes(
+                input_coordinate, max_results, max_distance, approach);
+        });
     }
 
     std::vector<PhantomNodeWithDistance>
@@ -708,8 +760,18 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     {
         BOOST_ASSERT(m_geospatial_query.get());
 
-        return m_geospatial_query->NearestPhantomNodes(
-            input_coordinate, max_results, bearing, bearing_range, approach);
+        const PhantomNodeQuery query{input_coordinate.lon,
+                                     input_coordinate.lat,
+                                     max_results,
+                                     -1.,
+                                     bearing,
+                                     bearing_range,
+                                     approach,
+                                     false};
+        return m_phantom_node_cache.Get(query, [&] {
+            return m_geospatial_query->NearestPhantomNodes(
+                input_coordinate, max_results, bearing, bearing_range, approach);
+        });
     }
 
     std::vector<PhantomNodeWithDistance>
@@ -722,8 +784,18 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     {
         BOOST_ASSERT(m_geospatial_query.get());
 
-        return m_geospatial_query->NearestPhantomNodes(
-            input_coordinate, max_results, max_distance, bearing, bearing_range, approach);
+        const PhantomNodeQuery query{input_coordinate.lon,
+                                     input_coordinate.lat,
+                                     max_results,
+                                     max_distance,
+                                     bearing,
+                                     bearing_range,
+                                     approach,
+                                     false};
+        return m_phantom_node_cache.Get(query, [&] {
+            return m_geospatial_query->NearestPhantomNodes(
+                input_coordinate, max_results, max_distance, bearing, bearing_range, approach);
+        });
     }
 
     std::pair<PhantomNode, PhantomNode>
@@ -732,8 +804,12 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     {
         BOOST_ASSERT(m_geospatial_query.get());
 
-        return m_geospatial_query->NearestPhantomNodeWithAlternativeFromBigComponent(
-            input_coordinate, approach);
+        const PhantomNodeQuery query{
+            input_coordinate.lon, input_coordinate.lat, 1, -1., -1, -1, approach, true};
+        return m_phantom_node_cache.GetWithAlternative(query, [&] {
+            return m_geospatial_query->NearestPhantomNodeWithAlternativeFromBigComponent(
+                input_coordinate, approach);
+        });
     }
 
     std::pair<PhantomNode, PhantomNode>
@@ -743,8 +819,12 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     {
         BOOST_ASSERT(m_geospatial_query.get());
 
-        return m_geospatial_query->NearestPhantomNodeWithAlternativeFromBigComponent(
-            input_coordinate, max_distance, approach);
+        const PhantomNodeQuery query{
+            input_coordinate.lon, input_coordinate.lat, 1, max_distance, -1, -1, approach, true};
+        return m_phantom_node_cache.GetWithAlternative(query, [&] {
+            return m_geospatial_query->NearestPhantomNodeWithAlternativeFromBigComponent(
+                input_coordinate, max_distance, approach);
+        });
     }
 
     std::pair<PhantomNode, PhantomNode>
@@ -756,8 +836,18 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     {
         BOOST_ASSERT(m_geospatial_query.get());
 
-        return m_geospatial_query->NearestPhantomNodeWithAlternativeFromBigComponent(
-            input_coordinate, max_distance, bearing, bearing_range, approach);
+        const PhantomNodeQuery query{input_coordinate.lon,
+                                     input_coordinate.lat,
+                                     1,
+                                     max_distance,
+                                     bearing,
+                                     bearing_range,
+                                     approach,
+                                     true};
+        return m_phantom_node_cache.GetWithAlternative(query, [&] {
+            return m_geospatial_query->NearestPhantomNodeWithAlternativeFromBigComponent(
+                input_coordinate, max_distance, bearing, bearing_range, approach);
+        });
     }
 
     std::pair<PhantomNode, PhantomNode>
@@ -768,8 +858,18 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     {
         BOOST_ASSERT(m_geospatial_query.get());
 
-        return m_geospatial_query->NearestPhantomNodeWithAlternativeFromBigComponent(
-            input_coordinate, bearing, bearing_range, approach);
+        const PhantomNodeQuery query{input_coordinate.lon,
+                                     input_coordinate.lat,
+                                     1,
+                                     -1.,
+                                     bearing,
+                                     bearing_range,
+                                     approach,
+                                     true};
+        return m_phantom_node_cache.GetWithAlternative(query, [&] {
+            return m_geospatial_query->NearestPhantomNodeWithAlternativeFromBigComponent(
+                input_coordinate, bearing, bearing_range, approach);
+        });
     }
 
     unsigned GetCheckSum() const override final { return m_check_sum; }
@@ -914,8 +1014,9 @@ class ContiguousInternalMemoryDataFacade<CH>
       public ContiguousInternalMemoryAlgorithmDataFacade<CH>
 {
   public:
-    ContiguousInternalMemoryDataFacade(std::shared_ptr<ContiguousBlockAllocator> allocator)
-        : ContiguousInternalMemoryDataFacadeBase(allocator),
+    ContiguousInternalMemoryDataFacade(std::shared_ptr<ContiguousBlockAllocator> allocator,
+                                       const std::size_t phantom_node_cache_size = 0)
+        : ContiguousInternalMemoryDataFacadeBase(allocator, phantom_node_cache_size),
           ContiguousInternalMemoryAlgorithmDataFacade<CH>(allocator)
 
     {
@@ -928,8 +1029,9 @@ class ContiguousInternalMemoryDataFacade<CoreCH> final
       public ContiguousInternalMemoryAlgorithmDataFacade<CoreCH>
 {
   public:
-    ContiguousInternalMemoryDataFacade(std::shared_ptr<ContiguousBlockAllocator> allocator)
-        : ContiguousInternalMemoryDataFacade<CH>(allocator),
+    ContiguousInternalMemoryDataFacade(std::shared_ptr<ContiguousBlockAllocator> allocator,
+                                       const std::size_t phantom_node_cache_size = 0)
+        : ContiguousInternalMemoryDataFacade<CH>(allocator, phantom_node_cache_size),
           ContiguousInternalMemoryAlgorithmDataFacade<CoreCH>(allocator)
 
     {
@@ -1109,8 +1211,9 @@ class ContiguousInternalMemoryDataFacade<MLD> final
 {
   private:
   public:
-    ContiguousInternalMemoryDataFacade(std::shared_ptr<ContiguousBlockAllocator> allocator)
-        : ContiguousInternalMemoryDataFacadeBase(allocator),
+    ContiguousInternalMemoryDataFacade(std::shared_ptr<ContiguousBlockAllocator> allocator,
+                                       const std::size_t phantom_node_cache_size = 0)
+        : ContiguousInternalMemoryDataFacadeBase(allocator, phantom_node_cache_size),
           ContiguousInternalMemoryAlgorithmDataFacade<MLD>(allocator)
 
     {
@@ -124,6 +124,14 @@ class BaseDataFacade
                         const double max_distance,
                         const Approach approach) const = 0;
 
+    // Rebuilds the phantom node for a segment referenced by a compact hint without
+    // querying the R-tree. Returns an empty vector if the segment is invalid.
+    virtual std::vector<PhantomNodeWithDistance>
+    PhantomNodeFromSegment(const util::Coordinate input_coordinate,
+                           const SegmentID forward_segment_id,
+                           const SegmentID reverse_segment_id,
+                           const unsigned short fwd_segment_position) const = 0;
+
     virtual std::pair<PhantomNode, PhantomNode>
     NearestPhantomNodeWithAlternativeFromBigComponent(const util::Coordinate input_coordinate,
                                                       const Approach approach) const = 0;
@@ -25,9 +25,11 @@ template <typename AlgorithmT> class ImmutableProvider final : public DataFacade
     using FacadeT = datafacade::ContiguousInternalMemoryDataFacade<AlgorithmT>;
 
   public:
-    ImmutableProvider(const storage::StorageConfig &config)
+    ImmutableProvider(const storage::StorageConfig &config,
+                      const std::size_t phantom_node_cache_size = 0)
         : immutable_data_facade(std::make_shared<FacadeT>(
-              std::make_shared<datafacade::ProcessMemoryAllocator>(config)))
+              std::make_shared<datafacade::ProcessMemoryAllocator>(config),
+              phantom_node_cache_size))
     {
     }
 
@@ -43,6 +45,11 @@ template <typename AlgorithmT> class WatchingProvider final : public DataFacadeP
     DataWatchdog<AlgorithmT> watchdog;
 
   public:
+    WatchingProvider(const std::size_t phantom_node_cache_size = 0)
+        : watchdog(phantom_node_cache_size)
+    {
+    }
+
     std::shared_ptr<const FacadeT> Get() const override final
     {
         // We need a singleton here because multiple instances of DataWatchdog
@@ -3,6 +3,7 @@
 
 #include "engine/api/match_parameters.hpp"
 #include "engine/api/nearest_parameters.hpp"
+#include "engine/api/results.hpp"
 #include "engine/api/route_parameters.hpp"
 #include "engine/api/table_parameters.hpp"
 #include "engine/api/tile_parameters.hpp"
@@ -25,8 +26,13 @@
 #include "util/fingerprint.hpp"
 #include "util/json_container.hpp"
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace osrm
 {
@@ -48,8 +54,44 @@ class EngineInterface
     virtual Status Match(const api::MatchParameters &parameters,
                          util::json::Object &result) const = 0;
     virtual Status Tile(const api::TileParameters &parameters, std::string &result) const = 0;
+    virtual Status Route(const api::RouteParameters &parameters,
+                         api::RouteResult &result) const = 0;
+    virtual Status Table(const api::TableParameters &parameters,
+                         api::TableResult &result) const = 0;
+    virtual Status RouteBatch(const std::vector<api::RouteParameters> &parameters,
+                              std::vector<util::json::Object> &results) const = 0;
+    virtual Status TableBatch(const std::vector<api::TableParameters> &parameters,
+                              std::vector<util::json::Object> &results) const = 0;
 };
 
+namespace detail
+{
+// Runs independent requests in parallel. The search heaps are thread local, so every
+// worker thread reuses its heaps for all requests it handles.
+template <typename ParameterT, typename RequestHandlerT>
+Status runBatch(const std::vector<ParameterT> &parameters,
+                std::vector<util::json::Object> &results,
+                const RequestHandlerT &handle_request)
+{
+    results.clear();
+    results.resize(parameters.size());
+
+    std::atomic<bool> all_ok{true};
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, parameters.size()),
+                      [&](const tbb::blocked_range<std::size_t> &range) {
+                          for (auto index = range.begin(); index != range.end(); ++index)
+                          {
+                              if (handle_request(parameters[index], results[index]) != Status::Ok)
+                              {
+                                  all_ok = false;
+                              }
+                          }
+                      });
+
+    return all_ok ? Status::Ok : Status::Error;
+}
+}
+
 template <typename Algorithm> class Engine final : public EngineInterface
 {
   public:
@@ -66,13 +108,15 @@ template <typename Algorithm> class Engine final : public EngineInterface
         {
             util::Log(logDEBUG) << "Using shared memory with algorithm "
                                 << routing_algorithms::name<Algorithm>();
-            facade_provider = std::make_unique<WatchingProvider<Algorithm>>();
+            facade_provider =
+                std::make_unique<WatchingProvider<Algorithm>>(config.phantom_node_cache_size);
         }
         else
         {
             util::Log(logDEBUG) << "Using internal memory with algorithm "
                                 << routing_algorithms::name<Algorithm>();
-            facade_provider = std::make_unique<ImmutableProvider<Algorithm>>(config.storage_config);
+            facade_provider = std::make_unique<ImmutableProvider<Algorithm>>(
+                config.storage_config, config.phantom_node_cache_size);
         }
     }
 
@@ -129,6 +173,45 @@ template <typename Algorithm> class Engine final : public EngineInterface
         return tile_plugin.HandleRequest(*facade, algorithms, params, result);
     }
 
+    Status Route(const api::RouteParameters &params,
+                 api::RouteResult &result) const override final
+    {
+        auto facade = facade_provider->Get();
+        auto algorithms = RoutingAlgorithms<Algorithm>{heaps, *facade};
+        return route_plugin.HandleRequest(*facade, algorithms, params, result);
+    }
+
+    Status Table(const api::TableParameters &params,
+                 api::TableResult &result) const override final
+    {
+        auto facade = facade_provider->Get();
+        auto algorithms = RoutingAlgorithms<Algorithm>{heaps, *facade};
+        return table_plugin.HandleRequest(*facade, algorithms, params, result);
+    }
+
+    Status RouteBatch(const std::vector<api::RouteParameters> &params,
+                      std::vector<util::json::Object> &results) const override final
+    {
+        // all requests of a batch are answered from the same dataset
+        auto facade = facade_provider->Get();
+        return detail::runBatch(
+            params, results, [&](const api::RouteParameters &param, util::json::Object &result) {
+                auto algorithms = RoutingAlgorithms<Algorithm>{heaps, *facade};
+                return route_plugin.HandleRequest(*facade, algorithms, param, result);
+            });
+    }
+
+    Status TableBatch(const std::vector<api::TableParameters> &params,
+                      std::vector<util::json::Object> &results) const override final
+    {
+        auto facade = facade_provider->Get();
+        return detail::runBatch(
+            params, results, [&](const api::TableParameters &param, util::json::Object &result) {
+                auto algorithms = RoutingAlgorithms<Algorithm>{heaps, *facade};
+                return table_plugin.HandleRequest(*facade, algorithms, param, result);
+            });
+    }
+
     static bool CheckCompability(const EngineConfig &config);
 
   private:
@@ -32,6 +32,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <boost/filesystem/path.hpp>
 
+#include <cstddef>
 #include <string>
 
 namespace osrm
@@ -55,6 +56,10 @@ namespace engine
  *
  * In addition, shared memory can be used for datasets loaded with osrm-datastore.
  *
+ * Snapping results of repeatedly requested coordinates can be cached by setting
+ * phantom_node_cache_size to the maximal number of cached results. The cache is
+ * dropped whenever a new dataset is loaded.
+ *
  * You can chose between three algorithms:
  *  - Algorithm::CH
  *    Contraction Hierarchies, extremely fast queries but slow pre-processing. The default right
@@ -87,6 +92,7 @@ struct EngineConfig final
     int max_locations_distance_table = -1;
     int max_locations_map_matching = -1;
     int max_results_nearest = -1;
+    std::size_t phantom_node_cache_size = 0;
     bool use_shared_memory = true;
     Algorithm algorithm = Algorithm::CH;
 };
@@ -393,6 +393,49 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
                               MakePhantomNode(input_coordinate, results.back()).phantom_node);
     }
 
+    // Rebuilds the phantom node on a known segment, e.g. referenced by a hint, without
+    // querying the R-tree. The segment ids need to be valid edge-based node ids.
+    // Returns an empty vector if the segment does not exist or is not traversable anymore.
+    std::vector<PhantomNodeWithDistance>
+    PhantomNodeFromSegment(const util::Coordinate input_coordinate,
+                           const SegmentID forward_segment_id,
+                           const SegmentID reverse_segment_id,
+                           const unsigned short fwd_segment_position) const
+    {
+        // segments in the R-tree always have the forward direction enabled
+        if (!forward_segment_id.enabled)
+        {
+            return {};
+        }
+
+        const auto geometry_id = datafacade.GetGeometryIndex(forward_segment_id.id).id;
+        if (reverse_segment_id.enabled &&
+            datafacade.GetGeometryIndex(reverse_segment_id.id).id != geometry_id)
+        {
+            return {};
+        }
+
+        const auto geometry = datafacade.GetUncompressedForwardGeometry(geometry_id);
+        if (static_cast<std::size_t>(fwd_segment_position) + 1 >= geometry.size())
+        {
+            return {};
+        }
+
+        const EdgeData data{forward_segment_id,
+                            reverse_segment_id,
+                            geometry[fwd_segment_position],
+                            geometry[fwd_segment_position + 1],
+                            fwd_segment_position};
+
+        const auto valid_edges = HasValidEdge(data);
+        if (!valid_edges.first && !valid_edges.second)
+        {
+            return {};
+        }
+
+        return {MakePhantomNode(input_coordinate, data)};
+    }
+
   private:
     std::vector<PhantomNodeWithDistance>
     MakePhantomNodes(const util::Coordinate input_coordinate,
@@ -563,11 +606,14 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
      */
     std::pair<bool, bool> HasValidEdge(const CandidateSegment &segment) const
     {
+        return HasValidEdge(segment.data);
+    }
 
+    std::pair<bool, bool> HasValidEdge(const EdgeData &data) const
+    {
         bool forward_edge_valid = false;
         bool reverse_edge_valid = false;
 
-        const auto &data = segment.data;
         BOOST_ASSERT(data.forward_segment_id.enabled);
         BOOST_ASSERT(data.forward_segment_id.id != SPECIAL_NODEID);
         const auto geometry_id = datafacade.GetGeometryIndex(data.forward_segment_id.id).id;
@@ -48,15 +48,27 @@ class BaseDataFacade;
 }
 
 // Is returned as a temporary identifier for snapped coodinates
+//
+// There are two encodings: the full one serializes the whole phantom node,
+// the compact one only references the snapped segment. Phantom nodes of compact
+// hints are rebuilt from the data facade, see BaseDataFacade::PhantomNodeFromSegment.
 struct Hint
 {
     PhantomNode phantom;
     std::uint32_t data_checksum;
 
+    // For full hints: input coordinate and data checksum need to match.
+    // For compact hints: the checksum over data checksum, input coordinate and segment needs
+    // to match.
     bool IsValid(const util::Coordinate new_input_coordinates,
                  const datafacade::BaseDataFacade &facade) const;
 
+    // Compact hints only have the segment ids and the position in the geometry set
+    bool IsCompact() const { return !phantom.location.IsValid(); }
+
     std::string ToBase64() const;
+    std::string ToCompactBase64() const;
+    // Decodes full and compact hints
     static Hint FromBase64(const std::string &base64Hint);
 
     friend bool operator==(const Hint &, const Hint &);
@@ -67,6 +79,8 @@ static_assert(sizeof(Hint) == 64 + 4, "Hint is bigger than expected");
 constexpr std::size_t ENCODED_HINT_SIZE = 92;
 static_assert(ENCODED_HINT_SIZE / 4 * 3 >= sizeof(Hint),
               "ENCODED_HINT_SIZE does not match size of Hint");
+// version, flags, segment position, both segment ids and checksum: 16 bytes
+constexpr std::size_t ENCODED_COMPACT_HINT_SIZE = 24;
 }
 }
 
@@ -0,0 +1,144 @@
+#ifndef OSRM_ENGINE_PHANTOM_NODE_CACHE_HPP
+#define OSRM_ENGINE_PHANTOM_NODE_CACHE_HPP
+
+#include "engine/approach.hpp"
+#include "engine/phantom_node.hpp"
+#include "util/coordinate.hpp"
+
+#include <boost/assert.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+
+// Identifies a nearest neighbour query. The coordinate is used in its fixed point
+// representation, which already is the precision all coordinates are parsed with.
+struct PhantomNodeQuery
+{
+    util::FixedLongitude lon;
+    util::FixedLatitude lat;
+    // 0 for queries that return all phantom nodes in range
+    unsigned max_results;
+    // negative if the query has no distance limit
+    double max_distance;
+    // negative if the query has no bearing filter
+    int bearing;
+    int bearing_range;
+    Approach approach;
+    // true for the nearest phantom node with an alternative from a big component
+    bool with_alternative;
+
+    bool operator==(const PhantomNodeQuery &other) const
+    {
+        return lon == other.lon && lat == other.lat && max_results == other.max_results &&
+               max_distance == other.max_distance && bearing == other.bearing &&
+               bearing_range == other.bearing_range && approach == other.approach &&
+               with_alternative == other.with_alternative;
+    }
+};
+
+struct PhantomNodeQueryHash
+{
+    std::size_t operator()(const PhantomNodeQuery &query) const;
+};
+
+/**
+ * Bounded LRU cache for the results of nearest neighbour queries.
+ *
+ * Frequently used locations (depots, stops) are snapped over and over again with the
+ * same parameters. The cache is split into independently locked shards so concurrent
+ * requests rarely contend. It belongs to a single dataset and needs to be discarded
+ * together with the facade of that dataset.
+ */
+class PhantomNodeCache
+{
+  public:
+    using Result = std::vector<PhantomNodeWithDistance>;
+
+    // A capacity of 0 disables the cache
+    explicit PhantomNodeCache(const std::size_t capacity);
+    ~PhantomNodeCache();
+
+    PhantomNodeCache(const PhantomNodeCache &) = delete;
+    PhantomNodeCache &operator=(const PhantomNodeCache &) = delete;
+
+    bool IsEnabled() const { return capacity_per_shard > 0; }
+
+    // Returns the cached result or evaluates the query and caches its result
+    template <typename QueryFunction>
+    Result Get(const PhantomNodeQuery &query, QueryFunction &&run_query) const
+    {
+        if (!IsEnabled())
+            return run_query();
+
+        Result result;
+        if (Lookup(query, result))
+            return result;
+
+        result = run_query();
+        Insert(query, result);
+        return result;
+    }
+
+    // Same as Get for queries that return a phantom node and its alternative from a big
+    // component. The pair is cached as a result of two phantom nodes.
+    template <typename QueryFunction>
+    std::pair<PhantomNode, PhantomNode> GetWithAlternative(const PhantomNodeQuery &query,
+                                                           QueryFunction &&run_query) const
+    {
+        BOOST_ASSERT(query.with_alternative);
+        const auto result = Get(query, [&] {
+            const auto phantom_nodes = run_query();
+            return Result{{phantom_nodes.first, 0.}, {phantom_nodes.second, 0.}};
+        });
+        BOOST_ASSERT(result.size() == 2);
+        return {result[0].phantom_node, result[1].phantom_node};
+    }
+
+    std::uint64_t GetNumberOfHits() const { return hits; }
+    std::uint64_t GetNumberOfMisses() const { return misses; }
+    // Fraction of lookups that were answered from the cache
+    double GetHitRatio() const;
+
+  private:
+    static constexpr std::size_t NUM_SHARDS = 16;
+    // the statistics are logged after this many lookups, so they show up for long running servers
+    static constexpr std::uint64_t LOG_INTERVAL = 1 << 20;
+
+    struct Shard
+    {
+        using Entry = std::pair<PhantomNodeQuery, Result>;
+
+        std::mutex mutex;
+        // most recently used entries first
+        std::list<Entry> entries;
+        std::unordered_map<PhantomNodeQuery, std::list<Entry>::iterator, PhantomNodeQueryHash>
+            index;
+    };
+
+    Shard &GetShard(const PhantomNodeQuery &query) const;
+    bool Lookup(const PhantomNodeQuery &query, Result &result) const;
+    void Insert(const PhantomNodeQuery &query, const Result &result) const;
+    void LogStatistics() const;
+
+    const std::size_t capacity_per_shard;
+    mutable std::array<Shard, NUM_SHARDS> shards;
+    mutable std::atomic<std::uint64_t> hits;
+    mutable std::atomic<std::uint64_t> misses;
+    mutable std::atomic<std::uint64_t> lookups;
+};
+}
+}
+
+#endif
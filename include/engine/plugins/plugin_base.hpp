@@ -3,6 +3,7 @@
 
 #include "engine/api/base_parameters.hpp"
 #include "engine/datafacade/datafacade_base.hpp"
+#include "engine/hint.hpp"
 #include "engine/phantom_node.hpp"
 #include "engine/status.hpp"
 
@@ -45,6 +46,15 @@ class BasePlugin
         return Status::Error;
     }
 
+    // Plain results carry the same code and message as the JSON response
+    template <typename ResultT>
+    Status Error(const std::string &code, const std::string &message, ResultT &result) const
+    {
+        result.code = code;
+        result.message = message;
+        return Status::Error;
+    }
+
     // Decides whether to use the phantom node from a big or small component if both are found.
     // Returns true if all phantom nodes are in the same component after snapping.
     std::vector<PhantomNode>
@@ -108,6 +118,32 @@ class BasePlugin
         return snapped_phantoms;
     }
 
+    // Returns the phantom node of a hint if it is valid for the input coordinate.
+    // Compact hints are rebuilt from the facade, which avoids querying the R-tree.
+    std::vector<PhantomNodeWithDistance> GetHintedPhantomNode(
+        const datafacade::BaseDataFacade &facade,
+        const boost::optional<Hint> &hint,
+        const util::Coordinate input_coordinate) const
+    {
+        if (!hint || !hint->IsValid(input_coordinate, facade))
+        {
+            return {};
+        }
+
+        if (hint->IsCompact())
+        {
+            return facade.PhantomNodeFromSegment(input_coordinate,
+                                                 hint->phantom.forward_segment_id,
+                                                 hint->phantom.reverse_segment_id,
+                                                 hint->phantom.fwd_segment_position);
+        }
+
+        return {PhantomNodeWithDistance{
+            hint->phantom,
+            util::coordinate_calculation::haversineDistance(input_coordinate,
+                                                            hint->phantom.location)}};
+    }
+
     // Falls back to default_radius for non-set radii
     std::vector<std::vector<PhantomNodeWithDistance>>
     GetPhantomNodesInRange(const datafacade::BaseDataFacade &facade,
@@ -128,15 +164,12 @@ class BasePlugin
             if (use_approaches && parameters.approaches[i])
                 approach = parameters.approaches[i].get();
 
-            if (use_hints && parameters.hints[i] &&
-                parameters.hints[i]->IsValid(parameters.coordinates[i], facade))
+            if (use_hints)
             {
-                phantom_nodes[i].push_back(PhantomNodeWithDistance{
-                    parameters.hints[i]->phantom,
-                    util::coordinate_calculation::haversineDistance(
-                        parameters.coordinates[i], parameters.hints[i]->phantom.location),
-                });
-                continue;
+                phantom_nodes[i] =
+                    GetHintedPhantomNode(facade, parameters.hints[i], parameters.coordinates[i]);
+                if (!phantom_nodes[i].empty())
+                    continue;
             }
             if (use_bearings && parameters.bearings[i])
             {
@@ -177,15 +210,12 @@ class BasePlugin
             if (use_approaches && parameters.approaches[i])
                 approach = parameters.approaches[i].get();
 
-            if (use_hints && parameters.hints[i] &&
-                parameters.hints[i]->IsValid(parameters.coordinates[i], facade))
+            if (use_hints)
             {
-                phantom_nodes[i].push_back(PhantomNodeWithDistance{
-                    parameters.hints[i]->phantom,
-                    util::coordinate_calculation::haversineDistance(
-                        parameters.coordinates[i], parameters.hints[i]->phantom.location),
-                });
-                continue;
+                phantom_nodes[i] =
+                    GetHintedPhantomNode(facade, parameters.hints[i], parameters.coordinates[i]);
+                if (!phantom_nodes[i].empty())
+                    continue;
             }
 
             if (use_bearings && parameters.bearings[i])
@@ -250,12 +280,16 @@ class BasePlugin
             if (use_approaches && parameters.approaches[i])
                 approach = parameters.approaches[i].get();
 
-            if (use_hints && parameters.hints[i] &&
-                parameters.hints[i]->IsValid(parameters.coordinates[i], facade))
+            if (use_hints)
             {
-                phantom_node_pairs[i].first = parameters.hints[i]->phantom;
-                // we don't set the second one - it will be marked as invalid
-                continue;
+                const auto hinted_phantom =
+                    GetHintedPhantomNode(facade, parameters.hints[i], parameters.coordinates[i]);
+                if (!hinted_phantom.empty())
+                {
+                    phantom_node_pairs[i].first = hinted_phantom.front().phantom_node;
+                    // we don't set the second one - it will be marked as invalid
+                    continue;
+                }
             }
 
             if (use_bearings && parameters.bearings[i])
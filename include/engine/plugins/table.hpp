@@ -3,6 +3,7 @@
 
 #include "engine/plugins/plugin_base.hpp"
 
+#include "engine/api/results.hpp"
 #include "engine/api/table_parameters.hpp"
 #include "engine/routing_algorithms.hpp"
 #include "engine/routing_algorithms/many_to_many.hpp"
@@ -21,10 +22,12 @@ class TablePlugin final : public BasePlugin
   public:
     explicit TablePlugin(const int max_locations_distance_table);
 
+    // Instantiated for util::json::Object and the plain api::TableResult
+    template <typename ResultT>
     Status HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
                          const RoutingAlgorithmsInterface &algorithms,
                          const api::TableParameters &params,
-                         util::json::Object &result) const;
+                         ResultT &result) const;
 
   private:
     const int max_locations_distance_table;
@@ -3,6 +3,7 @@
 
 #include "engine/plugins/plugin_base.hpp"
 
+#include "engine/api/results.hpp"
 #include "engine/api/route_api.hpp"
 #include "engine/datafacade/datafacade_base.hpp"
 #include "engine/routing_algorithms.hpp"
@@ -31,10 +32,12 @@ class ViaRoutePlugin final : public BasePlugin
   public:
     explicit ViaRoutePlugin(int max_locations_viaroute);
 
+    // Instantiated for util::json::Object and the plain api::RouteResult
+    template <typename ResultT>
     Status HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
                          const RoutingAlgorithmsInterface &algorithms,
                          const api::RouteParameters &route_parameters,
-                         util::json::Object &json_result) const;
+                         ResultT &result) const;
 };
 }
 }
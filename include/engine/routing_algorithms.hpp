@@ -197,11 +197,12 @@ InternalManyRoutesResult inline RoutingAlgorithms<
 template <>
 inline std::vector<EdgeWeight>
 RoutingAlgorithms<routing_algorithms::corech::Algorithm>::ManyToManySearch(
-    const std::vector<PhantomNode> &,
-    const std::vector<std::size_t> &,
-    const std::vector<std::size_t> &) const
+    const std::vector<PhantomNode> &phantom_nodes,
+    const std::vector<std::size_t> &source_indices,
+    const std::vector<std::size_t> &target_indices) const
 {
-    throw util::exception("ManyToManySearch is disabled due to performance reasons");
+    return routing_algorithms::corech::manyToManySearch(
+        heaps, facade, phantom_nodes, source_indices, target_indices);
 }
 
 // MLD overrides for not implemented
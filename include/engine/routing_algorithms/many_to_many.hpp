@@ -26,6 +26,18 @@ manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
                  const std::vector<std::size_t> &target_indices);
 } // namespace ch
 
+namespace corech
+{
+// The searches of the sources and targets stop at the core, a Dijkstra search per source connects
+// them through the core
+std::vector<EdgeWeight>
+manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
+                 const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                 const std::vector<PhantomNode> &phantom_nodes,
+                 const std::vector<std::size_t> &source_indices,
+                 const std::vector<std::size_t> &target_indices);
+} // namespace corech
+
 } // namespace routing_algorithms
 } // namespace engine
 } // namespace osrm
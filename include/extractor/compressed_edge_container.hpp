@@ -38,6 +38,12 @@ class CompressedEdgeContainer
                       const EdgeDuration duration1,
                       const EdgeDuration duration2);
 
+    // Adds the complete geometry of an edge that was merged from a chain of edges. Every segment
+    // holds the node it leads to and its weight and duration.
+    void AddCompressedEdge(const EdgeID edge_id,
+                           OnewayEdgeBucket::const_iterator segments_begin,
+                           OnewayEdgeBucket::const_iterator segments_end);
+
     void AddUncompressedEdge(const EdgeID edge_id,
                              const NodeID target_node,
                              const SegmentWeight weight,
@@ -10,6 +10,8 @@
 
 #include "storage/io.hpp"
 
+#include "util/external_sort.hpp"
+
 #include <cstdint>
 #include <stxxl/vector>
 #include <unordered_map>
@@ -21,19 +23,15 @@ namespace extractor
 
 /**
  * Uses external memory containers from stxxl to store all the data that
- * is collected by the extractor callbacks.
+ * is collected by the extractor callbacks. The containers are sorted within
+ * the memory budget of the sort configuration.
  *
  * The data is the filtered, aggregated and finally written to disk.
  */
 class ExtractionContainers
 {
-#ifndef _MSC_VER
-    constexpr static unsigned stxxl_memory =
-        ((sizeof(std::size_t) == 4) ? std::numeric_limits<int>::max()
-                                    : std::numeric_limits<unsigned>::max());
-#else
-    const static unsigned stxxl_memory = ((sizeof(std::size_t) == 4) ? INT_MAX : UINT_MAX);
-#endif
+    const util::ExternalSortConfig sort_config;
+
     void FlushVectors();
     void PrepareNodes();
     void PrepareRestrictions();
@@ -65,7 +63,7 @@ class ExtractionContainers
     unsigned max_internal_node_id;
     std::vector<TurnRestriction> unconditional_turn_restrictions;
 
-    ExtractionContainers();
+    explicit ExtractionContainers(util::ExternalSortConfig sort_config);
 
     void PrepareData(ScriptingEnvironment &scripting_environment,
                      const std::string &output_file_name,
@@ -76,8 +76,7 @@ class Extractor
                         const util::DeallocatingVector<EdgeBasedEdge> &input_edge_list,
                         const std::vector<EdgeBasedNodeSegment> &input_node_segments,
                         EdgeBasedNodeDataContainer &nodes_container) const;
-    void BuildRTree(std::vector<EdgeBasedNodeSegment> edge_based_node_segments,
-                    std::vector<bool> node_is_startpoint,
+    void BuildRTree(std::vector<EdgeBasedNodeSegment> snappable_segments,
                     const std::vector<util::Coordinate> &coordinates);
     std::shared_ptr<RestrictionMap> LoadRestrictionMap();
     std::shared_ptr<util::NodeBasedDynamicGraph>
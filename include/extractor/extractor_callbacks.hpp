@@ -2,6 +2,7 @@
 #define EXTRACTOR_CALLBACKS_HPP
 
 #include "extractor/guidance/turn_lane_types.hpp"
+#include "util/concurrent_interner.hpp"
 #include "util/typedefs.hpp"
 
 #include <boost/functional/hash.hpp>
@@ -58,14 +59,35 @@ class ExtractorCallbacks
     // used to deduplicate street names, refs, destinations, pronunciation: actually maps to name
     // ids
     using MapKey = std::tuple<std::string, std::string, std::string, std::string>;
-    using MapVal = unsigned;
-    std::unordered_map<MapKey, MapVal> string_map;
+    using MapVal = NameID;
+    using NameInterner = util::ConcurrentInterner<MapKey, MapVal>;
+
+    // parsed lane strings, the id is assigned when the description is first ingested
+    struct InternedLaneDescription
+    {
+        guidance::TurnLaneDescription description;
+        LaneDescriptionID id;
+    };
+    using LaneInterner = util::ConcurrentInterner<std::string, InternedLaneDescription>;
+
+    NameInterner name_interner;
+    LaneInterner lane_interner;
     guidance::LaneDescriptionMap lane_description_map;
     ExtractionContainers &external_memory;
     bool fallback_to_duration;
     bool force_split_edges;
 
   public:
+    // Interned strings of a way. Ids are only assigned on ingestion of the way, so they do not
+    // depend on the order in which ways are interned.
+    struct WayStrings
+    {
+        NameInterner::Entry *name;
+        // nullptr if the way has no turn lanes in this direction
+        LaneInterner::Entry *turn_lanes_forward;
+        LaneInterner::Entry *turn_lanes_backward;
+    };
+
     explicit ExtractorCallbacks(ExtractionContainers &extraction_containers,
                                 const ProfileProperties &properties);
 
@@ -78,9 +100,17 @@ class ExtractorCallbacks
     // warning: caller needs to take care of synchronization!
     void ProcessRestriction(const boost::optional<InputRestrictionContainer> &restriction);
 
+    // thread-safe, can be called for many ways in parallel before they are processed
+    WayStrings InternWayStrings(const ExtractionWay &result_way);
+
     // warning: caller needs to take care of synchronization!
     void ProcessWay(const osmium::Way &current_way, const ExtractionWay &result_way);
 
+    // warning: caller needs to take care of synchronization!
+    void ProcessWay(const osmium::Way &current_way,
+                    const ExtractionWay &result_way,
+                    const WayStrings &way_strings);
+
     // destroys the internal laneDescriptionMap
     guidance::LaneDescriptionMap &&moveOutLaneDescriptionMap();
 };
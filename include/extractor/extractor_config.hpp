@@ -30,8 +30,11 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <boost/filesystem/path.hpp>
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <string>
+#include <vector>
 
 namespace osrm
 {
@@ -40,7 +43,21 @@ namespace extractor
 
 struct ExtractorConfig
 {
-    ExtractorConfig() noexcept : requested_num_threads(0) {}
+    // The stages of the extraction. Each stage stores a checkpoint with the data the next stage
+    // needs, so stages can be run separately.
+    enum class Stage
+    {
+        Parse,  // reading the input and running the profile
+        Expand, // compressing the node-based graph and generating the edge-expanded graph
+        RTree   // building the spatial index
+    };
+
+    ExtractorConfig()
+        : requested_num_threads(0), sort_memory(4096), check_change_merge(false),
+          stages{Stage::Parse, Stage::Expand, Stage::RTree}, resume(false),
+          keep_checkpoints(false)
+    {
+    }
     void UseDefaultOutputNames()
     {
         std::string basepath = input_path.string();
@@ -79,10 +96,26 @@ struct ExtractorConfig
         intersection_class_data_output_path = basepath + ".osrm.icd";
         compressed_node_based_graph_output_path = basepath + ".osrm.cnbg";
         cnbg_ebg_graph_mapping_output_path = basepath + ".osrm.cnbg_to_ebg";
+        parse_checkpoint_path = basepath + ".osrm.parse_checkpoint";
+        expand_checkpoint_path = basepath + ".osrm.expand_checkpoint";
+    }
+
+    bool HasStage(const Stage stage) const
+    {
+        return std::find(stages.begin(), stages.end(), stage) != stages.end();
+    }
+
+    // Checkpoints are only needed to resume a run or to run the stages separately
+    bool WritesCheckpoints() const
+    {
+        return resume || keep_checkpoints || !HasStage(Stage::Parse) ||
+               !HasStage(Stage::Expand) || !HasStage(Stage::RTree);
     }
 
     boost::filesystem::path input_path;
     boost::filesystem::path profile_path;
+    // OSM change files applied to the input while it is read
+    std::vector<boost::filesystem::path> change_file_paths;
 
     std::string output_file_name;
     std::string restriction_file_name;
@@ -104,15 +137,28 @@ struct ExtractorConfig
     std::string turn_duration_penalties_path;
     std::string compressed_node_based_graph_output_path;
     std::string cnbg_ebg_graph_mapping_output_path;
+    std::string parse_checkpoint_path;
+    std::string expand_checkpoint_path;
 
     unsigned requested_num_threads;
     unsigned small_component_size;
+    // memory in MiB used for sorting, larger data is sorted in runs on disk
+    std::size_t sort_memory;
 
     bool generate_edge_lookup;
     std::string turn_penalties_index_path;
 
     bool use_metadata;
     bool parse_conditionals;
+    // compares the merged input with an in-memory merge of the input and the changes
+    bool check_change_merge;
+
+    // stages to run, the outputs of the other stages are loaded from their checkpoints
+    std::vector<Stage> stages;
+    // skips stages whose checkpoint is newer than their inputs
+    bool resume;
+    // checkpoints are removed after the last stage unless they are kept
+    bool keep_checkpoints;
 };
 }
 }
@@ -2,6 +2,7 @@
 #define OSRM_EXTRACTOR_FILES_HPP
 
 #include "extractor/edge_based_edge.hpp"
+#include "extractor/edge_based_node_segment.hpp"
 #include "extractor/guidance/turn_lane_types.hpp"
 #include "extractor/node_data_container.hpp"
 #include "extractor/serialization.hpp"
@@ -13,6 +14,8 @@
 
 #include <boost/assert.hpp>
 
+#include <cstdint>
+
 namespace osrm
 {
 namespace extractor
@@ -46,6 +49,14 @@ void readEdgeBasedGraph(const boost::filesystem::path &path,
     storage::serialization::read(reader, edge_based_edge_list);
 }
 
+// maps .osrm.ebg, the edges are valid as long as the reader exists
+inline util::vector_view<const EdgeBasedEdge>
+mapEdgeBasedGraph(storage::io::MappedFileReader &reader, EdgeID &max_edge_id)
+{
+    max_edge_id = reader.ReadElementCount64();
+    return reader.ReadVectorView<EdgeBasedEdge>();
+}
+
 // reads .osrm.nodes
 template <typename CoordinatesT, typename PackedOSMIDsT>
 inline void readNodes(const boost::filesystem::path &path,
@@ -232,6 +243,74 @@ inline void writeTurnLaneDescriptions(const boost::filesystem::path &path,
     storage::serialization::write(writer, turn_offsets);
     storage::serialization::write(writer, turn_masks);
 }
+
+// Checkpoints start with a hash of the options they were written with, so they are not reused
+// by a run with different options.
+inline std::uint64_t readCheckpointConfigHash(const boost::filesystem::path &path)
+{
+    const auto fingerprint = storage::io::FileReader::VerifyFingerprint;
+    storage::io::FileReader reader{path, fingerprint};
+
+    return reader.ReadOne<std::uint64_t>();
+}
+
+// reads .osrm.parse_checkpoint
+inline void readParseCheckpoint(const boost::filesystem::path &path,
+                                std::vector<TurnRestriction> &turn_restrictions,
+                                std::vector<std::uint32_t> &turn_lane_offsets,
+                                std::vector<guidance::TurnLaneType::Mask> &turn_lane_masks)
+{
+    const auto fingerprint = storage::io::FileReader::VerifyFingerprint;
+    storage::io::FileReader reader{path, fingerprint};
+
+    reader.ReadOne<std::uint64_t>(); // config hash
+    serialization::read(reader, turn_restrictions);
+    storage::serialization::read(reader, turn_lane_offsets);
+    storage::serialization::read(reader, turn_lane_masks);
+}
+
+// writes .osrm.parse_checkpoint
+inline void writeParseCheckpoint(const boost::filesystem::path &path,
+                                 const std::uint64_t config_hash,
+                                 const std::vector<TurnRestriction> &turn_restrictions,
+                                 const std::vector<std::uint32_t> &turn_lane_offsets,
+                                 const std::vector<guidance::TurnLaneType::Mask> &turn_lane_masks)
+{
+    const auto fingerprint = storage::io::FileWriter::GenerateFingerprint;
+    storage::io::FileWriter writer{path, fingerprint};
+
+    writer.WriteOne(config_hash);
+    writer.WriteElementCount64(turn_restrictions.size());
+    for (const auto &restriction : turn_restrictions)
+    {
+        serialization::write(writer, restriction);
+    }
+    storage::serialization::write(writer, turn_lane_offsets);
+    storage::serialization::write(writer, turn_lane_masks);
+}
+
+// reads .osrm.expand_checkpoint
+inline void readExpandCheckpoint(const boost::filesystem::path &path,
+                                 std::vector<EdgeBasedNodeSegment> &snappable_segments)
+{
+    const auto fingerprint = storage::io::FileReader::VerifyFingerprint;
+    storage::io::FileReader reader{path, fingerprint};
+
+    reader.ReadOne<std::uint64_t>(); // config hash
+    storage::serialization::read(reader, snappable_segments);
+}
+
+// writes .osrm.expand_checkpoint
+inline void writeExpandCheckpoint(const boost::filesystem::path &path,
+                                  const std::uint64_t config_hash,
+                                  const std::vector<EdgeBasedNodeSegment> &snappable_segments)
+{
+    const auto fingerprint = storage::io::FileWriter::GenerateFingerprint;
+    storage::io::FileWriter writer{path, fingerprint};
+
+    writer.WriteOne(config_hash);
+    storage::serialization::write(writer, snappable_segments);
+}
 }
 }
 }
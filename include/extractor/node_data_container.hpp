@@ -54,6 +54,8 @@ template <storage::Ownership Ownership> class EdgeBasedNodeDataContainerImpl
     {
     }
 
+    std::size_t GetNumberOfNodes() const { return geometry_ids.size(); }
+
     GeometryID GetGeometryID(const NodeID node_id) const { return geometry_ids[node_id]; }
 
     TravelMode GetTravelMode(const NodeID node_id) const { return travel_modes[node_id]; }
@@ -0,0 +1,88 @@
+#ifndef OSRM_EXTRACTOR_OSM_CHANGE_APPLIER_HPP
+#define OSRM_EXTRACTOR_OSM_CHANGE_APPLIER_HPP
+
+#include <boost/filesystem/path.hpp>
+
+#include <osmium/memory/buffer.hpp>
+#include <osmium/osm/item_type.hpp>
+#include <osmium/osm/object.hpp>
+#include <osmium/osm/timestamp.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace extractor
+{
+
+/**
+ * Applies OSM change files (.osc) to a base file while it is read by the extractor.
+ *
+ * The changes of all files are kept in memory, which is fine for daily or hourly diffs. The newest
+ * version of a changed object replaces the object of the base file if it is newer than that
+ * object, so stale or overlapping diffs are ignored. Deleted objects are dropped
+ * and created objects are inserted at their position in the base file. This is equivalent to
+ * running `osmium apply-changes` before the extraction, without writing the updated file. The
+ * extraction itself is not incremental, all objects of the merged input are processed again.
+ *
+ * The objects of the base file have to be sorted by type and id, as in the planet and extracts,
+ * and read with their metadata so their versions are known.
+ */
+class OSMChangeApplier
+{
+  public:
+    // Changes of later files take precedence over changes of earlier files with the same version
+    explicit OSMChangeApplier(const std::vector<boost::filesystem::path> &change_files);
+
+    // Applies the changes to the next buffer of the base file. Buffers have to be passed in the
+    // order in which they are read.
+    osmium::memory::Buffer Apply(const osmium::memory::Buffer &base_buffer);
+
+    // Returns the created objects that are ordered after all objects of the base file
+    osmium::memory::Buffer Finish();
+
+    std::size_t GetNumberOfChanges() const { return changes.size(); }
+    std::size_t GetNumberOfModifiedObjects() const { return number_of_modified; }
+    std::size_t GetNumberOfDeletedObjects() const { return number_of_deleted; }
+    std::size_t GetNumberOfCreatedObjects() const { return number_of_created; }
+    // changes whose version is not newer than the object of the base file, which is kept
+    std::size_t GetNumberOfOutdatedChanges() const { return number_of_outdated; }
+
+    // Replication timestamp of the newest change file in ISO format, empty if the files have no
+    // timestamps. Uses the osmosis_replication_timestamp header or the newest object timestamp.
+    std::string GetTimestamp() const;
+
+  private:
+    void AddChange(osmium::memory::Buffer &buffer, const osmium::OSMObject &change, bool replaces);
+
+    std::vector<osmium::memory::Buffer> change_buffers;
+    // newest version of every changed object, sorted like the base file
+    std::vector<const osmium::OSMObject *> changes;
+    std::vector<const osmium::OSMObject *>::const_iterator next_change;
+
+    osmium::Timestamp newest_timestamp;
+
+    osmium::item_type last_type;
+    osmium::object_id_type last_id;
+    bool has_last_object;
+
+    std::size_t number_of_modified;
+    std::size_t number_of_deleted;
+    std::size_t number_of_created;
+    std::size_t number_of_outdated;
+};
+
+// Self-check of the input merge: compares the objects produced by OSMChangeApplier with a
+// reference that loads the base file and all changes into memory and keeps the newest version of
+// every object like `osmium apply-changes`. Returns the number of objects that differ. This only
+// checks the merged input, not the extraction, and is limited to small base files.
+constexpr std::uintmax_t MAX_CHANGE_MERGE_CHECK_INPUT_SIZE = std::uintmax_t{1} << 30;
+std::size_t checkChangeMerge(const boost::filesystem::path &base_file,
+                             const std::vector<boost::filesystem::path> &change_files);
+}
+}
+
+#endif
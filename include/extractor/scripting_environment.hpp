@@ -56,6 +56,8 @@ class ScriptingEnvironment
     virtual std::vector<std::string> GetRestrictions() = 0;
     virtual void SetupSources() = 0;
     virtual void ProcessTurn(ExtractionTurn &turn) = 0;
+    // Computes the penalties of several turns, e.g. all turns of an intersection, at once
+    virtual void ProcessTurns(std::vector<ExtractionTurn> &turns) = 0;
     virtual void ProcessSegment(ExtractionSegment &segment) = 0;
 
     virtual void
@@ -9,6 +9,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include <sol2/sol.hpp>
 
@@ -27,10 +28,22 @@ struct LuaScriptingContext final
     sol::state state;
 
     bool has_turn_penalty_function;
+    bool has_turn_batch_function;
     bool has_node_function;
     bool has_way_function;
     bool has_segment_function;
 
+    // looked up once, since finding a global function in the state is not free
+    sol::function turn_function;
+    sol::function turn_batch_function;
+    sol::function node_function;
+    sol::function way_function;
+    sol::function segment_function;
+
+    // reused for all calls of turn_batch_function to avoid allocating a new table per call
+    sol::table turn_batch;
+    std::size_t turn_batch_size;
+
     int api_version;
 };
 
@@ -58,6 +71,7 @@ class Sol2ScriptingEnvironment final : public ScriptingEnvironment
     std::vector<std::string> GetRestrictions() override;
     void SetupSources() override;
     void ProcessTurn(ExtractionTurn &turn) override;
+    void ProcessTurns(std::vector<ExtractionTurn> &turns) override;
     void ProcessSegment(ExtractionSegment &segment) override;
 
     void
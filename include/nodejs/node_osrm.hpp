@@ -24,6 +24,8 @@ struct Engine final : public Nan::ObjectWrap
     static NAN_METHOD(tile);
     static NAN_METHOD(match);
     static NAN_METHOD(trip);
+    static NAN_METHOD(routeBatch);
+    static NAN_METHOD(tableBatch);
 
     Engine(osrm::EngineConfig &config);
 
@@ -41,6 +41,8 @@ using tile_parameters_ptr = std::unique_ptr<osrm::TileParameters>;
 using match_parameters_ptr = std::unique_ptr<osrm::MatchParameters>;
 using nearest_parameters_ptr = std::unique_ptr<osrm::NearestParameters>;
 using table_parameters_ptr = std::unique_ptr<osrm::TableParameters>;
+using route_batch_parameters_ptr = std::unique_ptr<std::vector<osrm::RouteParameters>>;
+using table_batch_parameters_ptr = std::unique_ptr<std::vector<osrm::TableParameters>>;
 
 template <typename ResultT> inline v8::Local<v8::Value> render(const ResultT &result);
 
@@ -56,6 +58,16 @@ template <> v8::Local<v8::Value> inline render(const osrm::json::Object &result)
     return value;
 }
 
+template <> v8::Local<v8::Value> inline render(const std::vector<osrm::json::Object> &results)
+{
+    v8::Local<v8::Array> array = Nan::New<v8::Array>(results.size());
+    for (auto i = 0u; i < results.size(); ++i)
+    {
+        array->Set(i, render(results[i]));
+    }
+    return array;
+}
+
 inline void ParseResult(const osrm::Status &result_status, osrm::json::Object &result)
 {
     const auto code_iter = result.values.find("code");
@@ -78,6 +90,20 @@ inline void ParseResult(const osrm::Status &result_status, osrm::json::Object &r
 
 inline void ParseResult(const osrm::Status & /*result_status*/, const std::string & /*unused*/) {}
 
+// A batch only fails as a whole on exceptions, failed requests keep their code and message
+inline void ParseResult(const osrm::Status & /*result_status*/,
+                        std::vector<osrm::json::Object> &results)
+{
+    for (auto &result : results)
+    {
+        const auto &code = result.values.at("code").get<osrm::json::String>().value;
+        if (code == "Ok")
+        {
+            ParseResult(osrm::Status::Ok, result);
+        }
+    }
+}
+
 inline engine_config_ptr argumentsToEngineConfig(const Nan::FunctionCallbackInfo<v8::Value> &args)
 {
     Nan::HandleScope scope;
@@ -235,14 +261,9 @@ parseCoordinateArray(const v8::Local<v8::Array> &coordinates_array)
     return resulting_coordinates;
 }
 
-// Parses all the non-service specific parameters
-template <typename ParamType>
-inline bool argumentsToParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
-                                 ParamType &params,
-                                 bool requires_multiple_coordinates)
+// Checks that the first of the arguments is an options object
+inline bool argumentsHaveOptionsObject(const Nan::FunctionCallbackInfo<v8::Value> &args)
 {
-    Nan::HandleScope scope;
-
     if (args.Length() < 2)
     {
         Nan::ThrowTypeError("Two arguments required");
@@ -255,8 +276,15 @@ inline bool argumentsToParameter(const Nan::FunctionCallbackInfo<v8::Value> &arg
         return false;
     }
 
-    v8::Local<v8::Object> obj = Nan::To<v8::Object>(args[0]).ToLocalChecked();
+    return true;
+}
 
+// Parses all the non-service specific parameters of an options object
+template <typename ParamType>
+inline bool objectToParameter(const v8::Local<v8::Object> &obj,
+                              ParamType &params,
+                              bool requires_multiple_coordinates)
+{
     v8::Local<v8::Value> coordinates = obj->Get(Nan::New("coordinates").ToLocalChecked());
     if (coordinates.IsEmpty())
         return false;
@@ -530,6 +558,21 @@ inline bool argumentsToParameter(const Nan::FunctionCallbackInfo<v8::Value> &arg
     return true;
 }
 
+// Parses all the non-service specific parameters
+template <typename ParamType>
+inline bool argumentsToParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
+                                 ParamType &params,
+                                 bool requires_multiple_coordinates)
+{
+    Nan::HandleScope scope;
+
+    if (!argumentsHaveOptionsObject(args))
+        return false;
+
+    v8::Local<v8::Object> obj = Nan::To<v8::Object>(args[0]).ToLocalChecked();
+    return objectToParameter(obj, params, requires_multiple_coordinates);
+}
+
 template <typename ParamType>
 inline bool parseCommonParameters(const v8::Local<v8::Object> &obj, ParamType &params)
 {
@@ -684,17 +727,14 @@ inline bool parseCommonParameters(const v8::Local<v8::Object> &obj, ParamType &p
     return true;
 }
 
-inline route_parameters_ptr
-argumentsToRouteParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
-                          bool requires_multiple_coordinates)
+inline route_parameters_ptr objectToRouteParameter(const v8::Local<v8::Object> &obj,
+                                                   bool requires_multiple_coordinates)
 {
     route_parameters_ptr params = std::make_unique<osrm::RouteParameters>();
-    bool has_base_params = argumentsToParameter(args, params, requires_multiple_coordinates);
+    bool has_base_params = objectToParameter(obj, params, requires_multiple_coordinates);
     if (!has_base_params)
         return route_parameters_ptr();
 
-    v8::Local<v8::Object> obj = Nan::To<v8::Object>(args[0]).ToLocalChecked();
-
     if (obj->Has(Nan::New("continue_straight").ToLocalChecked()))
     {
         auto value = obj->Get(Nan::New("continue_straight").ToLocalChecked());
@@ -735,6 +775,19 @@ argumentsToRouteParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
     return params;
 }
 
+inline route_parameters_ptr
+argumentsToRouteParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
+                          bool requires_multiple_coordinates)
+{
+    Nan::HandleScope scope;
+
+    if (!argumentsHaveOptionsObject(args))
+        return route_parameters_ptr();
+
+    v8::Local<v8::Object> obj = Nan::To<v8::Object>(args[0]).ToLocalChecked();
+    return objectToRouteParameter(obj, requires_multiple_coordinates);
+}
+
 inline tile_parameters_ptr
 argumentsToTileParameters(const Nan::FunctionCallbackInfo<v8::Value> &args, bool /*unused*/)
 {
@@ -834,19 +887,14 @@ argumentsToNearestParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
     return params;
 }
 
-inline table_parameters_ptr
-argumentsToTableParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
-                          bool requires_multiple_coordinates)
+inline table_parameters_ptr objectToTableParameter(const v8::Local<v8::Object> &obj,
+                                                   bool requires_multiple_coordinates)
 {
     table_parameters_ptr params = std::make_unique<osrm::TableParameters>();
-    bool has_base_params = argumentsToParameter(args, params, requires_multiple_coordinates);
+    bool has_base_params = objectToParameter(obj, params, requires_multiple_coordinates);
     if (!has_base_params)
         return table_parameters_ptr();
 
-    v8::Local<v8::Object> obj = Nan::To<v8::Object>(args[0]).ToLocalChecked();
-    if (obj.IsEmpty())
-        return table_parameters_ptr();
-
     if (obj->Has(Nan::New("sources").ToLocalChecked()))
     {
         v8::Local<v8::Value> sources = obj->Get(Nan::New("sources").ToLocalChecked());
@@ -928,6 +976,82 @@ argumentsToTableParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
     return params;
 }
 
+inline table_parameters_ptr
+argumentsToTableParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
+                          bool requires_multiple_coordinates)
+{
+    Nan::HandleScope scope;
+
+    if (!argumentsHaveOptionsObject(args))
+        return table_parameters_ptr();
+
+    v8::Local<v8::Object> obj = Nan::To<v8::Object>(args[0]).ToLocalChecked();
+    return objectToTableParameter(obj, requires_multiple_coordinates);
+}
+
+// Parses an array of options objects with the parser of the single request
+template <typename ParamType, typename ObjectParser>
+inline std::unique_ptr<std::vector<ParamType>>
+argumentsToBatchParameters(const Nan::FunctionCallbackInfo<v8::Value> &args,
+                           ObjectParser object_to_parameter,
+                           bool requires_multiple_coordinates)
+{
+    Nan::HandleScope scope;
+
+    if (args.Length() < 2)
+    {
+        Nan::ThrowTypeError("Two arguments required");
+        return nullptr;
+    }
+
+    if (!args[0]->IsArray())
+    {
+        Nan::ThrowTypeError("First arg must be an array of objects");
+        return nullptr;
+    }
+
+    auto options_array = v8::Local<v8::Array>::Cast(args[0]);
+    auto batch = std::make_unique<std::vector<ParamType>>();
+    batch->reserve(options_array->Length());
+    for (uint32_t i = 0; i < options_array->Length(); ++i)
+    {
+        v8::Local<v8::Value> options = options_array->Get(i);
+        if (options.IsEmpty())
+            return nullptr;
+
+        if (!options->IsObject())
+        {
+            Nan::ThrowTypeError("Batch entries must be objects");
+            return nullptr;
+        }
+
+        auto params = object_to_parameter(Nan::To<v8::Object>(options).ToLocalChecked(),
+                                          requires_multiple_coordinates);
+        if (!params)
+            return nullptr;
+
+        batch->push_back(std::move(*params));
+    }
+
+    return batch;
+}
+
+inline route_batch_parameters_ptr
+argumentsToRouteBatchParameters(const Nan::FunctionCallbackInfo<v8::Value> &args,
+                                bool requires_multiple_coordinates)
+{
+    return argumentsToBatchParameters<osrm::RouteParameters>(
+        args, &objectToRouteParameter, requires_multiple_coordinates);
+}
+
+inline table_batch_parameters_ptr
+argumentsToTableBatchParameters(const Nan::FunctionCallbackInfo<v8::Value> &args,
+                                bool requires_multiple_coordinates)
+{
+    return argumentsToBatchParameters<osrm::TableParameters>(
+        args, &objectToTableParameter, requires_multiple_coordinates);
+}
+
 inline trip_parameters_ptr
 argumentsToTripParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
                          bool requires_multiple_coordinates)
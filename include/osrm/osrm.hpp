@@ -33,6 +33,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace osrm
 {
@@ -44,6 +45,8 @@ using engine::api::NearestParameters;
 using engine::api::TripParameters;
 using engine::api::MatchParameters;
 using engine::api::TileParameters;
+using engine::api::RouteResult;
+using engine::api::TableResult;
 
 /**
  * Represents a Open Source Routing Machine with access to its services.
@@ -58,6 +61,10 @@ using engine::api::TileParameters;
  *  - Tile: vector tiles with internal graph representation
  *
  *  All services take service-specific parameters, fill a JSON object, and return a status code.
+ *  Route and Table can fill plain result objects instead, skipping the JSON construction.
+ *
+ *  Route and Table can also be called with a batch of independent requests, which are computed
+ *  in parallel on the same dataset.
  */
 class OSRM final
 {
@@ -85,6 +92,15 @@ class OSRM final
      */
     Status Route(const RouteParameters &parameters, json::Object &result) const;
 
+    /**
+     * Shortest path queries for coordinates without building a JSON response.
+     *
+     * \param parameters route query specific parameters
+     * \return Status indicating success for the query or failure
+     * \see Status, RouteParameters and RouteResult
+     */
+    Status Route(const RouteParameters &parameters, RouteResult &result) const;
+
     /**
      * Distance tables for coordinates.
      *
@@ -94,6 +110,15 @@ class OSRM final
      */
     Status Table(const TableParameters &parameters, json::Object &result) const;
 
+    /**
+     * Distance tables for coordinates without building a JSON response.
+     *
+     * \param parameters table query specific parameters
+     * \return Status indicating success for the query or failure
+     * \see Status, TableParameters and TableResult
+     */
+    Status Table(const TableParameters &parameters, TableResult &result) const;
+
     /**
      * Nearest street segment for coordinate.
      *
@@ -130,6 +155,28 @@ class OSRM final
      */
     Status Tile(const TileParameters &parameters, std::string &result) const;
 
+    /**
+     * Shortest path queries for a batch of independent requests.
+     *
+     * \param parameters route query specific parameters of every request
+     * \param results one JSON object per request in the same order, each with its own status code
+     * \return Status::Ok if all requests succeeded, Status::Error otherwise
+     * \see Status, RouteParameters and json::Object
+     */
+    Status RouteBatch(const std::vector<RouteParameters> &parameters,
+                      std::vector<json::Object> &results) const;
+
+    /**
+     * Distance tables for a batch of independent requests.
+     *
+     * \param parameters table query specific parameters of every request
+     * \param results one JSON object per request in the same order, each with its own status code
+     * \return Status::Ok if all requests succeeded, Status::Error otherwise
+     * \see Status, TableParameters and json::Object
+     */
+    Status TableBatch(const std::vector<TableParameters> &parameters,
+                      std::vector<json::Object> &results) const;
+
   private:
     std::unique_ptr<engine::EngineInterface> engine_;
 };
@@ -52,6 +52,8 @@ struct NearestParameters;
 struct TripParameters;
 struct MatchParameters;
 struct TileParameters;
+struct RouteResult;
+struct TableResult;
 } // ns api
 
 class EngineInterface;
@@ -2,8 +2,17 @@
 #define OSRM_PARTITION_ANNOTATE_HPP_
 
 #include "partition/bisection_graph.hpp"
+#include "partition/cell_storage.hpp"
+#include "partition/multi_level_partition.hpp"
+#include "util/integer_range.hpp"
 #include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
 #include <cstdint>
+#include <iterator>
+#include <ostream>
 #include <utility>
 #include <vector>
 
@@ -107,8 +116,59 @@ class AnnotatedPartition
         }
     };
 
+    // Metrics of a single level of the final multi-level partition of the edge-based graph. They
+    // determine the size of the cell storage, the customization time and the query performance.
+    struct CellLevelMetrics
+    {
+        // the requested maximum cell size of the level
+        std::size_t max_cell_size;
+        std::size_t number_of_cells;
+        std::size_t largest_cell;
+        // cells that are larger than max_cell_size, since the bisection could not split them
+        std::size_t oversized_cells;
+
+        std::size_t boundary_nodes;
+        std::size_t max_boundary_nodes_per_cell;
+
+        // number of weights in the clique matrices (sources x destinations) of all cells
+        std::size_t clique_entries;
+        std::size_t max_clique_entries;
+
+        // estimated number of edge relaxations to customize the level: one search per source node
+        // over the edges (level 1) or the clique arcs of the children (higher levels) of its cell
+        std::size_t customization_cost;
+
+        // average number of nodes a query settles in a cell of this level: the nodes of the cell
+        // on level 1, the boundary nodes of its children on higher levels
+        double query_nodes_per_cell;
+
+        std::ostream &print(std::ostream &os, const std::size_t level) const
+        {
+            os << "level " << level << ": #cells " << number_of_cells << " largest cell "
+               << largest_cell << " (max " << max_cell_size << ", " << oversized_cells
+               << " oversized) #boundary nodes " << boundary_nodes << " (max per cell "
+               << max_boundary_nodes_per_cell << ") clique entries " << clique_entries
+               << " (max per cell " << max_clique_entries << ") customization cost "
+               << customization_cost << " query nodes per cell " << query_nodes_per_cell;
+            return os;
+        }
+    };
+
     AnnotatedPartition(const BisectionGraph &graph, const std::vector<BisectionID> &bisection_ids);
 
+    // Analyses every level of a multi-level partition of `graph`. The result is indexed by level-1.
+    template <typename GraphT>
+    static std::vector<CellLevelMetrics>
+    AnalyseCells(const GraphT &graph,
+                 const MultiLevelPartition &partition,
+                 const CellStorage &storage,
+                 const std::vector<std::size_t> &max_cell_sizes);
+
+    // Estimates the number of nodes a query between two distant nodes settles: the forward and
+    // the reverse search each settle their cell on every level and meet on the boundary nodes of
+    // all cells of the highest level.
+    static double EstimateQueryNodes(const std::vector<CellLevelMetrics> &metrics);
+
   private:
     // print distribution of level graph as it is
     void PrintBisection(const std::vector<SizedID> &implicit_tree,
@@ -130,6 +190,101 @@ class AnnotatedPartition
                    const std::vector<BisectionID> &bisection_ids) const;
 };
 
+template <typename GraphT>
+std::vector<AnnotatedPartition::CellLevelMetrics>
+AnnotatedPartition::AnalyseCells(const GraphT &graph,
+                                 const MultiLevelPartition &partition,
+                                 const CellStorage &storage,
+                                 const std::vector<std::size_t> &max_cell_sizes)
+{
+    const LevelID number_of_levels = partition.GetNumberOfLevels();
+    BOOST_ASSERT(max_cell_sizes.size() + 1 == number_of_levels);
+
+    std::vector<CellLevelMetrics> metrics;
+    // the clique entries of the cells of the previous level, the arcs of their parents
+    std::vector<std::size_t> child_clique_entries;
+    std::vector<std::size_t> child_boundary_nodes;
+    for (LevelID level = 1; level < number_of_levels; ++level)
+    {
+        const auto number_of_cells = partition.GetNumberOfCells(level);
+        std::vector<std::size_t> cell_sizes(number_of_cells, 0);
+        // edges within a cell on level 1, edges between children on higher levels
+        std::vector<std::size_t> cell_arcs(number_of_cells, 0);
+
+        for (const auto node : util::irange<NodeID>(0, graph.GetNumberOfNodes()))
+        {
+            const auto cell = partition.GetCell(level, node);
+            ++cell_sizes[cell];
+            for (const auto edge : graph.GetAdjacentEdgeRange(node))
+            {
+                const auto target = graph.GetTarget(edge);
+                if (partition.GetCell(level, target) != cell)
+                    continue;
+                if (level == 1 || partition.GetCell(level - 1, node) !=
+                                      partition.GetCell(level - 1, target))
+                    ++cell_arcs[cell];
+            }
+        }
+
+        CellLevelMetrics level_metrics{};
+        level_metrics.max_cell_size = max_cell_sizes[level - 1];
+        level_metrics.number_of_cells = number_of_cells;
+        std::vector<std::size_t> clique_entries(number_of_cells);
+        std::vector<std::size_t> boundary_nodes(number_of_cells);
+        std::size_t query_nodes = 0;
+        for (const auto cell_id : util::irange<CellID>(0, number_of_cells))
+        {
+            const auto cell = storage.GetCell(level, cell_id);
+            const auto sources = cell.GetSourceNodes();
+            const auto destinations = cell.GetDestinationNodes();
+
+            // both boundaries are sorted by node id
+            std::vector<NodeID> boundary;
+            std::set_union(sources.begin(),
+                           sources.end(),
+                           destinations.begin(),
+                           destinations.end(),
+                           std::back_inserter(boundary));
+            boundary_nodes[cell_id] = boundary.size();
+            clique_entries[cell_id] = sources.size() * destinations.size();
+
+            auto arcs = cell_arcs[cell_id];
+            if (level == 1)
+            {
+                query_nodes += cell_sizes[cell_id];
+            }
+            else
+            {
+                for (auto child = partition.BeginChildren(level, cell_id);
+                     child < partition.EndChildren(level, cell_id);
+                     ++child)
+                {
+                    arcs += child_clique_entries[child];
+                    query_nodes += child_boundary_nodes[child];
+                }
+            }
+
+            level_metrics.largest_cell = std::max(level_metrics.largest_cell, cell_sizes[cell_id]);
+            level_metrics.oversized_cells += cell_sizes[cell_id] > level_metrics.max_cell_size;
+            level_metrics.boundary_nodes += boundary_nodes[cell_id];
+            level_metrics.max_boundary_nodes_per_cell =
+                std::max(level_metrics.max_boundary_nodes_per_cell, boundary_nodes[cell_id]);
+            level_metrics.clique_entries += clique_entries[cell_id];
+            level_metrics.max_clique_entries =
+                std::max(level_metrics.max_clique_entries, clique_entries[cell_id]);
+            level_metrics.customization_cost += sources.size() * arcs;
+        }
+        level_metrics.query_nodes_per_cell =
+            number_of_cells == 0 ? 0. : static_cast<double>(query_nodes) / number_of_cells;
+
+        metrics.push_back(level_metrics);
+        child_clique_entries = std::move(clique_entries);
+        child_boundary_nodes = std::move(boundary_nodes);
+    }
+
+    return metrics;
+}
+
 } // namespace partition
 } // namespace osrm
 
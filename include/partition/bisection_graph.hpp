@@ -8,7 +8,10 @@
 
 #include "extractor/edge_based_edge.hpp"
 
+#include <boost/assert.hpp>
+
 #include <cstddef>
+#include <cstdint>
 
 #include <algorithm>
 #include <iterator>
@@ -55,42 +58,53 @@ using BisectionGraphNode = NodeEntryWrapper<BisectionNode>;
 using BisectionInputEdge = GraphConstructionWrapper<BisectionEdge>;
 using BisectionGraph = RemappableGraph<BisectionGraphNode, BisectionEdge>;
 
+// the nodes are kept for the whole partitioning, so we keep them as small as possible
+static_assert(sizeof(BisectionGraphNode) == sizeof(util::Coordinate) + 3 * sizeof(std::uint32_t),
+              "BisectionGraphNode is not packed");
+
 // Factory method to construct the bisection graph form a set of coordinates and Input Edges (need
-// to contain source and target). Edges needs to be labeled from zero
-inline BisectionGraph makeBisectionGraph(const std::vector<util::Coordinate> &coordinates,
-                                         const std::vector<BisectionInputEdge> &edges)
+// to contain source and target). Edges needs to be labeled from zero and grouped by their source.
+// Both can be given as any random access range, e.g. views into a memory mapped file.
+// Parallel edges don't change the cuts of the bisection, so only one of them is kept.
+template <typename CoordinatesT, typename EdgesT>
+BisectionGraph makeBisectionGraph(const CoordinatesT &coordinates, const EdgesT &edges)
 {
     std::vector<BisectionGraph::NodeT> result_nodes;
     result_nodes.reserve(coordinates.size());
     std::vector<BisectionGraph::EdgeT> result_edges;
     result_edges.reserve(edges.size());
 
-    // find the end of edges that belong to node_id
-    const auto advance_edge_itr = [&edges, &result_edges](const std::size_t node_id,
-                                                          auto edge_itr) {
+    // add the edges that belong to node_id, returns the end of its input edges
+    const auto add_edges = [&edges, &result_edges](const std::size_t node_id, auto edge_itr) {
+        const auto range_begin = result_edges.size();
         while (edge_itr != edges.end() && edge_itr->source == node_id)
         {
-            result_edges.push_back(edge_itr->Reduce());
+            result_edges.push_back(BisectionGraph::EdgeT{edge_itr->target});
             ++edge_itr;
         }
-        return edge_itr;
-    };
 
-    // create a bisection node, requires the ID of the node as well as the lower bound to its edges
-    const auto make_bisection_node = [&edges, &coordinates](
-        const std::size_t node_id, const auto begin_itr, const auto end_itr) {
-        std::size_t range_begin = std::distance(edges.begin(), begin_itr);
-        std::size_t range_end = std::distance(edges.begin(), end_itr);
-        return BisectionGraph::NodeT(range_begin, range_end, coordinates[node_id], node_id);
+        const auto by_target = [](const BisectionEdge &lhs, const BisectionEdge &rhs) {
+            return lhs.target < rhs.target;
+        };
+        const auto same_target = [](const BisectionEdge &lhs, const BisectionEdge &rhs) {
+            return lhs.target == rhs.target;
+        };
+        std::sort(result_edges.begin() + range_begin, result_edges.end(), by_target);
+        result_edges.erase(
+            std::unique(result_edges.begin() + range_begin, result_edges.end(), same_target),
+            result_edges.end());
+        return edge_itr;
     };
 
     auto edge_itr = edges.begin();
     for (std::size_t node_id = 0; node_id < coordinates.size(); ++node_id)
     {
-        const auto begin_itr = edge_itr;
-        edge_itr = advance_edge_itr(node_id, edge_itr);
-        result_nodes.emplace_back(make_bisection_node(node_id, begin_itr, edge_itr));
+        const std::size_t range_begin = result_edges.size();
+        edge_itr = add_edges(node_id, edge_itr);
+        result_nodes.emplace_back(
+            range_begin, result_edges.size(), coordinates[node_id], node_id);
     }
+    BOOST_ASSERT(edge_itr == edges.end());
 
     return BisectionGraph(std::move(result_nodes), std::move(result_edges));
 }
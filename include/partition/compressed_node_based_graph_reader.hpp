@@ -4,9 +4,13 @@
 #include "storage/io.hpp"
 #include "util/coordinate.hpp"
 #include "util/typedefs.hpp"
+#include "util/vector_view.hpp"
 
+#include <boost/assert.hpp>
+#include <boost/filesystem/path.hpp>
+
+#include <algorithm>
 #include <string>
-#include <vector>
 
 namespace osrm
 {
@@ -19,14 +23,17 @@ struct CompressedNodeBasedGraphEdge
     NodeID target;
 };
 
+// The compressed node based graph as it is stored in the .osrm.cnbg file. The file is mapped into
+// memory and the edges and coordinates are used in place.
 struct CompressedNodeBasedGraph
 {
-    CompressedNodeBasedGraph(storage::io::FileReader &reader)
+    CompressedNodeBasedGraph(const boost::filesystem::path &path)
+        : reader(path, storage::io::MappedFileReader::VerifyFingerprint)
     {
         // Reads:  | Fingerprint | #e | #n | edges | coordinates |
         // - uint64: number of edges (from, to) pairs
         // - uint64: number of nodes and therefore also coordinates
-        // - (uint32_t, uint32_t): num_edges * edges
+        // - (uint32_t, uint32_t): num_edges * edges, grouped by source
         // - (int32_t, int32_t: num_nodes * coordinates (lon, lat)
         //
         // Gets written in Extractor::WriteCompressedNodeBasedGraph
@@ -34,24 +41,23 @@ struct CompressedNodeBasedGraph
         const auto num_edges = reader.ReadElementCount64();
         const auto num_nodes = reader.ReadElementCount64();
 
-        edges.resize(num_edges);
-        coordinates.resize(num_nodes);
+        edges = reader.ReadView<CompressedNodeBasedGraphEdge>(num_edges);
+        coordinates = reader.ReadView<util::Coordinate>(num_nodes);
 
-        reader.ReadInto(edges);
-        reader.ReadInto(coordinates);
+        BOOST_ASSERT(std::is_sorted(
+            edges.begin(), edges.end(), [](const auto &lhs, const auto &rhs) {
+                return lhs.source < rhs.source;
+            }));
     }
 
-    std::vector<CompressedNodeBasedGraphEdge> edges;
-    std::vector<util::Coordinate> coordinates;
+    storage::io::MappedFileReader reader;
+    util::vector_view<const CompressedNodeBasedGraphEdge> edges;
+    util::vector_view<const util::Coordinate> coordinates;
 };
 
 inline CompressedNodeBasedGraph LoadCompressedNodeBasedGraph(const std::string &path)
 {
-    const auto fingerprint = storage::io::FileReader::VerifyFingerprint;
-    storage::io::FileReader reader(path, fingerprint);
-
-    CompressedNodeBasedGraph graph{reader};
-    return graph;
+    return CompressedNodeBasedGraph{path};
 }
 
 } // ns partition
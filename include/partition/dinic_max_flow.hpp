@@ -5,8 +5,6 @@
 
 #include <cstdint>
 #include <functional>
-#include <set>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -28,13 +26,39 @@ class DinicMaxFlow
         std::vector<bool> flags;
     };
 
-    // input parameter storing the set o
-    using SourceSinkNodes = std::unordered_set<NodeID>;
+    // input parameter storing the set of source/sink nodes, every node can only be listed once.
+    // A plain list is a lot smaller than a hash set for the large sets of the inertial flow.
+    using SourceSinkNodes = std::vector<NodeID>;
+
+    // Numbers the edges of a view and links the two directions of every undirected edge. It only
+    // depends on the view, so it can be shared between all flow computations on the same view.
+    // The bisection graph does not contain parallel edges, so every edge has a single reverse.
+    class EdgeIndex
+    {
+      public:
+        explicit EdgeIndex(const GraphView &view);
+
+        // position of the first edge of a node
+        EdgeID BeginEdge(const NodeID nid) const { return first_edge[nid]; }
+
+        EdgeID Reverse(const EdgeID eid) const { return reverse[eid]; }
+
+        std::size_t NumberOfEdges() const { return reverse.size(); }
+
+      private:
+        std::vector<EdgeID> first_edge;
+        std::vector<EdgeID> reverse;
+    };
 
     MinCut operator()(const GraphView &view,
                       const SourceSinkNodes &source_nodes,
                       const SourceSinkNodes &sink_nodes) const;
 
+    MinCut operator()(const GraphView &view,
+                      const EdgeIndex &edge_index,
+                      const SourceSinkNodes &source_nodes,
+                      const SourceSinkNodes &sink_nodes) const;
+
     // validates the inpiut parameters to the flow algorithm (e.g. not intersecting)
     bool Validate(const GraphView &view,
                   const SourceSinkNodes &source_nodes,
@@ -44,9 +68,28 @@ class DinicMaxFlow
     // the level of each node in the graph (==hops in BFS from source)
     using LevelGraph = std::vector<Level>;
 
-    // this is actually faster than using an unordered_set<Edge>, stores all edges that have
-    // capacity grouped by node
-    using FlowEdges = std::vector<std::set<NodeID>>;
+    // membership of the nodes in the source or sink set, checked in the inner loops of the search
+    using NodeFlags = std::vector<bool>;
+
+    // Flow on the edges of the view, indexed by the EdgeIndex. Every undirected edge carries at
+    // most one unit of flow, so a flag per direction is enough.
+    class FlowEdges
+    {
+      public:
+        explicit FlowEdges(const EdgeIndex &edge_index);
+
+        // there is flow on the edge from its source to its target
+        bool HasFlow(const EdgeID eid) const { return flow[eid]; }
+        // there is flow on the edge from its target to its source
+        bool HasReverseFlow(const EdgeID eid) const { return flow[edge_index.Reverse(eid)]; }
+        // sends one unit of flow from the source to the target of the edge
+        void Augment(const EdgeID eid);
+
+      private:
+        const EdgeIndex &edge_index;
+        // one additional entry that never has flow for edges without opposite direction
+        std::vector<bool> flow;
+    };
 
     // The level graph (see [1]) is based on a BFS computation. We assign a level to all nodes
     // (starting with 0 for all source nodes) and assign the hop distance in the residual graph as
@@ -57,11 +100,13 @@ class DinicMaxFlow
     //  \   /
     //    b
     // would assign s = 0, a,b = 1, t=2
-    LevelGraph ComputeLevelGraph(const GraphView &view,
-                                 const std::vector<NodeID> &border_source_nodes,
-                                 const SourceSinkNodes &source_nodes,
-                                 const SourceSinkNodes &sink_nodes,
-                                 const FlowEdges &flow) const;
+    void ComputeLevelGraph(LevelGraph &levels,
+                           const GraphView &view,
+                           const EdgeIndex &edge_index,
+                           const std::vector<NodeID> &border_source_nodes,
+                           const NodeFlags &is_source,
+                           const NodeFlags &is_sink,
+                           const FlowEdges &flow) const;
 
     // Using the above levels (see ComputeLevelGraph), we can use multiple DFS (that can now be
     // directed at the sink) to find a flow that completely blocks the level graph (i.e. no path
@@ -69,22 +114,33 @@ class DinicMaxFlow
     std::size_t BlockingFlow(FlowEdges &flow,
                              LevelGraph &levels,
                              const GraphView &view,
-                             const SourceSinkNodes &source_nodes,
+                             const EdgeIndex &edge_index,
+                             const NodeFlags &is_source,
                              const std::vector<NodeID> &border_sink_nodes) const;
 
     // Finds a single augmenting path from a node to the sink side following levels in the level
     // graph. We don't actually remove the edges, so we have to check for increasing level values.
     // Since we know which sinks have been reached, we actually search for these paths starting at
     // sink nodes, instead of the source, so we can save a few dfs runs
-    std::vector<NodeID> GetAugmentingPath(LevelGraph &levels,
+    // The path is returned as the edges from the source to the sink side.
+    std::vector<EdgeID> GetAugmentingPath(LevelGraph &levels,
                                           const NodeID from,
                                           const GraphView &view,
+                                          const EdgeIndex &edge_index,
                                           const FlowEdges &flow,
-                                          const SourceSinkNodes &source_nodes) const;
-
-    // Builds an actual cut result from a level graph
-    MinCut
-    MakeCut(const GraphView &view, const LevelGraph &levels, const std::size_t flow_value) const;
+                                          const NodeFlags &is_source) const;
+
+    // Builds an actual cut result from a level graph. A maximum flow usually allows for more than
+    // one minimal cut: the nodes reachable from the sources in the residual graph and all nodes
+    // that cannot reach the sinks in the residual graph both form the source side of a minimal
+    // cut. We return the one that is closer to splitting the view in half.
+    MinCut MakeCut(const GraphView &view,
+                   const EdgeIndex &edge_index,
+                   const LevelGraph &levels,
+                   const std::vector<NodeID> &border_sink_nodes,
+                   const SourceSinkNodes &sink_nodes,
+                   const FlowEdges &flow,
+                   const std::size_t flow_value) const;
 };
 
 } // namespace partition
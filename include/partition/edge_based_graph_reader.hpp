@@ -26,8 +26,8 @@ namespace partition
 {
 
 // Bidirectional (s,t) to (s,t) and (t,s)
-std::vector<extractor::EdgeBasedEdge>
-splitBidirectionalEdges(const std::vector<extractor::EdgeBasedEdge> &edges)
+template <typename EdgesT>
+std::vector<extractor::EdgeBasedEdge> splitBidirectionalEdges(const EdgesT &edges)
 {
     std::vector<extractor::EdgeBasedEdge> directed;
     directed.reserve(edges.size() * 2);
@@ -183,9 +183,10 @@ std::vector<extractor::EdgeBasedEdge> graphToEdges(const DynamicEdgeBasedGraph &
 
 inline DynamicEdgeBasedGraph LoadEdgeBasedGraph(const boost::filesystem::path &path)
 {
+    // the edges are only needed to build the directed edges, so they are used from the mapping
+    storage::io::MappedFileReader reader(path, storage::io::MappedFileReader::VerifyFingerprint);
     EdgeID max_node_id;
-    std::vector<extractor::EdgeBasedEdge> edges;
-    extractor::files::readEdgeBasedGraph(path, max_node_id, edges);
+    const auto edges = extractor::files::mapEdgeBasedGraph(reader, max_node_id);
 
     auto directed = splitBidirectionalEdges(edges);
     auto tidied = prepareEdgesForUsageInGraph<DynamicEdgeBasedGraphEdge>(std::move(directed));
@@ -0,0 +1,32 @@
+#ifndef OSRM_PARTITION_FM_REFINEMENT_HPP_
+#define OSRM_PARTITION_FM_REFINEMENT_HPP_
+
+#include "partition/dinic_max_flow.hpp"
+#include "partition/graph_view.hpp"
+
+#include <cstddef>
+
+namespace osrm
+{
+namespace partition
+{
+
+// Improves a bisection of the view with Fiduccia-Mattheyses [1] passes. A pass moves nodes
+// between the two sides in the order of the largest reduction of crossing edges (allowing moves
+// that increase them to escape local minima), moves every node at most once and keeps the best
+// prefix of moves. Moves never make the larger side exceed `balance` times half the nodes, or the
+// larger side of the initial cut if that is already bigger.
+//
+// Returns the refined cut, with `num_edges` set to the number of edges crossing it. Stops after
+// `num_passes` passes or as soon as a pass does not improve the cut.
+//
+// [1] A Linear-Time Heuristic for Improving Network Partitions, Fiduccia and Mattheyses, 1982
+DinicMaxFlow::MinCut refineCut(const GraphView &view,
+                               DinicMaxFlow::MinCut cut,
+                               const double balance,
+                               const std::size_t num_passes);
+
+} // namespace partition
+} // namespace osrm
+
+#endif // OSRM_PARTITION_FM_REFINEMENT_HPP_
@@ -5,6 +5,7 @@
 
 #include <array>
 #include <string>
+#include <vector>
 
 namespace osrm
 {
@@ -15,7 +16,7 @@ struct PartitionConfig
 {
     PartitionConfig()
         : requested_num_threads(0), balance(1.2), boundary_factor(0.25), num_optimizing_cuts(10),
-          small_component_size(1000),
+          small_component_size(1000), num_refinement_passes(0),
           max_cell_sizes{128, 128 * 32, 128 * 32 * 16, 128 * 32 * 16 * 32}
     {
     }
@@ -55,6 +56,8 @@ struct PartitionConfig
     boost::filesystem::path storage_path;
     boost::filesystem::path node_data_path;
     boost::filesystem::path hsgr_path;
+    // optional JSON report on the quality of the partition levels
+    boost::filesystem::path report_path;
 
     unsigned requested_num_threads;
 
@@ -62,6 +65,7 @@ struct PartitionConfig
     double boundary_factor;
     std::size_t num_optimizing_cuts;
     std::size_t small_component_size;
+    std::size_t num_refinement_passes;
     std::vector<std::size_t> max_cell_sizes;
 };
 }
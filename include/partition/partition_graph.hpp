@@ -8,6 +8,8 @@
 #include <vector>
 
 #include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
 #include <boost/range/iterator_range.hpp>
 
 namespace osrm
@@ -26,12 +28,14 @@ template <typename Base> class NodeEntryWrapper : public Base
     NodeEntryWrapper(std::size_t edges_begin_, std::size_t edges_end_, Args &&... args)
         : Base(std::forward<Args>(args)...), edges_begin(edges_begin_), edges_end(edges_end_)
     {
+        BOOST_ASSERT(edges_begin == edges_begin_ && edges_end == edges_end_);
     }
 
   private:
-    // only to be modified by the graph itself
-    std::size_t edges_begin;
-    std::size_t edges_end;
+    // only to be modified by the graph itself. Edge ids fit into 32 bit, which keeps the nodes of
+    // the planet-sized graphs small.
+    EdgeID edges_begin;
+    EdgeID edges_end;
 
     // give the graph access to the node data wrapper
     template <typename NodeEntryT, typename EdgeEntryT> friend class RemappableGraph;
@@ -22,7 +22,8 @@ class RecursiveBisection
                        const double balance,
                        const double boundary_factor,
                        const std::size_t num_optimizing_cuts,
-                       const std::size_t small_component_size);
+                       const std::size_t small_component_size,
+                       const std::size_t num_refinement_passes);
 
     const std::vector<BisectionID> &BisectionIDs() const;
 
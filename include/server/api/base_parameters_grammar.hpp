@@ -143,10 +143,13 @@ struct BaseParametersGrammar : boost::spirit::qi::grammar<Iterator, Signature>
                         (-(qi::double_ | unlimited_rule) %
                          ';')[ph::bind(&engine::api::BaseParameters::radiuses, qi::_r1) = qi::_1];
 
-        hints_rule = qi::lit("hints=") >
-                     (-qi::as_string[qi::repeat(engine::ENCODED_HINT_SIZE)[base64_char]])[ph::bind(
-                         add_hint, qi::_r1, qi::_1)] %
-                         ';';
+        // raw[] so a failed attempt at the long encoding leaves no characters in the attribute
+        hint_rule = qi::raw[qi::repeat(engine::ENCODED_HINT_SIZE)[base64_char] |
+                            qi::repeat(engine::ENCODED_COMPACT_HINT_SIZE)[base64_char]];
+
+        hints_rule =
+            qi::lit("hints=") >
+            (-hint_rule)[ph::bind(add_hint, qi::_r1, qi::_1)] % ';';
 
         generate_hints_rule =
             qi::lit("generate_hints=") >
@@ -185,6 +188,7 @@ struct BaseParametersGrammar : boost::spirit::qi::grammar<Iterator, Signature>
     qi::rule<Iterator, std::vector<osrm::util::Coordinate>()> polyline_rule;
     qi::rule<Iterator, std::vector<osrm::util::Coordinate>()> polyline6_rule;
 
+    qi::rule<Iterator, std::string()> hint_rule;
     qi::rule<Iterator, unsigned char()> base64_char;
     qi::rule<Iterator, std::string()> polyline_chars;
     qi::rule<Iterator, double()> unlimited_rule;
@@ -32,12 +32,15 @@ namespace server
 {
 
 class RequestHandler;
+class RequestScheduler;
 
 /// Represents a single connection from a client.
 class Connection : public std::enable_shared_from_this<Connection>
 {
   public:
-    explicit Connection(boost::asio::io_service &io_service, RequestHandler &handler);
+    explicit Connection(boost::asio::io_service &io_service,
+                        RequestHandler &handler,
+                        RequestScheduler &scheduler);
     Connection(const Connection &) = delete;
     Connection &operator=(const Connection &) = delete;
 
@@ -49,6 +52,12 @@ class Connection : public std::enable_shared_from_this<Connection>
   private:
     void handle_read(const boost::system::error_code &e, std::size_t bytes_transferred);
 
+    /// Run the query and write the reply, executed by a worker of the scheduler.
+    void handle_request(const http::compression_type compression_type);
+
+    /// Reply to a queued request that was dropped because the scheduler stopped.
+    void reject_request();
+
     /// Handle completion of a write operation.
     void handle_write(const boost::system::error_code &e);
 
@@ -58,6 +67,7 @@ class Connection : public std::enable_shared_from_this<Connection>
     boost::asio::io_service::strand strand;
     boost::asio::ip::tcp::socket TCP_socket;
     RequestHandler &request_handler;
+    RequestScheduler &request_scheduler;
     RequestParser request_parser;
     boost::array<char, 8192> incoming_data_buffer;
     http::request current_request;
@@ -21,7 +21,8 @@ class reply
     {
         ok = 200,
         bad_request = 400,
-        internal_server_error = 500
+        internal_server_error = 500,
+        service_unavailable = 503
     } status;
 
     std::vector<header> headers;
@@ -0,0 +1,111 @@
+#ifndef SERVER_REQUEST_SCHEDULER_HPP
+#define SERVER_REQUEST_SCHEDULER_HPP
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace osrm
+{
+namespace server
+{
+namespace api
+{
+struct ParsedURL;
+}
+
+// Priority classes of requests. Queues of lower classes are served first.
+enum class RequestPriority : std::uint8_t
+{
+    Interactive = 0, // nearest, tile
+    Normal = 1,      // route, match, trip and table below the heavy cost threshold
+    Bulk = 2,        // everything above the heavy cost threshold or unparsable
+    NumPriorities = 3
+};
+
+struct RequestClass
+{
+    RequestPriority priority;
+    // estimated cost in number of shortest path searches
+    std::size_t cost;
+};
+
+// Estimates the cost of a request from the coordinates and the
+// sources/destinations options of its parsed URL. This is only a cheap scan of the
+// query string, the actual parameters are parsed by the service.
+RequestClass classifyRequest(const api::ParsedURL &parsed_url,
+                             const std::size_t heavy_request_cost);
+
+struct SchedulerConfig
+{
+    // number of worker threads executing queries
+    unsigned num_workers = 1;
+    // number of requests that can wait per priority class before we reject new ones
+    std::size_t max_queue_size = 1024;
+    // requests estimated to be more expensive than this are moved to RequestPriority::Bulk
+    std::size_t heavy_request_cost = 2500;
+};
+
+// Admission control for the server: requests are sorted into priority classes
+// with bounded queues and executed by a fixed number of workers. Bulk requests
+// can never occupy all workers, so cheap requests always find a free worker
+// even if a burst of large table queries is in the system.
+class RequestScheduler
+{
+  public:
+    using Task = std::function<void()>;
+
+    explicit RequestScheduler(const SchedulerConfig &config);
+    RequestScheduler(const RequestScheduler &) = delete;
+    RequestScheduler &operator=(const RequestScheduler &) = delete;
+    ~RequestScheduler();
+
+    // Classifies the (still URI encoded) request string
+    RequestClass Classify(const std::string &uri) const;
+
+    // Enqueues the task, returns false if the queue of this class is full.
+    // If the scheduler is stopped before the task runs, reject is called instead.
+    bool Submit(const RequestClass request_class, Task task, Task reject = {});
+
+    void Start();
+    // Joins all workers after the running tasks are finished, queued tasks are rejected.
+    void Stop();
+
+    std::size_t GetNumRejected() const;
+
+  private:
+    static constexpr std::size_t NUM_PRIORITIES =
+        static_cast<std::size_t>(RequestPriority::NumPriorities);
+
+    struct QueuedTask
+    {
+        Task run;
+        Task reject;
+    };
+
+    void Work();
+    // Returns NUM_PRIORITIES if there is no task we are allowed to run
+    std::size_t NextQueue() const;
+
+    const SchedulerConfig config;
+    const unsigned max_bulk_workers;
+
+    mutable std::mutex mutex;
+    std::condition_variable task_available;
+    std::array<std::deque<QueuedTask>, NUM_PRIORITIES> queues;
+    unsigned running_bulk_tasks;
+    std::size_t num_rejected;
+    bool stopped;
+    std::vector<std::thread> workers;
+};
+}
+}
+
+#endif
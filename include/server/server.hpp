@@ -3,6 +3,7 @@
 
 #include "server/connection.hpp"
 #include "server/request_handler.hpp"
+#include "server/request_scheduler.hpp"
 #include "server/service_handler.hpp"
 
 #include "util/integer_range.hpp"
@@ -33,18 +34,26 @@ class Server
 {
   public:
     // Note: returns a shared instead of a unique ptr as it is captured in a lambda somewhere else
-    static std::shared_ptr<Server>
-    CreateServer(std::string &ip_address, int ip_port, unsigned requested_num_threads)
+    static std::shared_ptr<Server> CreateServer(std::string &ip_address,
+                                                int ip_port,
+                                                unsigned requested_num_threads,
+                                                SchedulerConfig scheduler_config = {})
     {
         util::Log() << "http 1.1 compression handled by zlib version " << zlibVersion();
         const unsigned hardware_threads = std::max(1u, std::thread::hardware_concurrency());
         const unsigned real_num_threads = std::min(hardware_threads, requested_num_threads);
-        return std::make_shared<Server>(ip_address, ip_port, real_num_threads);
+        scheduler_config.num_workers = real_num_threads;
+        return std::make_shared<Server>(ip_address, ip_port, real_num_threads, scheduler_config);
     }
 
-    explicit Server(const std::string &address, const int port, const unsigned thread_pool_size)
+    explicit Server(const std::string &address,
+                    const int port,
+                    const unsigned thread_pool_size,
+                    const SchedulerConfig &scheduler_config)
         : thread_pool_size(thread_pool_size), acceptor(io_service),
-          new_connection(std::make_shared<Connection>(io_service, request_handler))
+          request_scheduler(scheduler_config),
+          new_connection(
+              std::make_shared<Connection>(io_service, request_handler, request_scheduler))
     {
         const auto port_string = std::to_string(port);
 
@@ -70,6 +79,8 @@ class Server
 
     void Run()
     {
+        request_scheduler.Start();
+
         std::vector<std::shared_ptr<std::thread>> threads;
         for (unsigned i = 0; i < thread_pool_size; ++i)
         {
@@ -81,9 +92,15 @@ class Server
         {
             thread->join();
         }
+
+        request_scheduler.Stop();
     }
 
-    void Stop() { io_service.stop(); }
+    void Stop()
+    {
+        io_service.stop();
+        request_scheduler.Stop();
+    }
 
     void RegisterServiceHandler(std::unique_ptr<ServiceHandlerInterface> service_handler_)
     {
@@ -96,7 +113,8 @@ class Server
         if (!e)
         {
             new_connection->start();
-            new_connection = std::make_shared<Connection>(io_service, request_handler);
+            new_connection =
+                std::make_shared<Connection>(io_service, request_handler, request_scheduler);
             acceptor.async_accept(
                 new_connection->socket(),
                 boost::bind(&Server::HandleAccept, this, boost::asio::placeholders::error));
@@ -106,8 +124,9 @@ class Server
     unsigned thread_pool_size;
     boost::asio::io_service io_service;
     boost::asio::ip::tcp::acceptor acceptor;
-    std::shared_ptr<Connection> new_connection;
     RequestHandler request_handler;
+    RequestScheduler request_scheduler;
+    std::shared_ptr<Connection> new_connection;
 };
 }
 }
@@ -7,12 +7,15 @@
 #include "util/exception_utils.hpp"
 #include "util/fingerprint.hpp"
 #include "util/log.hpp"
+#include "util/vector_view.hpp"
 #include "util/version.hpp"
 
 #include <boost/filesystem/fstream.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/iostreams/seek.hpp>
 
 #include <cerrno>
+#include <cstdint>
 #include <cstring>
 #include <cstring>
 #include <tuple>
@@ -153,7 +156,14 @@ class FileReader
 
     bool ReadAndCheckFingerprint()
     {
-        auto loaded_fingerprint = ReadOne<util::FingerPrint>();
+        CheckFingerprint(filepath, ReadOne<util::FingerPrint>());
+        return true;
+    }
+
+    // Throws if the fingerprint of the file is damaged or from an incompatible version
+    static void CheckFingerprint(const boost::filesystem::path &filepath,
+                                 const util::FingerPrint &loaded_fingerprint)
+    {
         const auto expected_fingerprint = util::FingerPrint::GetValid();
 
         if (!loaded_fingerprint.IsValid())
@@ -172,8 +182,6 @@ class FileReader
                                      ErrorCode::IncompatibleFileVersion,
                                      SOURCE_REF);
         }
-
-        return true;
     }
 
   private:
@@ -182,6 +190,77 @@ class FileReader
     FingerprintFlag fingerprint;
 };
 
+// Reads a file written by FileWriter from a read-only memory mapping. Arrays are returned as views
+// into the mapping instead of being copied, so the pages are loaded on demand and can be dropped
+// by the kernel again. The views are valid as long as the reader exists.
+class MappedFileReader
+{
+  public:
+    enum FingerprintFlag
+    {
+        VerifyFingerprint,
+        HasNoFingerprint
+    };
+
+    MappedFileReader(const boost::filesystem::path &filepath_, const FingerprintFlag flag)
+        : filepath(filepath_), position(0)
+    {
+        try
+        {
+            region.open(filepath);
+        }
+        catch (const std::exception &exc)
+        {
+            throw util::RuntimeError(
+                filepath.string(), ErrorCode::FileOpenError, SOURCE_REF, exc.what());
+        }
+
+        if (flag == VerifyFingerprint)
+        {
+            FileReader::CheckFingerprint(filepath, ReadOne<util::FingerPrint>());
+        }
+    }
+
+    template <typename T> util::vector_view<const T> ReadView(const std::size_t count)
+    {
+#if not defined __GNUC__ or __GNUC__ > 4
+        static_assert(!std::is_pointer<T>::value, "saving pointer types is not allowed");
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "bytewise reading requires trivially copyable type");
+#endif
+
+        if (count > (region.size() - position) / sizeof(T))
+        {
+            throw util::RuntimeError(filepath.string(), ErrorCode::UnexpectedEndOfFile, SOURCE_REF);
+        }
+
+        const auto data = region.data() + position;
+        if (reinterpret_cast<std::uintptr_t>(data) % alignof(T) != 0)
+        {
+            throw util::exception("Misaligned data at offset " + std::to_string(position) +
+                                  " of " + filepath.string() + SOURCE_REF);
+        }
+        position += count * sizeof(T);
+
+        return util::vector_view<const T>(reinterpret_cast<const T *>(data), count);
+    }
+
+    template <typename T> T ReadOne() { return ReadView<T>(1)[0]; }
+
+    std::uint64_t ReadElementCount64() { return ReadOne<std::uint64_t>(); }
+
+    // Reads a vector that was written by storage::serialization::write
+    template <typename T> util::vector_view<const T> ReadVectorView()
+    {
+        return ReadView<T>(ReadElementCount64());
+    }
+
+  private:
+    const boost::filesystem::path filepath;
+    boost::iostreams::mapped_file_source region;
+    std::size_t position;
+};
+
 class FileWriter
 {
   public:
@@ -0,0 +1,79 @@
+#ifndef OSRM_UTIL_CONCURRENT_INTERNER_HPP
+#define OSRM_UTIL_CONCURRENT_INTERNER_HPP
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace osrm
+{
+namespace util
+{
+
+/**
+ * Deduplicates keys that are interned concurrently from many threads.
+ *
+ * Every distinct key gets a single entry which stays valid (and at the same address) for the
+ * life time of the interner, so callers can keep pointers to entries instead of copies of the
+ * keys. The keys are spread over independently locked shards to keep contention low.
+ *
+ * Only the lookup and insertion of entries is synchronized, the values of the entries can be
+ * modified by the caller if it takes care of synchronization itself.
+ */
+template <typename KeyT, typename ValueT, typename HashT = std::hash<KeyT>>
+class ConcurrentInterner
+{
+    static constexpr std::size_t NUM_SHARDS = 64;
+
+  public:
+    using Entry = std::pair<const KeyT, ValueT>;
+
+    // Returns the entry of key. If the key is new, its value is created by make_value().
+    template <typename MakeValue> Entry &Intern(const KeyT &key, MakeValue &&make_value)
+    {
+        const auto hash = HashT{}(key);
+        // the low bits of the hash are used by the hash table of the shard
+        auto &shard = shards[(hash >> 16) % NUM_SHARDS];
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto iter = shard.entries.find(key);
+        if (iter == shard.entries.end())
+        {
+            iter = shard.entries.emplace(key, make_value()).first;
+        }
+        return *iter;
+    }
+
+    Entry &Intern(const KeyT &key)
+    {
+        return Intern(key, [] { return ValueT{}; });
+    }
+
+    std::size_t Size() const
+    {
+        std::size_t size = 0;
+        for (const auto &shard : shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            size += shard.entries.size();
+        }
+        return size;
+    }
+
+  private:
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        // the nodes of an unordered_map are never moved, which keeps references to entries valid
+        std::unordered_map<KeyT, ValueT, HashT> entries;
+    };
+
+    std::array<Shard, NUM_SHARDS> shards;
+};
+}
+}
+
+#endif
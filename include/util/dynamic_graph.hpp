@@ -10,6 +10,9 @@
 
 #include <boost/assert.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <cstdint>
 
 #include <algorithm>
@@ -243,6 +246,98 @@ template <typename EdgeDataT> class DynamicGraph
         return EdgeIterator(node.first_edge + node.edges);
     }
 
+    // Adds a list of edges sorted by source node. Nodes without enough free space behind their
+    // edges are moved to the end of the edge list in one step, then the edges of the different
+    // nodes are written in parallel. Invalidates edge iterators of all source nodes.
+    template <class ContainerT> void InsertEdges(const ContainerT &edges)
+    {
+        struct EdgeBatch
+        {
+            NodeIterator node;
+            std::size_t begin;
+            std::size_t end;
+            // the new position of the edges if the node needs to move
+            EdgeIterator first_edge;
+        };
+
+        std::vector<EdgeBatch> batches;
+        for (std::size_t index = 0; index < edges.size(); ++index)
+        {
+            BOOST_ASSERT(index == 0 || !(edges[index].source < edges[index - 1].source));
+            if (batches.empty() || batches.back().node != edges[index].source)
+                batches.push_back({edges[index].source, index, index, SPECIAL_EDGEID});
+            ++batches.back().end;
+        }
+
+        // Only the empty space behind the edges of a node is used, so every empty edge can be
+        // claimed by a single node and all nodes can check their space at the same time. This
+        // does not hold for nodes without edges: their first edge can point into the empty space
+        // behind another node, so they are always moved.
+        tbb::parallel_for(tbb::blocked_range<std::size_t>(0, batches.size()),
+                          [&](const tbb::blocked_range<std::size_t> &range) {
+                              for (auto index = range.begin(); index != range.end(); ++index)
+                              {
+                                  auto &batch = batches[index];
+                                  if (node_array[batch.node].edges == 0)
+                                      continue;
+                                  const auto required = batch.end - batch.begin;
+                                  EdgeIterator free_edge = EndEdges(batch.node);
+                                  while (free_edge < edge_list.size() &&
+                                         free_edge - EndEdges(batch.node) < required &&
+                                         isDummy(free_edge))
+                                      ++free_edge;
+                                  if (free_edge - EndEdges(batch.node) == required)
+                                      batch.first_edge = node_array[batch.node].first_edge;
+                              }
+                          });
+
+        // reserve the new space of all nodes that need to move
+        std::size_t new_size = edge_list.size();
+        for (auto &batch : batches)
+        {
+            if (batch.first_edge != SPECIAL_EDGEID)
+                continue;
+            batch.first_edge = new_size;
+            new_size += (node_array[batch.node].edges + batch.end - batch.begin) * 1.1 + 2;
+        }
+        if (new_size > edge_list.size())
+        {
+            const std::size_t old_size = edge_list.size();
+            edge_list.resize(new_size);
+            for (const auto edge : irange<std::size_t>(old_size, new_size))
+                makeDummy(edge);
+        }
+
+        tbb::parallel_for(tbb::blocked_range<std::size_t>(0, batches.size()),
+                          [&](const tbb::blocked_range<std::size_t> &range) {
+                              for (auto index = range.begin(); index != range.end(); ++index)
+                              {
+                                  const auto &batch = batches[index];
+                                  Node &node = node_array[batch.node];
+                                  if (batch.first_edge != node.first_edge)
+                                  {
+                                      // move the edges over and invalidate the old ones
+                                      for (const auto i : irange(0u, node.edges))
+                                      {
+                                          edge_list[batch.first_edge + i] =
+                                              edge_list[node.first_edge + i];
+                                          makeDummy(node.first_edge + i);
+                                      }
+                                      node.first_edge = batch.first_edge;
+                                  }
+                                  for (const auto i : irange(batch.begin, batch.end))
+                                  {
+                                      Edge &edge = edge_list[node.first_edge + node.edges];
+                                      edge.target = edges[i].target;
+                                      edge.data = edges[i].data;
+                                      ++node.edges;
+                                  }
+                              }
+                          });
+
+        number_of_edges += edges.size();
+    }
+
     // removes an edge. Invalidates edge iterators for the source node
     void DeleteEdge(const NodeIterator source, const EdgeIterator e)
     {
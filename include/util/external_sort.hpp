@@ -0,0 +1,242 @@
+#ifndef OSRM_UTIL_EXTERNAL_SORT_HPP
+#define OSRM_UTIL_EXTERNAL_SORT_HPP
+
+#include "storage/io.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/filesystem.hpp>
+
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <queue>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+
+struct ExternalSortConfig
+{
+    // Memory in bytes that is used for sorting. Ranges that fit are sorted in memory.
+    std::size_t memory_budget = std::size_t{4} * 1024 * 1024 * 1024;
+    // Directory for the sorted runs of ranges that do not fit into memory
+    boost::filesystem::path temporary_directory = boost::filesystem::temp_directory_path();
+};
+
+namespace detail
+{
+
+// The directory of the runs of one sort, it is removed together with everything in it
+class ExternalSortDirectory
+{
+  public:
+    explicit ExternalSortDirectory(const boost::filesystem::path &parent)
+        : path(parent / boost::filesystem::unique_path("osrm-sort-%%%%-%%%%-%%%%"))
+    {
+        boost::filesystem::create_directories(path);
+    }
+
+    ~ExternalSortDirectory()
+    {
+        boost::system::error_code ignored;
+        boost::filesystem::remove_all(path, ignored);
+    }
+
+    ExternalSortDirectory(const ExternalSortDirectory &) = delete;
+    ExternalSortDirectory &operator=(const ExternalSortDirectory &) = delete;
+
+    const boost::filesystem::path path;
+};
+
+// A sorted run stored in a temporary file, which is removed with the run
+template <typename T> class ExternalSortRun
+{
+  public:
+    ExternalSortRun(boost::filesystem::path path_, const std::vector<T> &values)
+        : path(std::move(path_)), size(values.size())
+    {
+        storage::io::FileWriter writer(path, storage::io::FileWriter::HasNoFingerprint);
+        writer.WriteFrom(values);
+    }
+
+    ~ExternalSortRun()
+    {
+        boost::system::error_code ignored;
+        boost::filesystem::remove(path, ignored);
+    }
+
+    ExternalSortRun(const ExternalSortRun &) = delete;
+    ExternalSortRun &operator=(const ExternalSortRun &) = delete;
+
+    const boost::filesystem::path path;
+    const std::size_t size;
+};
+
+// Reads a run block by block, the next block is prefetched while the current one is merged
+template <typename T> class ExternalSortRunReader
+{
+  public:
+    ExternalSortRunReader(const ExternalSortRun<T> &run, const std::size_t block_size)
+        : reader(run.path, storage::io::FileReader::HasNoFingerprint), remaining(run.size),
+          block_size(block_size), position(0)
+    {
+        BOOST_ASSERT(block_size > 0);
+        Prefetch();
+        NextBlock();
+    }
+
+    bool Empty() const { return position == block.size(); }
+    const T &Current() const { return block[position]; }
+
+    void Advance()
+    {
+        BOOST_ASSERT(!Empty());
+        if (++position == block.size() && next_block.valid())
+        {
+            NextBlock();
+        }
+    }
+
+  private:
+    void Prefetch()
+    {
+        if (remaining == 0)
+            return;
+
+        const auto count = std::min(remaining, block_size);
+        remaining -= count;
+        next_block = std::async(std::launch::async, [this, count] {
+            std::vector<T> values(count);
+            reader.ReadInto(values.data(), count);
+            return values;
+        });
+    }
+
+    void NextBlock()
+    {
+        block = next_block.get();
+        position = 0;
+        Prefetch();
+    }
+
+    storage::io::FileReader reader;
+    std::size_t remaining;
+    const std::size_t block_size;
+    std::vector<T> block;
+    std::size_t position;
+    std::future<std::vector<T>> next_block;
+};
+}
+
+/**
+ * Sorts the range [begin, end) with a memory budget.
+ *
+ * Ranges that fit into the budget are copied into memory and sorted with tbb::parallel_sort.
+ * Larger ranges are split into runs of half the budget that are sorted in parallel and written
+ * to files in a new directory below config.temporary_directory while the next run is sorted.
+ * The runs are then merged back into the range with a k-way merge that prefetches the next block
+ * of every run.
+ *
+ * The range is only accessed sequentially, so it can also be an external memory container.
+ */
+template <typename RandomAccessIterator, typename Compare>
+void externalSort(RandomAccessIterator begin,
+                  RandomAccessIterator end,
+                  Compare compare,
+                  const ExternalSortConfig &config)
+{
+    using T = typename std::iterator_traits<RandomAccessIterator>::value_type;
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "sorted runs are written to disk as raw bytes");
+
+    const std::size_t size = std::distance(begin, end);
+    if (size < 2)
+        return;
+
+    const auto budget_size = std::max<std::size_t>(2, config.memory_budget / sizeof(T));
+    if (size <= budget_size)
+    {
+        std::vector<T> values(begin, end);
+        tbb::parallel_sort(values.begin(), values.end(), compare);
+        std::copy(values.begin(), values.end(), begin);
+        return;
+    }
+
+    // One run is written while the next one is sorted, so each can use half the budget
+    const auto run_size = budget_size / 2;
+    // every sort has its own directory, so concurrent sorts do not see each other's runs
+    const detail::ExternalSortDirectory directory(config.temporary_directory);
+    std::vector<std::unique_ptr<detail::ExternalSortRun<T>>> runs;
+    std::future<std::unique_ptr<detail::ExternalSortRun<T>>> pending_run;
+    for (auto run_begin = begin; run_begin != end;)
+    {
+        const auto run_end =
+            run_begin + std::min<std::size_t>(run_size, std::distance(run_begin, end));
+        std::vector<T> values(run_begin, run_end);
+        run_begin = run_end;
+
+        tbb::parallel_sort(values.begin(), values.end(), compare);
+
+        if (pending_run.valid())
+            runs.push_back(pending_run.get());
+        auto run_path = directory.path / ("run-" + std::to_string(runs.size() + 1));
+        pending_run = std::async(
+            std::launch::async,
+            [run_path = std::move(run_path), values = std::move(values)]() mutable {
+                return std::make_unique<detail::ExternalSortRun<T>>(std::move(run_path), values);
+            });
+    }
+    runs.push_back(pending_run.get());
+
+    // Each reader holds the current and the prefetched block
+    const auto block_size = std::max<std::size_t>(1, budget_size / (2 * runs.size()));
+    // the readers must not move, their prefetching tasks refer to them
+    std::vector<std::unique_ptr<detail::ExternalSortRunReader<T>>> readers;
+    for (const auto &run : runs)
+    {
+        readers.push_back(std::make_unique<detail::ExternalSortRunReader<T>>(*run, block_size));
+    }
+
+    // std::priority_queue is a max-heap, so the comparison is inverted
+    const auto greater = [&](const std::size_t lhs, const std::size_t rhs) {
+        const auto &lhs_value = readers[lhs]->Current();
+        const auto &rhs_value = readers[rhs]->Current();
+        if (compare(rhs_value, lhs_value))
+            return true;
+        if (compare(lhs_value, rhs_value))
+            return false;
+        return lhs > rhs;
+    };
+    std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(greater)> queue(greater);
+    for (std::size_t run_index = 0; run_index < readers.size(); ++run_index)
+    {
+        queue.push(run_index);
+    }
+
+    auto output = begin;
+    while (!queue.empty())
+    {
+        const auto run_index = queue.top();
+        queue.pop();
+
+        auto &reader = *readers[run_index];
+        *output++ = reader.Current();
+        reader.Advance();
+        if (!reader.Empty())
+            queue.push(run_index);
+    }
+    BOOST_ASSERT(output == end);
+}
+}
+}
+
+#endif
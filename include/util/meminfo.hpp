@@ -4,6 +4,10 @@
 #include "util/log.hpp"
 
 #include <stxxl/mng>
+
+#include <cstddef>
+#include <string>
+
 #ifndef _WIN32
 #include <sys/resource.h>
 #endif
@@ -25,22 +29,42 @@ inline void DumpSTXXLStats()
 #endif
 }
 
-inline void DumpMemoryStats()
+// Peak resident memory of the process in bytes, 0 if not available
+inline std::size_t PeakMemoryUsage()
 {
 #ifndef _WIN32
     rusage usage;
     getrusage(RUSAGE_SELF, &usage);
 #ifdef __linux__
     // Under linux, ru.maxrss is in kb
-    util::Log() << "RAM: peak bytes used: " << usage.ru_maxrss * 1024;
+    return usage.ru_maxrss * 1024;
 #else  // __linux__
     // Under BSD systems (OSX), it's in bytes
-    util::Log() << "RAM: peak bytes used: " << usage.ru_maxrss;
+    return usage.ru_maxrss;
 #endif // __linux__
+#else  // _WIN32
+    return 0;
+#endif // _WIN32
+}
+
+inline void DumpMemoryStats()
+{
+#ifndef _WIN32
+    util::Log() << "RAM: peak bytes used: " << PeakMemoryUsage();
 #else  // _WIN32
     util::Log() << "RAM: peak bytes used: <not implemented on Windows>";
 #endif // _WIN32
 }
+
+// Logs the peak memory after a phase of a tool, the phase that raises it is the one to optimize
+inline void DumpMemoryStats(const std::string &phase)
+{
+#ifndef _WIN32
+    util::Log() << "RAM: peak bytes used after " << phase << ": " << PeakMemoryUsage();
+#else  // _WIN32
+    util::Log() << "RAM: peak bytes used after " << phase << ": <not implemented on Windows>";
+#endif // _WIN32
+}
 }
 }
 
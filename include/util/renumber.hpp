@@ -0,0 +1,56 @@
+#ifndef OSRM_UTIL_RENUMBER_HPP
+#define OSRM_UTIL_RENUMBER_HPP
+
+#include "extractor/edge_based_node_segment.hpp"
+
+#include "util/permutation.hpp"
+#include "util/vector_view.hpp"
+
+#include <boost/assert.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+
+// Renumbering of data indexed by or referencing edge-based nodes, shared by osrm-partition and
+// osrm-contract. The permutation maps old node ids to new ones.
+
+inline void renumber(util::vector_view<extractor::EdgeBasedNodeSegment> &segments,
+                     const std::vector<std::uint32_t> &permutation)
+{
+    for (auto &segment : segments)
+    {
+        BOOST_ASSERT(segment.forward_segment_id.enabled);
+        segment.forward_segment_id.id = permutation[segment.forward_segment_id.id];
+        if (segment.reverse_segment_id.enabled)
+            segment.reverse_segment_id.id = permutation[segment.reverse_segment_id.id];
+    }
+}
+
+inline void renumber(std::vector<bool> &flags, const std::vector<std::uint32_t> &permutation)
+{
+    // empty flags mark no node, e.g. the core marker of a completely contracted graph
+    if (flags.empty())
+        return;
+
+    BOOST_ASSERT(flags.size() == permutation.size());
+    std::vector<bool> renumbered_flags(flags.size());
+    for (std::size_t index = 0; index < flags.size(); ++index)
+        renumbered_flags[permutation[index]] = flags[index];
+    flags.swap(renumbered_flags);
+}
+
+// values indexed by node, e.g. node weights and levels
+template <typename T>
+inline void renumber(std::vector<T> &values, const std::vector<std::uint32_t> &permutation)
+{
+    util::inplacePermutation(values.begin(), values.end(), permutation);
+}
+}
+}
+
+#endif
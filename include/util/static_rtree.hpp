@@ -28,6 +28,7 @@
 
 #include <algorithm>
 #include <array>
+#include <future>
 #include <limits>
 #include <memory>
 #include <queue>
@@ -104,19 +105,12 @@ class StaticRTree
      * Step 3a- Repeat this process for each level, until you only create 1 TreeNode
      *          to contain its children (in this case, W).
      *
-     * As we create TreeNodes, we append them to the m_search_tree vector.
+     * The number of TreeNodes in each level only depends on the number of objects, so
+     * the level sizes are computed first and every TreeNode is written straight to its
+     * final position in m_search_tree. The levels are stored from the root downwards,
+     * with the nodes of each level in order:
      *
-     * After this part of the building process, m_search_tree will contain TreeNode
-     * objects in this order:
-     *
-     * ABCDEFGHIJ KLMNO PQR UV W
-     * 10         5     3   2  1  <- number of nodes in the level
-     *
-     * In order to make our math easy later on, we reverse the whole array,
-     * then reverse the nodes within each level:
-     *
-     *   Reversed:        W VU RQP ONMKL JIHGFEDCBA
-     *   Levels reversed: W UV PQR KLMNO ABCDEFGHIJ
+     *   W UV PQR KLMNO ABCDEFGHIJ
      *
      * We also now have the following information:
      *
@@ -127,6 +121,9 @@ class StaticRTree
      *
      *   level starts = {0,1,3,6,11}
      *
+     * Since the nodes of a level only depend on the level below, the leaves and
+     * each level above them are built in parallel.
+     *
      * Now, some basic math can be used to navigate around the tree.  See
      * the body of the `child_indexes` function for the details.
      *
@@ -258,6 +255,31 @@ class StaticRTree
     // This is a view of the EdgeDataT data mmap'd from the .fileIndex file
     util::vector_view<const EdgeDataT> m_objects;
 
+    // Number of leaves that are packed before they are written to the .fileIndex
+    static constexpr std::uint64_t LEAF_CHUNK_SIZE = 16 * 1024;
+
+    // Bounding box of the segment in Web Mercator
+    Rectangle GetProjectedRectangle(const EdgeDataT &object) const
+    {
+        Coordinate projected_u{web_mercator::fromWGS84(Coordinate{m_coordinate_list[object.u]})};
+        Coordinate projected_v{web_mercator::fromWGS84(Coordinate{m_coordinate_list[object.v]})};
+
+        BOOST_ASSERT(std::abs(toFloating(projected_u.lon).operator double()) <= 180.);
+        BOOST_ASSERT(std::abs(toFloating(projected_u.lat).operator double()) <= 180.);
+        BOOST_ASSERT(std::abs(toFloating(projected_v.lon).operator double()) <= 180.);
+        BOOST_ASSERT(std::abs(toFloating(projected_v.lat).operator double()) <= 180.);
+
+        Rectangle rectangle;
+        rectangle.min_lon = std::min(rectangle.min_lon, std::min(projected_u.lon, projected_v.lon));
+        rectangle.max_lon = std::max(rectangle.max_lon, std::max(projected_u.lon, projected_v.lon));
+
+        rectangle.min_lat = std::min(rectangle.min_lat, std::min(projected_u.lat, projected_v.lat));
+        rectangle.max_lat = std::max(rectangle.max_lat, std::max(projected_u.lat, projected_v.lat));
+
+        BOOST_ASSERT(rectangle.IsValid());
+        return rectangle;
+    }
+
   public:
     StaticRTree(const StaticRTree &) = delete;
     StaticRTree &operator=(const StaticRTree &) = delete;
@@ -302,122 +324,19 @@ class StaticRTree
 
         // sort the hilbert-value representatives
         tbb::parallel_sort(input_wrapper_vector.begin(), input_wrapper_vector.end());
-        {
-            storage::io::FileWriter leaf_node_file(leaf_node_filename,
-                                                   storage::io::FileWriter::HasNoFingerprint);
-            // Note, we can't just write everything in one go, because the input_data_vector
-            // is not sorted by hilbert code, only the input_wrapper_vector is in the correct
-            // order.  Instead, we iterate over input_wrapper_vector, copy the hilbert-indexed
-            // entries from input_data_vector into a temporary contiguous array, then write
-            // that array to disk.
-
-            // Create the first level of TreeNodes - each bounding LEAF_NODE_COUNT EdgeDataT
-            // objects.
-            std::size_t wrapped_element_index = 0;
-            while (wrapped_element_index < element_count)
-            {
-                TreeNode current_node;
-
-                std::array<EdgeDataT, LEAF_NODE_SIZE> objects;
-                std::uint32_t object_count = 0;
-
-                // Loop over the next block of EdgeDataT, calculate the bounding box
-                // for the block, and save the data to write to disk in the correct
-                // order.
-                for (std::uint32_t object_index = 0;
-                     object_index < LEAF_NODE_SIZE && wrapped_element_index < element_count;
-                     ++object_index, ++wrapped_element_index)
-                {
-                    const std::uint32_t input_object_index =
-                        input_wrapper_vector[wrapped_element_index].m_original_index;
-                    const EdgeDataT &object = input_data_vector[input_object_index];
-
-                    object_count += 1;
-                    objects[object_index] = object;
-
-                    Coordinate projected_u{
-                        web_mercator::fromWGS84(Coordinate{m_coordinate_list[object.u]})};
-                    Coordinate projected_v{
-                        web_mercator::fromWGS84(Coordinate{m_coordinate_list[object.v]})};
-
-                    BOOST_ASSERT(std::abs(toFloating(projected_u.lon).operator double()) <= 180.);
-                    BOOST_ASSERT(std::abs(toFloating(projected_u.lat).operator double()) <= 180.);
-                    BOOST_ASSERT(std::abs(toFloating(projected_v.lon).operator double()) <= 180.);
-                    BOOST_ASSERT(std::abs(toFloating(projected_v.lat).operator double()) <= 180.);
-
-                    Rectangle rectangle;
-                    rectangle.min_lon =
-                        std::min(rectangle.min_lon, std::min(projected_u.lon, projected_v.lon));
-                    rectangle.max_lon =
-                        std::max(rectangle.max_lon, std::max(projected_u.lon, projected_v.lon));
-
-                    rectangle.min_lat =
-                        std::min(rectangle.min_lat, std::min(projected_u.lat, projected_v.lat));
-                    rectangle.max_lat =
-                        std::max(rectangle.max_lat, std::max(projected_u.lat, projected_v.lat));
-
-                    BOOST_ASSERT(rectangle.IsValid());
-                    current_node.minimum_bounding_rectangle.MergeBoundingBoxes(rectangle);
-                }
-
-                // Write out our EdgeDataT block to the leaf node file
-                leaf_node_file.WriteFrom(objects.data(), object_count);
-
-                m_search_tree.emplace_back(current_node);
-            }
-
-            // leaf_node_file wil be RAII closed at this point
-        }
-
-        // Should hold the number of nodes at the lowest level of the graph (closest
-        // to the data)
-        std::uint32_t nodes_in_previous_level = m_search_tree.size();
-        m_tree_level_sizes.push_back(nodes_in_previous_level);
 
-        // Now, repeatedly create levels of nodes that contain BRANCHING_FACTOR
-        // nodes from the previous level.
-        while (nodes_in_previous_level > 1)
+        // Step 2 - compute the number of TreeNodes in each level. A level has one node for each
+        // BRANCHING_FACTOR nodes of the level below, rounded up. The leaf level has one node for
+        // each LEAF_NODE_SIZE objects.
+        const std::uint64_t number_of_leaves =
+            (element_count + LEAF_NODE_SIZE - 1) / LEAF_NODE_SIZE;
+        m_tree_level_sizes = {number_of_leaves};
+        while (m_tree_level_sizes.back() > 1)
         {
-            auto previous_level_start_pos = m_search_tree.size() - nodes_in_previous_level;
-
-            // We can calculate how many nodes will be in this level, we divide by
-            // BRANCHING_FACTOR
-            // and round up
-            std::uint32_t nodes_in_current_level =
-                std::ceil(static_cast<double>(nodes_in_previous_level) / BRANCHING_FACTOR);
-
-            for (auto current_node_idx : irange<std::size_t>(0, nodes_in_current_level))
-            {
-                TreeNode parent_node;
-                auto first_child_index =
-                    current_node_idx * BRANCHING_FACTOR + previous_level_start_pos;
-                auto last_child_index =
-                    first_child_index +
-                    std::min<std::size_t>(BRANCHING_FACTOR,
-                                          nodes_in_previous_level -
-                                              current_node_idx * BRANCHING_FACTOR);
-
-                // Calculate the bounding box for BRANCHING_FACTOR nodes in the previous
-                // level, then save that box as a new TreeNode in the new level.
-                for (auto child_node_idx : irange<std::size_t>(first_child_index, last_child_index))
-                {
-                    parent_node.minimum_bounding_rectangle.MergeBoundingBoxes(
-                        m_search_tree[child_node_idx].minimum_bounding_rectangle);
-                }
-                m_search_tree.emplace_back(parent_node);
-            }
-            nodes_in_previous_level = nodes_in_current_level;
-            m_tree_level_sizes.push_back(nodes_in_previous_level);
+            m_tree_level_sizes.push_back(
+                (m_tree_level_sizes.back() + BRANCHING_FACTOR - 1) / BRANCHING_FACTOR);
         }
-        // At this point, we've got our tree built, but the nodes are in a weird order.
-        // Next thing we'll do is flip it around so that we don't end up with a lot of
-        // `size - n` math later on.
-
-        // Flip the tree so that the root node is at 0.
-        // This just makes our math during search a bit more intuitive
-        std::reverse(m_search_tree.begin(), m_search_tree.end());
-
-        // Same for the level sizes - root node / base level is at 0
+        // the root node is at level 0
         std::reverse(m_tree_level_sizes.begin(), m_tree_level_sizes.end());
 
         // The first level starts at 0
@@ -427,20 +346,95 @@ class StaticRTree
                          m_tree_level_sizes.end() - 1,
                          std::back_inserter(m_tree_level_starts));
 
-        // Now we have to flip the coordinates within each level so that math is easier
-        // later on.  The workflow here is:
-        // The initial order of tree nodes in the m_search_tree array is roughly:
-        // 6789 345 12 0   (each block here is a level of the tree)
-        // Then we reverse it and get:
-        // 0 21 543 9876
-        // Now the loop below reverses each level to give us the final result
-        // 0 12 345 6789
-        // This ordering keeps the position math easy to understand during later
-        // searches
-        for (auto i : irange<std::size_t>(0, m_tree_level_sizes.size()))
+        // All nodes are written to their final position, so the levels can be built in parallel
+        m_search_tree.resize(m_tree_level_starts.back() + m_tree_level_sizes.back());
+
+        // Step 3 - create the leaf level. The leaves are packed in parallel into chunks of
+        // consecutive objects in Hilbert order. A chunk is written to the .fileIndex with a single
+        // write while the next chunk is packed.
         {
-            std::reverse(m_search_tree.begin() + m_tree_level_starts[i],
-                         m_search_tree.begin() + m_tree_level_starts[i] + m_tree_level_sizes[i]);
+            storage::io::FileWriter leaf_node_file(leaf_node_filename,
+                                                   storage::io::FileWriter::HasNoFingerprint);
+
+            const auto leaf_level_start = m_tree_level_starts.back();
+            const std::uint64_t chunk_size = LEAF_CHUNK_SIZE * LEAF_NODE_SIZE;
+            std::array<std::vector<EdgeDataT>, 2> chunks;
+            std::future<void> pending_write;
+
+            for (std::uint64_t chunk_begin = 0, chunk_index = 0; chunk_begin < element_count;
+                 chunk_begin += chunk_size, ++chunk_index)
+            {
+                const auto chunk_end =
+                    std::min<std::uint64_t>(chunk_begin + chunk_size, element_count);
+                // the buffer of the chunk before the last one can be reused, its write is done
+                auto &chunk = chunks[chunk_index % 2];
+                chunk.resize(chunk_end - chunk_begin);
+
+                const auto first_leaf = chunk_begin / LEAF_NODE_SIZE;
+                const auto last_leaf = (chunk_end + LEAF_NODE_SIZE - 1) / LEAF_NODE_SIZE;
+                tbb::parallel_for(
+                    tbb::blocked_range<std::uint64_t>(first_leaf, last_leaf),
+                    [&](const tbb::blocked_range<std::uint64_t> &range) {
+                        for (auto leaf = range.begin(); leaf != range.end(); ++leaf)
+                        {
+                            const auto objects_begin = leaf * LEAF_NODE_SIZE;
+                            const auto objects_end =
+                                std::min<std::uint64_t>(objects_begin + LEAF_NODE_SIZE, chunk_end);
+
+                            TreeNode current_node;
+                            for (auto index = objects_begin; index != objects_end; ++index)
+                            {
+                                const EdgeDataT &object =
+                                    input_data_vector[input_wrapper_vector[index]
+                                                          .m_original_index];
+                                chunk[index - chunk_begin] = object;
+                                current_node.minimum_bounding_rectangle.MergeBoundingBoxes(
+                                    GetProjectedRectangle(object));
+                            }
+                            m_search_tree[leaf_level_start + leaf] = current_node;
+                        }
+                    });
+
+                if (pending_write.valid())
+                    pending_write.get();
+                pending_write = std::async(std::launch::async, [&leaf_node_file, &chunk] {
+                    leaf_node_file.WriteFrom(chunk.data(), chunk.size());
+                });
+            }
+
+            if (pending_write.valid())
+                pending_write.get();
+
+            // leaf_node_file wil be RAII closed at this point
+        }
+
+        // Step 4 - create the upper levels from the leaves upwards. Each node holds the bounding
+        // box of BRANCHING_FACTOR nodes of the level below, the nodes of a level are independent.
+        for (std::size_t level = m_tree_level_sizes.size() - 1; level > 0; --level)
+        {
+            const auto child_level_start = m_tree_level_starts[level];
+            const auto child_level_size = m_tree_level_sizes[level];
+            const auto parent_level_start = m_tree_level_starts[level - 1];
+
+            tbb::parallel_for(
+                tbb::blocked_range<std::uint64_t>(0, m_tree_level_sizes[level - 1]),
+                [&](const tbb::blocked_range<std::uint64_t> &range) {
+                    for (auto parent = range.begin(); parent != range.end(); ++parent)
+                    {
+                        const auto first_child = parent * BRANCHING_FACTOR;
+                        const auto last_child = std::min<std::uint64_t>(
+                            first_child + BRANCHING_FACTOR, child_level_size);
+
+                        TreeNode parent_node;
+                        for (auto child = first_child; child != last_child; ++child)
+                        {
+                            parent_node.minimum_bounding_rectangle.MergeBoundingBoxes(
+                                m_search_tree[child_level_start + child]
+                                    .minimum_bounding_rectangle);
+                        }
+                        m_search_tree[parent_level_start + parent] = parent_node;
+                    }
+                });
         }
 
         // Write all the TreeNode data to disk
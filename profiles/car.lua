@@ -414,3 +414,10 @@ function turn_function (turn)
       end
   end
 end
+
+-- called once per intersection instead of calling turn_function for every turn
+function turn_batch_function (turns)
+  for _, turn in ipairs(turns) do
+    turn_function(turn)
+  end
+end
@@ -0,0 +1,211 @@
+#include "contractor/graph_contractor.hpp"
+#include "contractor/graph_contractor_adaptors.hpp"
+#include "contractor/query_graph.hpp"
+#include "contractor/renumber.hpp"
+
+#include "extractor/edge_based_edge.hpp"
+
+#include "util/deallocating_vector.hpp"
+#include "util/integer_range.hpp"
+#include "util/log.hpp"
+#include "util/query_heap.hpp"
+#include "util/timing_util.hpp"
+#include "util/typedefs.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace osrm;
+
+// Compares the query times on a contracted grid graph with the nodes in the order of the input
+// and in the order of contractor::makePermutation.
+
+namespace
+{
+
+struct HeapData
+{
+    NodeID parent;
+};
+using Heap =
+    util::QueryHeap<NodeID, NodeID, EdgeWeight, HeapData, util::ArrayStorage<NodeID, NodeID>>;
+
+constexpr unsigned RANDOM_SEED = 13;
+
+// a grid with edges in both directions between neighboring nodes, numbered row by row
+std::vector<extractor::EdgeBasedEdge> makeGrid(const NodeID rows, const NodeID columns)
+{
+    std::mt19937 generator(RANDOM_SEED);
+    std::uniform_int_distribution<EdgeWeight> weight(10, 100);
+
+    std::vector<extractor::EdgeBasedEdge> edges;
+    const auto add_edge = [&](const NodeID source, const NodeID target) {
+        const auto forward_weight = weight(generator);
+        const auto backward_weight = weight(generator);
+        const NodeID turn_id = edges.size();
+        edges.emplace_back(
+            source, target, turn_id, forward_weight, forward_weight, true, false);
+        edges.emplace_back(
+            target, source, turn_id + 1, backward_weight, backward_weight, true, false);
+    };
+
+    for (const auto row : util::irange<NodeID>(0, rows))
+    {
+        for (const auto column : util::irange<NodeID>(0, columns))
+        {
+            const auto node = row * columns + column;
+            if (column + 1 < columns)
+                add_edge(node, node + 1);
+            if (row + 1 < rows)
+                add_edge(node, node + columns);
+        }
+    }
+
+    return edges;
+}
+
+// a plain bidirectional search on the upward graph, without stall-on-demand
+EdgeWeight query(const contractor::QueryGraph &graph,
+                 Heap &forward_heap,
+                 Heap &reverse_heap,
+                 const NodeID source,
+                 const NodeID target)
+{
+    forward_heap.Clear();
+    reverse_heap.Clear();
+    forward_heap.Insert(source, 0, {source});
+    reverse_heap.Insert(target, 0, {target});
+
+    EdgeWeight best = INVALID_EDGE_WEIGHT;
+    const auto step = [&](Heap &heap, const Heap &other_heap, const bool forward) {
+        const auto node = heap.DeleteMin();
+        const auto weight = heap.GetKey(node);
+        if (other_heap.WasInserted(node))
+            best = std::min(best, weight + other_heap.GetKey(node));
+
+        for (const auto edge : graph.GetAdjacentEdgeRange(node))
+        {
+            const auto &data = graph.GetEdgeData(edge);
+            if (forward ? !data.forward : !data.backward)
+                continue;
+
+            const auto to = graph.GetTarget(edge);
+            const auto to_weight = weight + data.weight;
+            if (!heap.WasInserted(to))
+                heap.Insert(to, to_weight, {node});
+            else if (to_weight < heap.GetKey(to))
+            {
+                heap.GetData(to).parent = node;
+                heap.DecreaseKey(to, to_weight);
+            }
+        }
+    };
+
+    while (!forward_heap.Empty() || !reverse_heap.Empty())
+    {
+        if (!forward_heap.Empty())
+        {
+            if (forward_heap.MinKey() >= best)
+                forward_heap.DeleteAll();
+            else
+                step(forward_heap, reverse_heap, true);
+        }
+        if (!reverse_heap.Empty())
+        {
+            if (reverse_heap.MinKey() >= best)
+                reverse_heap.DeleteAll();
+            else
+                step(reverse_heap, forward_heap, false);
+        }
+    }
+
+    return best;
+}
+
+auto makeQueryGraph(const NodeID number_of_nodes,
+                    util::DeallocatingVector<contractor::QueryEdge> edges)
+{
+    std::sort(edges.begin(), edges.end());
+    return contractor::QueryGraph{number_of_nodes, edges};
+}
+
+double measure(const contractor::QueryGraph &graph,
+               const std::vector<std::pair<NodeID, NodeID>> &queries,
+               std::vector<EdgeWeight> &weights)
+{
+    Heap forward_heap(graph.GetNumberOfNodes());
+    Heap reverse_heap(graph.GetNumberOfNodes());
+
+    weights.clear();
+    TIMER_START(queries);
+    for (const auto &source_target : queries)
+        weights.push_back(
+            query(graph, forward_heap, reverse_heap, source_target.first, source_target.second));
+    TIMER_STOP(queries);
+
+    return TIMER_MSEC(queries);
+}
+}
+
+int main(int argc, char **argv)
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    const NodeID size = argc > 1 ? std::atoi(argv[1]) : 300;
+    const std::size_t num_queries = argc > 2 ? std::atoi(argv[2]) : 10000;
+    const NodeID number_of_nodes = size * size;
+
+    util::DeallocatingVector<contractor::QueryEdge> edges;
+    std::vector<bool> is_core_node;
+    {
+        contractor::GraphContractor graph_contractor(
+            number_of_nodes,
+            contractor::adaptToContractorInput(makeGrid(size, size)),
+            {},
+            std::vector<EdgeWeight>(number_of_nodes, 0));
+        graph_contractor.Run();
+        graph_contractor.GetEdges(edges);
+        graph_contractor.GetCoreMarker(is_core_node);
+    }
+
+    const auto permutation = contractor::makePermutation(number_of_nodes, edges, is_core_node);
+    util::DeallocatingVector<contractor::QueryEdge> renumbered_edges;
+    for (const auto &edge : edges)
+        renumbered_edges.push_back(edge);
+    contractor::renumber(renumbered_edges, permutation);
+
+    const auto input_graph = makeQueryGraph(number_of_nodes, std::move(edges));
+    const auto renumbered_graph = makeQueryGraph(number_of_nodes, std::move(renumbered_edges));
+
+    std::mt19937 generator(RANDOM_SEED);
+    std::uniform_int_distribution<NodeID> node(0, number_of_nodes - 1);
+    std::vector<std::pair<NodeID, NodeID>> queries;
+    std::vector<std::pair<NodeID, NodeID>> renumbered_queries;
+    for (std::size_t index = 0; index < num_queries; ++index)
+    {
+        const auto source = node(generator);
+        const auto target = node(generator);
+        queries.emplace_back(source, target);
+        renumbered_queries.emplace_back(permutation[source], permutation[target]);
+    }
+
+    std::vector<EdgeWeight> input_weights;
+    std::vector<EdgeWeight> renumbered_weights;
+    const auto input_ms = measure(input_graph, queries, input_weights);
+    const auto renumbered_ms = measure(renumbered_graph, renumbered_queries, renumbered_weights);
+
+    if (input_weights != renumbered_weights)
+    {
+        util::Log(logERROR) << "Queries on the renumbered graph return different weights";
+        return EXIT_FAILURE;
+    }
+
+    util::Log() << num_queries << " queries on a " << size << "x" << size
+                << " grid: input order " << input_ms << " ms, renumbered " << renumbered_ms
+                << " ms. " << input_ms / renumbered_ms;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,99 @@
+#include "engine/hint.hpp"
+#include "util/timing_util.hpp"
+
+#include "osrm/route_parameters.hpp"
+
+#include "osrm/coordinate.hpp"
+#include "osrm/engine_config.hpp"
+#include "osrm/json_container.hpp"
+
+#include "osrm/osrm.hpp"
+#include "osrm/status.hpp"
+
+#include <boost/assert.hpp>
+
+#include <exception>
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include <cstdlib>
+
+int main(int argc, const char *argv[]) try
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " data.osrm\n";
+        return EXIT_FAILURE;
+    }
+
+    using namespace osrm;
+
+    // Configure based on a .osrm base path, and no datasets in shared mem from osrm-datastore
+    EngineConfig config;
+    config.storage_config = {argv[1]};
+    config.use_shared_memory = false;
+
+    OSRM osrm{config};
+
+    // Route in monaco between the same two depots over and over again
+    RouteParameters params;
+    params.overview = RouteParameters::OverviewType::False;
+    params.steps = false;
+
+    using osrm::util::FloatCoordinate;
+    using osrm::util::FloatLatitude;
+    using osrm::util::FloatLongitude;
+
+    params.coordinates.push_back(
+        FloatCoordinate{FloatLongitude{7.419758}, FloatLatitude{43.731142}});
+    params.coordinates.push_back(
+        FloatCoordinate{FloatLongitude{7.419505}, FloatLatitude{43.736825}});
+
+    const auto run_benchmark = [&](const std::string &name) {
+        TIMER_START(routes);
+        auto NUM = 1000;
+        for (int i = 0; i < NUM; ++i)
+        {
+            json::Object result;
+            const auto rc = osrm.Route(params, result);
+            if (rc != Status::Ok)
+            {
+                return false;
+            }
+        }
+        TIMER_STOP(routes);
+        std::cout << name << ": " << (TIMER_MSEC(routes) / NUM) << "ms/req" << std::endl;
+        return true;
+    };
+
+    if (!run_benchmark("snapping"))
+    {
+        return EXIT_FAILURE;
+    }
+
+    // reuse the compact hints of the first response for all following requests
+    json::Object result;
+    if (osrm.Route(params, result) != Status::Ok)
+    {
+        return EXIT_FAILURE;
+    }
+    for (const auto &waypoint : result.values.at("waypoints").get<json::Array>().values)
+    {
+        const auto &hint = waypoint.get<json::Object>().values.at("hint").get<json::String>().value;
+        BOOST_ASSERT(hint.size() == engine::ENCODED_COMPACT_HINT_SIZE);
+        params.hints.push_back(engine::Hint::FromBase64(hint));
+    }
+
+    if (!run_benchmark("compact hints"))
+    {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
@@ -5,12 +5,14 @@
 #include "storage/io.hpp"
 #include "engine/geospatial_query.hpp"
 #include "util/coordinate.hpp"
+#include "util/mmap_file.hpp"
 #include "util/serialization.hpp"
 #include "util/timing_util.hpp"
 
 #include <iostream>
 #include <random>
 
+#include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
 
 namespace osrm
@@ -62,6 +64,35 @@ void benchmarkQuery(const std::vector<util::Coordinate> &queries,
               << ")" << std::endl;
 }
 
+// Rebuilds the r-tree from the segments of a .fileIndex into temporary files
+void benchmarkConstruction(const boost::filesystem::path &leaf_file,
+                           const std::vector<util::Coordinate> &coords)
+{
+    std::vector<RTreeLeaf> segments;
+    {
+        boost::iostreams::mapped_file_source region;
+        const auto segments_view = util::mmapFile<RTreeLeaf>(leaf_file, region);
+        segments.assign(segments_view.begin(), segments_view.end());
+    }
+
+    const auto temporary_directory = boost::filesystem::temp_directory_path();
+    const auto nodes_path = temporary_directory / boost::filesystem::unique_path();
+    const auto leaves_path = temporary_directory / boost::filesystem::unique_path();
+
+    std::cout << "Constructing RTree with " << segments.size() << " segments: " << std::flush;
+
+    TIMER_START(construction);
+    {
+        BenchStaticRTree constructed(segments, nodes_path.string(), leaves_path.string(), coords);
+    }
+    TIMER_STOP(construction);
+
+    std::cout << "Took " << TIMER_SEC(construction) << " seconds" << std::endl;
+
+    boost::filesystem::remove(nodes_path);
+    boost::filesystem::remove(leaves_path);
+}
+
 void benchmark(BenchStaticRTree &rtree, unsigned num_queries)
 {
     std::mt19937 mt_rand(RANDOM_SEED);
@@ -101,6 +132,7 @@ int main(int argc, char **argv)
 
     osrm::benchmarks::BenchStaticRTree rtree(ram_path, file_path, coords);
 
+    osrm::benchmarks::benchmarkConstruction(file_path, coords);
     osrm::benchmarks::benchmark(rtree, 10000);
 
     return 0;
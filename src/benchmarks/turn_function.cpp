@@ -0,0 +1,115 @@
+#include "extractor/extraction_turn.hpp"
+#include "extractor/guidance/intersection.hpp"
+#include "extractor/scripting_environment_lua.hpp"
+
+#include "util/exception.hpp"
+#include "util/log.hpp"
+#include "util/timing_util.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace osrm;
+using namespace osrm::extractor;
+
+namespace
+{
+// Intersections with the number of turns typically found in a road network
+std::vector<std::vector<ExtractionTurn>> generateIntersections(const std::size_t num_turns)
+{
+    std::mt19937 generator(1337);
+    std::uniform_real_distribution<double> angle(0., 360.);
+    std::uniform_int_distribution<int> turns_per_intersection(1, 4);
+    std::bernoulli_distribution traffic_light(0.05);
+
+    std::vector<std::vector<ExtractionTurn>> intersections;
+    std::size_t generated_turns = 0;
+    while (generated_turns < num_turns)
+    {
+        std::vector<ExtractionTurn> turns;
+        const bool has_traffic_light = traffic_light(generator);
+        for (auto num_turns_left = turns_per_intersection(generator); num_turns_left > 0;
+             --num_turns_left)
+        {
+            const guidance::ConnectedRoad road(
+                guidance::IntersectionViewData({0, angle(generator), 10.}, true, angle(generator)),
+                {guidance::TurnType::Turn, guidance::DirectionModifier::Right},
+                INVALID_LANE_DATAID);
+            turns.emplace_back(road, has_traffic_light);
+        }
+        generated_turns += turns.size();
+        intersections.push_back(std::move(turns));
+    }
+    return intersections;
+}
+}
+
+int main(int argc, char **argv) try
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " profile.lua [number of turns]\n";
+        return EXIT_FAILURE;
+    }
+
+    const boost::filesystem::path profile_path(argv[1]);
+    if (!boost::filesystem::exists(profile_path))
+    {
+        throw util::exception("Profile " + profile_path.string() + " not found!");
+    }
+    const std::size_t num_turns = argc > 2 ? std::stoul(argv[2]) : 1000000;
+
+    Sol2ScriptingEnvironment scripting_environment(profile_path.string());
+    auto intersections = generateIntersections(num_turns);
+
+    const auto print_rate = [](const std::string &name, const std::size_t turns, double ms) {
+        util::Log() << name << ": " << std::fixed << std::setprecision(0)
+                    << (turns / (ms / 1000.)) << " turns/s (" << std::setprecision(2) << ms
+                    << " ms)";
+    };
+
+    std::size_t total_turns = 0;
+    TIMER_START(single);
+    for (auto &turns : intersections)
+    {
+        for (auto &turn : turns)
+        {
+            scripting_environment.ProcessTurn(turn);
+        }
+        total_turns += turns.size();
+    }
+    TIMER_STOP(single);
+    print_rate("turn_function per turn", total_turns, TIMER_MSEC(single));
+
+    // start again from turns that have not been processed yet
+    intersections = generateIntersections(num_turns);
+
+    TIMER_START(batched);
+    for (auto &turns : intersections)
+    {
+        scripting_environment.ProcessTurns(turns);
+    }
+    TIMER_STOP(batched);
+    print_rate("turns per intersection", total_turns, TIMER_MSEC(batched));
+
+    if (!scripting_environment.GetSol2Context().has_turn_batch_function)
+    {
+        util::Log(logWARNING) << "Profile has no turn_batch_function, turns were processed "
+                                 "one at a time in both runs";
+    }
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    util::Log(logERROR) << "Error: " << e.what();
+    return EXIT_FAILURE;
+}
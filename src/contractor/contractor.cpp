@@ -3,9 +3,11 @@
 #include "contractor/files.hpp"
 #include "contractor/graph_contractor.hpp"
 #include "contractor/graph_contractor_adaptors.hpp"
+#include "contractor/renumber.hpp"
 
 #include "extractor/compressed_edge_container.hpp"
 #include "extractor/edge_based_graph_factory.hpp"
+#include "extractor/files.hpp"
 #include "extractor/node_based_edge.hpp"
 
 #include "storage/io.hpp"
@@ -17,6 +19,7 @@
 #include "util/graph_loader.hpp"
 #include "util/integer_range.hpp"
 #include "util/log.hpp"
+#include "util/mmap_file.hpp"
 #include "util/static_graph.hpp"
 #include "util/string_util.hpp"
 #include "util/timing_util.hpp"
@@ -28,13 +31,23 @@
 #include <fstream>
 #include <iterator>
 #include <memory>
+#include <string>
 #include <vector>
 
+#include <boost/filesystem/operations.hpp>
+
 namespace osrm
 {
 namespace contractor
 {
 
+namespace
+{
+// Renumbered files are written next to the original file and replace it only once all files are
+// written. An interrupted run leaves all files in the old numbering.
+std::string stagedPath(const std::string &path) { return path + ".renumbered"; }
+}
+
 int Contractor::Run()
 {
     if (config.core_factor > 1.0 || config.core_factor < 0)
@@ -68,6 +81,13 @@ int Contractor::Run()
     if (config.use_cached_priority)
     {
         files::readLevels(config.level_output_path, node_levels);
+        if (node_levels.size() != max_edge_id + 1)
+        {
+            throw util::exception("The .level file has " + std::to_string(node_levels.size()) +
+                                  " nodes but the graph has " + std::to_string(max_edge_id + 1) +
+                                  ", re-run osrm-contract without --level-cache" + SOURCE_REF);
+        }
+        util::Log() << "Re-contracting in the node order of " << config.level_output_path;
     }
 
     util::DeallocatingVector<QueryEdge> contracted_edge_list;
@@ -75,7 +95,8 @@ int Contractor::Run()
         GraphContractor graph_contractor(max_edge_id + 1,
                                          adaptToContractorInput(std::move(edge_based_edge_list)),
                                          std::move(node_levels),
-                                         std::move(node_weights));
+                                         std::move(node_weights),
+                                         {config.witness_search_nodes, config.witness_search_hops});
         graph_contractor.Run(config.core_factor);
         graph_contractor.GetEdges(contracted_edge_list);
         graph_contractor.GetCoreMarker(is_core_node);
@@ -85,13 +106,52 @@ int Contractor::Run()
 
     util::Log() << "Contraction took " << TIMER_SEC(contraction) << " sec";
 
-    WriteContractedGraph(max_edge_id, std::move(contracted_edge_list));
-    WriteCoreNodeMarker(std::move(is_core_node));
-    if (!config.use_cached_priority)
+    std::vector<std::string> renumbered_paths;
+    if (config.renumber_nodes && boost::filesystem::exists(config.partition_path))
     {
-        std::vector<float> out_node_levels(std::move(node_levels));
+        util::Log() << "Found existing .osrm.partition file, keeping the node order of "
+                       "osrm-partition.";
+    }
+    else if (config.renumber_nodes)
+    {
+        TIMER_START(renumber);
+        const auto permutation =
+            makePermutation(max_edge_id + 1, contracted_edge_list, is_core_node);
+        renumber(contracted_edge_list, permutation);
+        renumber(is_core_node, permutation);
+        // the contractor consumes the cached levels, they are renumbered in the file
+        if (config.use_cached_priority)
+            files::readLevels(config.level_output_path, node_levels);
+        renumber(node_levels, permutation);
+        renumbered_paths = RenumberEdgeBasedNodes(permutation);
+        TIMER_STOP(renumber);
+        util::Log() << "Renumbered data in " << TIMER_SEC(renumber) << " seconds";
+    }
 
-        files::writeLevels(config.level_output_path, node_levels);
+    const bool renumbered = !renumbered_paths.empty();
+    const auto output_path = [&](const std::string &path) {
+        return renumbered ? stagedPath(path) : path;
+    };
+
+    WriteContractedGraph(
+        output_path(config.graph_output_path), max_edge_id, std::move(contracted_edge_list));
+    WriteCoreNodeMarker(output_path(config.core_output_path), std::move(is_core_node));
+    // the cached levels need to follow the new numbering of the edge-based graph
+    if (!config.use_cached_priority || renumbered)
+    {
+        files::writeLevels(output_path(config.level_output_path), node_levels);
+    }
+
+    if (renumbered)
+    {
+        // the .fileIndex is the last of the renumbered files and replaced last
+        renumbered_paths.insert(
+            renumbered_paths.begin(),
+            {config.graph_output_path, config.core_output_path, config.level_output_path});
+        for (const auto &path : renumbered_paths)
+        {
+            boost::filesystem::rename(stagedPath(path), path);
+        }
     }
 
     TIMER_STOP(preparing);
@@ -103,7 +163,66 @@ int Contractor::Run()
     return 0;
 }
 
-void Contractor::WriteCoreNodeMarker(std::vector<bool> &&in_is_core_node) const
+std::vector<std::string>
+Contractor::RenumberEdgeBasedNodes(const std::vector<std::uint32_t> &permutation) const
+{
+    std::vector<std::string> renumbered_paths;
+    {
+        // the edges in memory contain the updated weights, the file keeps the original ones
+        const auto &path = config.updater_config.edge_based_graph_path;
+        EdgeID max_edge_id;
+        std::vector<extractor::EdgeBasedEdge> edge_based_edge_list;
+        extractor::files::readEdgeBasedGraph(path, max_edge_id, edge_based_edge_list);
+        renumber(edge_based_edge_list, permutation);
+        extractor::files::writeEdgeBasedGraph(stagedPath(path), max_edge_id, edge_based_edge_list);
+        renumbered_paths.push_back(path);
+    }
+    {
+        const auto &path = config.node_file_path;
+        std::vector<EdgeWeight> node_weights;
+        {
+            storage::io::FileReader reader(path, storage::io::FileReader::VerifyFingerprint);
+            storage::serialization::read(reader, node_weights);
+        }
+        renumber(node_weights, permutation);
+        storage::io::FileWriter writer(stagedPath(path),
+                                       storage::io::FileWriter::GenerateFingerprint);
+        storage::serialization::write(writer, node_weights);
+        renumbered_paths.push_back(path);
+    }
+    {
+        const auto &path = config.updater_config.edge_based_nodes_data_path;
+        extractor::EdgeBasedNodeDataContainer node_data;
+        extractor::files::readNodeData(path, node_data);
+        node_data.Renumber(permutation);
+        extractor::files::writeNodeData(stagedPath(path), node_data);
+        renumbered_paths.push_back(path);
+    }
+    if (boost::filesystem::exists(config.cnbg_ebg_mapping_path))
+    {
+        const auto &path = config.cnbg_ebg_mapping_path;
+        std::vector<extractor::NBGToEBG> mapping;
+        extractor::files::readNBGMapping(path, mapping);
+        renumber(mapping, permutation);
+        extractor::files::writeNBGMapping(stagedPath(path), mapping);
+        renumbered_paths.push_back(path);
+    }
+    {
+        // the leaves are renumbered in a mapped copy of the file
+        const auto &path = config.updater_config.rtree_leaf_path;
+        boost::filesystem::copy_file(
+            path, stagedPath(path), boost::filesystem::copy_option::overwrite_if_exists);
+        boost::iostreams::mapped_file segment_region;
+        auto segments =
+            util::mmapFile<extractor::EdgeBasedNodeSegment>(stagedPath(path), segment_region);
+        renumber(segments, permutation);
+        renumbered_paths.push_back(path);
+    }
+    return renumbered_paths;
+}
+
+void Contractor::WriteCoreNodeMarker(const std::string &path,
+                                     std::vector<bool> &&in_is_core_node) const
 {
     std::vector<bool> is_core_node(std::move(in_is_core_node));
     std::vector<char> unpacked_bool_flags(std::move(is_core_node.size()));
@@ -112,7 +231,7 @@ void Contractor::WriteCoreNodeMarker(std::vector<bool> &&in_is_core_node) const
         unpacked_bool_flags[i] = is_core_node[i] ? 1 : 0;
     }
 
-    storage::io::FileWriter core_marker_output_file(config.core_output_path,
+    storage::io::FileWriter core_marker_output_file(path,
                                                     storage::io::FileWriter::GenerateFingerprint);
 
     const std::size_t count = unpacked_bool_flags.size();
@@ -120,7 +239,8 @@ void Contractor::WriteCoreNodeMarker(std::vector<bool> &&in_is_core_node) const
     core_marker_output_file.WriteFrom(unpacked_bool_flags.data(), count);
 }
 
-void Contractor::WriteContractedGraph(unsigned max_node_id,
+void Contractor::WriteContractedGraph(const std::string &path,
+                                      unsigned max_node_id,
                                       util::DeallocatingVector<QueryEdge> contracted_edge_list)
 {
     // Sorting contracted edges in a way that the static query graph can read some in in-place.
@@ -133,7 +253,7 @@ void Contractor::WriteContractedGraph(unsigned max_node_id,
 
     QueryGraph query_graph{max_node_id + 1, contracted_edge_list};
 
-    files::writeGraph(config.graph_output_path, checksum, query_graph);
+    files::writeGraph(path, checksum, query_graph);
 }
 
 } // namespace contractor
@@ -1,5 +1,8 @@
 #include "contractor/contractor_dijkstra.hpp"
 
+#include <algorithm>
+#include <chrono>
+
 namespace osrm
 {
 namespace contractor
@@ -9,10 +12,14 @@ ContractorDijkstra::ContractorDijkstra(const std::size_t heap_size) : heap(heap_
 
 void ContractorDijkstra::Run(const unsigned number_of_targets,
                              const int node_limit,
+                             const unsigned hop_limit,
                              const EdgeWeight weight_limit,
                              const NodeID forbidden_node,
                              const ContractorGraph &graph)
 {
+    const auto start = std::chrono::steady_clock::now();
+    ++stats.searches;
+
     int nodes = 0;
     unsigned number_of_targets_found = 0;
     while (!heap.Empty())
@@ -21,11 +28,12 @@ void ContractorDijkstra::Run(const unsigned number_of_targets,
         const auto node_weight = heap.GetKey(node);
         if (++nodes > node_limit)
         {
-            return;
+            ++stats.stopped_at_node_limit;
+            break;
         }
         if (node_weight > weight_limit)
         {
-            return;
+            break;
         }
 
         // Destination settled?
@@ -34,12 +42,23 @@ void ContractorDijkstra::Run(const unsigned number_of_targets,
             ++number_of_targets_found;
             if (number_of_targets_found >= number_of_targets)
             {
-                return;
+                break;
             }
         }
 
+        // paths with more edges are not used as witnesses
+        if (hop_limit > 0 && static_cast<unsigned>(heap.GetData(node).hop) >= hop_limit)
+        {
+            ++stats.pruned_at_hop_limit;
+            continue;
+        }
+
         RelaxNode(node, node_weight, forbidden_node, graph);
     }
+
+    stats.settled_nodes += std::min(nodes, node_limit);
+    stats.seconds +=
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 }
 
 void ContractorDijkstra::RelaxNode(const NodeID node,
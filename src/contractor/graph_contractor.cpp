@@ -1,5 +1,8 @@
 #include "contractor/graph_contractor.hpp"
 
+#include <cstdint>
+#include <string>
+
 namespace osrm
 {
 namespace contractor
@@ -13,9 +16,14 @@ GraphContractor::GraphContractor(int nodes, std::vector<ContractorEdge> input_ed
 GraphContractor::GraphContractor(int nodes,
                                  std::vector<ContractorEdge> edges,
                                  std::vector<float> &&node_levels_,
-                                 std::vector<EdgeWeight> &&node_weights_)
-    : node_levels(std::move(node_levels_)), node_weights(std::move(node_weights_))
+                                 std::vector<EdgeWeight> &&node_weights_,
+                                 WitnessSearchSchedule witness_search_schedule_)
+    : witness_search_schedule(std::move(witness_search_schedule_)),
+      node_levels(std::move(node_levels_)), node_weights(std::move(node_weights_))
 {
+    BOOST_ASSERT(!witness_search_schedule.settled_nodes.empty());
+    BOOST_ASSERT(!witness_search_schedule.hops.empty());
+
     tbb::parallel_sort(edges.begin(), edges.end());
     NodeID edge = 0;
     for (NodeID i = 0; i < edges.size();)
@@ -190,6 +198,9 @@ void GraphContractor::Run(double core_factor)
     std::vector<float> node_priorities;
     is_core_node.resize(number_of_nodes, false);
 
+    witness_search_phases.clear();
+    UpdateWitnessSearchLimits(0, number_of_nodes);
+
     std::vector<RemainingNodeData> remaining_nodes(number_of_nodes);
     // initialize priorities in parallel
     tbb::parallel_for(tbb::blocked_range<NodeID>(0, number_of_nodes, InitGrainSize),
@@ -205,7 +216,18 @@ void GraphContractor::Run(double core_factor)
     {
         util::UnbufferedLog log;
         log << "using cached node priorities ...";
+        BOOST_ASSERT(node_levels.size() == number_of_nodes);
         node_priorities.swap(node_levels);
+        // Re-contract in the order of the last run: the nodes are sorted by descending level and
+        // a round only considers the nodes up to its level, which are at the end of the remaining
+        // nodes. This skips the independence test for all nodes that the last run contracted
+        // later, and nodes are never contracted before their level.
+        tbb::parallel_sort(remaining_nodes.begin(),
+                           remaining_nodes.end(),
+                           [&node_priorities](const auto &lhs, const auto &rhs) {
+                               return std::make_pair(node_priorities[lhs.id], lhs.id) >
+                                      std::make_pair(node_priorities[rhs.id], rhs.id);
+                           });
         log << "ok";
     }
     else
@@ -236,6 +258,7 @@ void GraphContractor::Run(double core_factor)
     util::Percent p(log, number_of_nodes);
 
     unsigned current_level = 0;
+    float cached_level = -1;
     bool flushed_contractor = false;
     while (remaining_nodes.size() > 1 &&
            number_of_contracted_nodes < static_cast<NodeID>(number_of_nodes * core_factor))
@@ -250,8 +273,28 @@ void GraphContractor::Run(double core_factor)
             flushed_contractor = true;
         }
 
+        UpdateWitnessSearchLimits(number_of_contracted_nodes, number_of_nodes);
+
+        auto begin_candidate_nodes = remaining_nodes.begin();
+        if (use_cached_node_priorities)
+        {
+            // advance one level per round, or jump straight to the level of the lowest
+            // remaining node (remaining nodes are sorted by descending level)
+            cached_level =
+                std::max(cached_level + 1, node_priorities[remaining_nodes.back().id]);
+            begin_candidate_nodes = std::partition_point(
+                remaining_nodes.begin(),
+                remaining_nodes.end(),
+                [&node_priorities, cached_level](const RemainingNodeData &node_data) {
+                    return node_priorities[node_data.id] > cached_level;
+                });
+        }
+        const auto begin_candidate_nodes_idx =
+            std::distance(remaining_nodes.begin(), begin_candidate_nodes);
+
         tbb::parallel_for(
-            tbb::blocked_range<NodeID>(0, remaining_nodes.size(), IndependentGrainSize),
+            tbb::blocked_range<NodeID>(
+                begin_candidate_nodes_idx, remaining_nodes.size(), IndependentGrainSize),
             [this, &node_priorities, &remaining_nodes, &thread_data_list](
                 const tbb::blocked_range<NodeID> &range) {
                 ContractorThreadData *data = thread_data_list.GetThreadData();
@@ -266,7 +309,7 @@ void GraphContractor::Run(double core_factor)
 
         // sort all remaining nodes to the beginning of the sequence
         const auto begin_independent_nodes =
-            stable_partition(remaining_nodes.begin(),
+            stable_partition(begin_candidate_nodes,
                              remaining_nodes.end(),
                              [](RemainingNodeData node_data) { return !node_data.is_independent; });
         auto begin_independent_nodes_idx =
@@ -327,39 +370,36 @@ void GraphContractor::Run(double core_factor)
                 }
             });
 
-        // make sure we really sort each block
-        tbb::parallel_for(thread_data_list.data.range(),
-                          [&](const ThreadDataContainer::EnumerableThreadData::range_type &range) {
-                              for (auto &data : range)
-                                  tbb::parallel_sort(data->inserted_edges.begin(),
-                                                     data->inserted_edges.end());
-                          });
-
         // insert new edges
-        for (auto &data : thread_data_list.data)
         {
-            for (const ContractorEdge &edge : data->inserted_edges)
+            std::vector<ContractorEdge> inserted_edges;
+            for (auto &data : thread_data_list.data)
             {
-                const EdgeID current_edge_ID = contractor_graph->FindEdge(edge.source, edge.target);
-                if (current_edge_ID != SPECIAL_EDGEID)
-                {
-                    ContractorGraph::EdgeData &current_data =
-                        contractor_graph->GetEdgeData(current_edge_ID);
-                    if (current_data.shortcut && edge.data.forward == current_data.forward &&
-                        edge.data.backward == current_data.backward)
-                    {
-                        // found a duplicate edge with smaller weight, update it.
-                        if (edge.data.weight < current_data.weight)
-                        {
-                            current_data = edge.data;
-                        }
-                        // don't insert duplicates
-                        continue;
-                    }
-                }
-                contractor_graph->InsertEdge(edge.source, edge.target, edge.data);
+                inserted_edges.insert(inserted_edges.end(),
+                                      data->inserted_edges.begin(),
+                                      data->inserted_edges.end());
+                data->inserted_edges.clear();
             }
-            data->inserted_edges.clear();
+            // the order of the edges to the same target decides which duplicates are merged, it
+            // must not depend on the thread that found the shortcut
+            tbb::parallel_sort(inserted_edges.begin(),
+                               inserted_edges.end(),
+                               [](const ContractorEdge &lhs, const ContractorEdge &rhs) {
+                                   return std::make_tuple(lhs.source,
+                                                          lhs.target,
+                                                          lhs.data.weight,
+                                                          lhs.data.forward,
+                                                          lhs.data.backward,
+                                                          lhs.data.id) <
+                                          std::make_tuple(rhs.source,
+                                                          rhs.target,
+                                                          rhs.data.weight,
+                                                          rhs.data.forward,
+                                                          rhs.data.backward,
+                                                          rhs.data.id);
+                               });
+            MergeDuplicateShortcuts(inserted_edges);
+            contractor_graph->InsertEdges(inserted_edges);
         }
 
         if (!use_cached_node_priorities)
@@ -384,10 +424,23 @@ void GraphContractor::Run(double core_factor)
         number_of_contracted_nodes += end_independent_nodes_idx - begin_independent_nodes_idx;
         remaining_nodes.resize(begin_independent_nodes_idx);
 
+        CollectWitnessSearchStats(thread_data_list);
+
         p.PrintStatus(number_of_contracted_nodes);
         ++current_level;
     }
 
+    // the nodes of the core and the top node are above all contracted nodes
+    if (!use_cached_node_priorities)
+    {
+        for (const auto &node_data : remaining_nodes)
+        {
+            const auto orig_id =
+                flushed_contractor ? orig_node_id_from_new_node_id_map[node_data.id] : node_data.id;
+            node_levels[orig_id] = current_level;
+        }
+    }
+
     if (remaining_nodes.size() > 2)
     {
         if (flushed_contractor)
@@ -424,9 +477,126 @@ void GraphContractor::Run(double core_factor)
     util::Log() << "[core] " << remaining_nodes.size() << " nodes "
                 << contractor_graph->GetNumberOfEdges() << " edges.";
 
+    CollectWitnessSearchStats(thread_data_list);
+    LogWitnessSearchStats();
+
     thread_data_list.data.clear();
 }
 
+void GraphContractor::UpdateWitnessSearchLimits(const NodeID number_of_contracted_nodes,
+                                                const NodeID number_of_nodes)
+{
+    const auto phase_limit = [&](const std::vector<unsigned> &limits) {
+        const std::size_t phase =
+            static_cast<std::uint64_t>(number_of_contracted_nodes) * limits.size() /
+            std::max<NodeID>(number_of_nodes, 1);
+        return limits[std::min(phase, limits.size() - 1)];
+    };
+    const auto settled_nodes = phase_limit(witness_search_schedule.settled_nodes);
+    const auto hops = phase_limit(witness_search_schedule.hops);
+
+    if (witness_search_phases.empty() ||
+        witness_search_phases.back().settled_nodes != settled_nodes ||
+        witness_search_phases.back().hops != hops)
+    {
+        const double progress =
+            number_of_nodes > 0 ? static_cast<double>(number_of_contracted_nodes) / number_of_nodes
+                                : 0.;
+        witness_search_phases.push_back({progress, settled_nodes, hops, {}});
+    }
+}
+
+void GraphContractor::CollectWitnessSearchStats(ThreadDataContainer &thread_data_list)
+{
+    BOOST_ASSERT(!witness_search_phases.empty());
+    for (auto &data : thread_data_list.data)
+    {
+        auto &stats = data->dijkstra.GetStats();
+        witness_search_phases.back().stats += stats;
+        stats = WitnessSearchStats{};
+    }
+}
+
+void GraphContractor::LogWitnessSearchStats() const
+{
+    WitnessSearchStats total;
+    for (const auto &phase : witness_search_phases)
+    {
+        const auto &stats = phase.stats;
+        const auto searches = std::max<std::uint64_t>(stats.searches, 1);
+        util::Log() << "Witness searches from " << static_cast<int>(phase.progress * 100)
+                    << "% of the nodes (at most " << phase.settled_nodes << " nodes, "
+                    << (phase.hops > 0 ? std::to_string(phase.hops) : std::string("unlimited"))
+                    << " hops): " << stats.searches << " searches, "
+                    << static_cast<double>(stats.settled_nodes) / searches
+                    << " settled nodes on average, " << stats.stopped_at_node_limit
+                    << " stopped at the node limit, " << stats.pruned_at_hop_limit
+                    << " nodes pruned at the hop limit, " << stats.seconds << " sec";
+        total += stats;
+    }
+    util::Log() << "Witness searches took " << total.seconds << " sec in all threads";
+}
+
+void GraphContractor::MergeDuplicateShortcuts(std::vector<ContractorEdge> &edges)
+{
+    // the first edge of every source node
+    std::vector<std::size_t> first_edges;
+    for (const auto index : util::irange<std::size_t>(0, edges.size()))
+    {
+        if (index == 0 || edges[index].source != edges[index - 1].source)
+            first_edges.push_back(index);
+    }
+    first_edges.push_back(edges.size());
+
+    // every source only reads and updates its own edges, so the nodes are handled in parallel
+    std::vector<char> is_merged(edges.size(), false);
+    tbb::parallel_for(
+        tbb::blocked_range<std::size_t>(0, first_edges.size() - 1),
+        [&](const tbb::blocked_range<std::size_t> &range) {
+            for (auto node_index = range.begin(); node_index != range.end(); ++node_index)
+            {
+                const auto begin = first_edges[node_index];
+                const auto end = first_edges[node_index + 1];
+                auto first_to_target = begin;
+                for (const auto index : util::irange(begin, end))
+                {
+                    auto &edge = edges[index];
+                    if (edge.target != edges[first_to_target].target)
+                        first_to_target = index;
+
+                    // the graph is searched first, it contains the edges inserted before
+                    ContractorGraph::EdgeData *current_data = nullptr;
+                    const auto current_edge = contractor_graph->FindEdge(edge.source, edge.target);
+                    if (current_edge != SPECIAL_EDGEID)
+                        current_data = &contractor_graph->GetEdgeData(current_edge);
+                    else if (first_to_target != index)
+                        current_data = &edges[first_to_target].data;
+
+                    if (current_data && current_data->shortcut &&
+                        edge.data.forward == current_data->forward &&
+                        edge.data.backward == current_data->backward)
+                    {
+                        // found a duplicate edge with smaller weight, update it.
+                        if (edge.data.weight < current_data->weight)
+                        {
+                            *current_data = edge.data;
+                        }
+                        // don't insert duplicates
+                        is_merged[index] = true;
+                    }
+                }
+            }
+        });
+
+    std::size_t kept = 0;
+    for (const auto index : util::irange<std::size_t>(0, edges.size()))
+    {
+        if (!is_merged[index])
+            edges[kept++] = edges[index];
+    }
+    edges.resize(kept);
+}
+
 void GraphContractor::GetCoreMarker(std::vector<bool> &out_is_core_node)
 {
     out_is_core_node.swap(is_core_node);
@@ -0,0 +1,85 @@
+#include "contractor/renumber.hpp"
+
+#include "util/integer_range.hpp"
+
+#include <numeric>
+#include <utility>
+
+namespace osrm
+{
+namespace contractor
+{
+
+std::vector<std::uint32_t> makePermutation(const std::size_t number_of_nodes,
+                                           const util::DeallocatingVector<QueryEdge> &edges,
+                                           const std::vector<bool> &is_core_node)
+{
+    // Every edge of the contracted graph is stored at its lower node, so reversing the edges
+    // gives the edges to lower nodes. Only the nodes of the core are connected among each other.
+    std::vector<std::size_t> first_lower_edge(number_of_nodes + 1, 0);
+    std::vector<bool> is_top_node(number_of_nodes, true);
+    for (const auto &edge : edges)
+    {
+        ++first_lower_edge[edge.target + 1];
+        is_top_node[edge.source] = false;
+    }
+    std::partial_sum(first_lower_edge.begin(), first_lower_edge.end(), first_lower_edge.begin());
+
+    std::vector<NodeID> lower_nodes(edges.size());
+    {
+        auto insert_position = first_lower_edge;
+        for (const auto &edge : edges)
+            lower_nodes[insert_position[edge.target]++] = edge.source;
+    }
+
+    std::vector<std::uint32_t> permutation(number_of_nodes);
+    std::vector<bool> visited(number_of_nodes, false);
+    std::uint32_t next_id = 0;
+
+    // nodes on the stack together with the position of the next edge to a lower node
+    std::vector<std::pair<NodeID, std::size_t>> stack;
+    const auto visit = [&](const NodeID node) {
+        visited[node] = true;
+        permutation[node] = next_id++;
+        stack.emplace_back(node, first_lower_edge[node]);
+    };
+    const auto search = [&](const NodeID root) {
+        if (visited[root])
+            return;
+
+        visit(root);
+        while (!stack.empty())
+        {
+            const auto node = stack.back().first;
+            const auto edge = stack.back().second;
+            if (edge == first_lower_edge[node + 1])
+            {
+                stack.pop_back();
+                continue;
+            }
+
+            ++stack.back().second;
+            if (!visited[lower_nodes[edge]])
+                visit(lower_nodes[edge]);
+        }
+    };
+
+    // the core is part of every query that reaches it
+    if (!is_core_node.empty())
+    {
+        for (const auto node : util::irange<NodeID>(0, number_of_nodes))
+            if (is_core_node[node])
+                search(node);
+    }
+    for (const auto node : util::irange<NodeID>(0, number_of_nodes))
+        if (is_top_node[node])
+            search(node);
+    // all nodes are below a top node, this only catches nodes if the hierarchy is inconsistent
+    for (const auto node : util::irange<NodeID>(0, number_of_nodes))
+        search(node);
+
+    BOOST_ASSERT(next_id == number_of_nodes);
+    return permutation;
+}
+}
+}
@@ -0,0 +1,360 @@
+#include "customizer/customizable_hierarchy.hpp"
+
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/integer_range.hpp"
+
+#include <boost/assert.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace osrm
+{
+namespace customizer
+{
+
+std::vector<NodeID> makeNestedDissectionOrder(const std::size_t number_of_nodes,
+                                              const partition::MultiLevelPartition &mlp,
+                                              const std::vector<extractor::EdgeBasedEdge> &edges)
+{
+    // One end of every edge between cells is enough to separate them, the node of the cell with
+    // the higher id is used
+    std::vector<LevelID> separator_level(number_of_nodes, 0);
+    for (const auto &edge : edges)
+    {
+        const auto level = mlp.GetHighestDifferentLevel(edge.source, edge.target);
+        if (level == 0)
+            continue;
+        const auto node = mlp.GetCell(level, edge.source) > mlp.GetCell(level, edge.target)
+                              ? edge.source
+                              : edge.target;
+        separator_level[node] = std::max(separator_level[node], level);
+    }
+
+    // the separators of a cell are ranked together, the cells are compared from the top level down
+    const auto compare_cells = [&](const NodeID lhs, const NodeID rhs) {
+        BOOST_ASSERT(separator_level[lhs] == separator_level[rhs]);
+        for (LevelID level = mlp.GetNumberOfLevels() - 1; level > separator_level[lhs]; --level)
+        {
+            const auto lhs_cell = mlp.GetCell(level, lhs);
+            const auto rhs_cell = mlp.GetCell(level, rhs);
+            if (lhs_cell != rhs_cell)
+                return lhs_cell < rhs_cell ? -1 : 1;
+        }
+        return 0;
+    };
+    std::vector<NodeID> nodes(number_of_nodes);
+    std::iota(nodes.begin(), nodes.end(), 0);
+    std::stable_sort(nodes.begin(), nodes.end(), [&](const NodeID lhs, const NodeID rhs) {
+        if (separator_level[lhs] != separator_level[rhs])
+            return separator_level[lhs] < separator_level[rhs];
+        return compare_cells(lhs, rhs) < 0;
+    });
+
+    std::vector<std::uint32_t> group(number_of_nodes);
+    for (const auto index : util::irange<std::size_t>(1, number_of_nodes))
+    {
+        const auto node = nodes[index];
+        const auto previous = nodes[index - 1];
+        const bool same_group = separator_level[node] == separator_level[previous] &&
+                                compare_cells(node, previous) == 0;
+        group[node] = group[previous] + (same_group ? 0 : 1);
+    }
+
+    // Inside a group the nodes are ranked by their degree when they are contracted, which keeps
+    // the number of shortcuts of the cells low (minimum degree ordering)
+    std::vector<std::vector<NodeID>> neighbours(number_of_nodes);
+    for (const auto &edge : edges)
+    {
+        if (edge.source == edge.target)
+            continue;
+        neighbours[edge.source].push_back(edge.target);
+        neighbours[edge.target].push_back(edge.source);
+    }
+    using QueueEntry = std::tuple<std::uint32_t, std::size_t, NodeID>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    for (const auto node : util::irange<NodeID>(0, number_of_nodes))
+    {
+        auto &adjacent = neighbours[node];
+        std::sort(adjacent.begin(), adjacent.end());
+        adjacent.erase(std::unique(adjacent.begin(), adjacent.end()), adjacent.end());
+        queue.emplace(group[node], adjacent.size(), node);
+    }
+
+    std::vector<NodeID> ranks(number_of_nodes, SPECIAL_NODEID);
+    NodeID next_rank = 0;
+    std::vector<NodeID> merged;
+    while (!queue.empty())
+    {
+        const auto node = std::get<2>(queue.top());
+        const auto degree = std::get<1>(queue.top());
+        queue.pop();
+        // skip outdated entries
+        if (ranks[node] != SPECIAL_NODEID || degree != neighbours[node].size())
+            continue;
+        ranks[node] = next_rank++;
+
+        // contracting the node connects all of its neighbours
+        auto &adjacent = neighbours[node];
+        for (const auto neighbour : adjacent)
+        {
+            auto &other = neighbours[neighbour];
+            merged.clear();
+            std::set_union(other.begin(),
+                           other.end(),
+                           adjacent.begin(),
+                           adjacent.end(),
+                           std::back_inserter(merged));
+            merged.erase(std::remove_if(merged.begin(),
+                                        merged.end(),
+                                        [&](const NodeID other_node) {
+                                            return other_node == node || other_node == neighbour;
+                                        }),
+                         merged.end());
+            other.swap(merged);
+            queue.emplace(group[neighbour], other.size(), neighbour);
+        }
+        std::vector<NodeID>().swap(adjacent);
+    }
+
+    BOOST_ASSERT(next_rank == number_of_nodes);
+    return ranks;
+}
+
+CustomizableHierarchy::CustomizableHierarchy(std::vector<NodeID> ranks_,
+                                             const std::vector<extractor::EdgeBasedEdge> &edges)
+    : ranks(std::move(ranks_)), nodes(ranks.size())
+{
+    const NodeID number_of_nodes = ranks.size();
+    for (const auto node : util::irange<NodeID>(0, number_of_nodes))
+        nodes[ranks[node]] = node;
+
+    // The edges do not depend on the weights, blocked edges can be opened by the next metric
+    std::vector<std::vector<NodeID>> higher_neighbours(number_of_nodes);
+    for (const auto &edge : edges)
+    {
+        const auto source = ranks[edge.source];
+        const auto target = ranks[edge.target];
+        if (source != target)
+            higher_neighbours[std::min(source, target)].push_back(std::max(source, target));
+    }
+
+    // Contracting a node connects all of its higher neighbours. It is enough to add them to the
+    // lowest higher neighbour, which passes them on when it is contracted itself.
+    first_arc.reserve(number_of_nodes + 1);
+    for (const auto rank : util::irange<NodeID>(0, number_of_nodes))
+    {
+        auto &neighbours = higher_neighbours[rank];
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        if (neighbours.size() > 1)
+        {
+            auto &parent_neighbours = higher_neighbours[neighbours.front()];
+            parent_neighbours.insert(
+                parent_neighbours.end(), neighbours.begin() + 1, neighbours.end());
+        }
+
+        // the arcs are indexed with 32 bit like the edges of the contracted graph
+        if (arc_head.size() + neighbours.size() > std::numeric_limits<std::uint32_t>::max())
+        {
+            throw util::exception("The hierarchy has more than " +
+                                  std::to_string(std::numeric_limits<std::uint32_t>::max()) +
+                                  " arcs" + SOURCE_REF);
+        }
+
+        first_arc.push_back(arc_head.size());
+        arc_head.insert(arc_head.end(), neighbours.begin(), neighbours.end());
+        arc_tail.insert(arc_tail.end(), neighbours.size(), rank);
+        std::vector<NodeID>().swap(neighbours);
+    }
+    first_arc.push_back(arc_head.size());
+
+    first_lower_arc.resize(number_of_nodes + 1, 0);
+    for (const auto head : arc_head)
+        ++first_lower_arc[head + 1];
+    std::partial_sum(first_lower_arc.begin(), first_lower_arc.end(), first_lower_arc.begin());
+    lower_arcs.resize(arc_head.size());
+    {
+        auto insert_position = first_lower_arc;
+        for (const auto arc : util::irange<std::uint32_t>(0, arc_head.size()))
+            lower_arcs[insert_position[arc_head[arc]]++] = arc;
+    }
+
+    // a node is customized one step after the last of its lower neighbours
+    std::vector<std::uint32_t> step(number_of_nodes, 0);
+    for (const auto rank : util::irange<NodeID>(0, number_of_nodes))
+        for (const auto arc : util::irange(first_arc[rank], first_arc[rank + 1]))
+            step[arc_head[arc]] = std::max(step[arc_head[arc]], step[rank] + 1);
+
+    const auto number_of_steps =
+        number_of_nodes > 0 ? *std::max_element(step.begin(), step.end()) + 1 : 0;
+    first_in_step.resize(number_of_steps + 1, 0);
+    for (const auto rank : util::irange<NodeID>(0, number_of_nodes))
+        ++first_in_step[step[rank] + 1];
+    std::partial_sum(first_in_step.begin(), first_in_step.end(), first_in_step.begin());
+    customization_order.resize(number_of_nodes);
+    {
+        auto insert_position = first_in_step;
+        for (const auto rank : util::irange<NodeID>(0, number_of_nodes))
+            customization_order[insert_position[step[rank]]++] = rank;
+    }
+}
+
+std::uint32_t CustomizableHierarchy::FindArc(const NodeID lower, const NodeID upper) const
+{
+    const auto begin = arc_head.begin() + first_arc[lower];
+    const auto end = arc_head.begin() + first_arc[lower + 1];
+    const auto iter = std::lower_bound(begin, end, upper);
+    BOOST_ASSERT(iter != end && *iter == upper);
+    return std::distance(arc_head.begin(), iter);
+}
+
+void CustomizableHierarchy::Customize(const std::vector<extractor::EdgeBasedEdge> &edges,
+                                      const std::vector<EdgeWeight> &node_weights)
+{
+    const ArcMetric no_path{INVALID_EDGE_WEIGHT, MAXIMAL_EDGE_DURATION, SPECIAL_NODEID, false};
+    upward.assign(arc_head.size(), no_path);
+    downward.assign(arc_head.size(), no_path);
+    loops.assign(ranks.size(), no_path);
+
+    const auto relax = [](ArcMetric &metric, const ArcMetric &candidate) {
+        if (std::tie(candidate.weight, candidate.duration) <
+            std::tie(metric.weight, metric.duration))
+            metric = candidate;
+    };
+
+    // the arcs of the edges, parallel edges keep the best weight
+    for (const auto &edge : edges)
+    {
+        const auto source = ranks[edge.source];
+        const auto target = ranks[edge.target];
+        if (source == target || edge.data.weight == INVALID_EDGE_WEIGHT)
+            continue;
+
+        const auto arc = FindArc(std::min(source, target), std::max(source, target));
+        const ArcMetric metric{
+            std::max(edge.data.weight, 1), edge.data.duration, edge.data.turn_id, false};
+        if (edge.data.forward)
+            relax(source < target ? upward[arc] : downward[arc], metric);
+        if (edge.data.backward)
+            relax(source < target ? downward[arc] : upward[arc], metric);
+    }
+
+    // Every arc (a, b) is part of the lower triangles (x, a, b) of the lower neighbours x of a.
+    // The nodes of a step only write their own arcs and read the final arcs of lower nodes.
+    const auto customize_node = [&](const NodeID node) {
+        for (const auto lower_arc : util::irange(first_lower_arc[node], first_lower_arc[node + 1]))
+        {
+            const auto lower_arc_index = lower_arcs[lower_arc];
+            const auto middle = arc_tail[lower_arc_index];
+            const auto &to_middle = downward[lower_arc_index];
+            const auto &from_middle = upward[lower_arc_index];
+            if (to_middle.weight == INVALID_EDGE_WEIGHT &&
+                from_middle.weight == INVALID_EDGE_WEIGHT)
+                continue;
+
+            const auto add = [middle](const ArcMetric &first, const ArcMetric &second) {
+                if (first.weight == INVALID_EDGE_WEIGHT || second.weight == INVALID_EDGE_WEIGHT)
+                    return ArcMetric{INVALID_EDGE_WEIGHT, MAXIMAL_EDGE_DURATION, middle, true};
+                return ArcMetric{
+                    first.weight + second.weight, first.duration + second.duration, middle, true};
+            };
+
+            relax(loops[node], add(to_middle, from_middle));
+
+            // the higher neighbours of the middle node above this node are neighbours of this
+            // node as well, both lists are sorted
+            auto arc = first_arc[node];
+            for (const auto middle_arc :
+                 util::irange(lower_arc_index + 1, first_arc[middle + 1]))
+            {
+                const auto head = arc_head[middle_arc];
+                while (arc_head[arc] < head)
+                    ++arc;
+                BOOST_ASSERT(arc < first_arc[node + 1] && arc_head[arc] == head);
+
+                relax(upward[arc], add(to_middle, upward[middle_arc]));
+                relax(downward[arc], add(downward[middle_arc], from_middle));
+            }
+        }
+    };
+
+    for (const auto step : util::irange<std::size_t>(0, first_in_step.size() - 1))
+    {
+        tbb::parallel_for(tbb::blocked_range<std::uint32_t>(first_in_step[step],
+                                                            first_in_step[step + 1]),
+                          [&](const tbb::blocked_range<std::uint32_t> &range) {
+                              for (auto index = range.begin(); index != range.end(); ++index)
+                                  customize_node(customization_order[index]);
+                          });
+    }
+
+    BOOST_ASSERT(node_weights.size() == ranks.size());
+    for (const auto rank : util::irange<NodeID>(0, ranks.size()))
+    {
+        if (loops[rank].weight >= node_weights[nodes[rank]])
+            loops[rank] = no_path;
+    }
+}
+
+util::DeallocatingVector<contractor::QueryEdge> CustomizableHierarchy::GetEdges() const
+{
+    util::DeallocatingVector<contractor::QueryEdge> edges;
+
+    const auto make_edge = [this](const NodeID lower, const NodeID upper, const ArcMetric &metric) {
+        contractor::QueryEdge edge;
+        edge.source = nodes[lower];
+        edge.target = nodes[upper];
+        edge.data.weight = metric.weight;
+        edge.data.duration = metric.duration;
+        edge.data.shortcut = metric.shortcut;
+        edge.data.turn_id = metric.shortcut ? nodes[metric.id] : metric.id;
+        return edge;
+    };
+
+    for (const auto rank : util::irange<NodeID>(0, ranks.size()))
+    {
+        if (loops[rank].weight != INVALID_EDGE_WEIGHT)
+        {
+            auto edge = make_edge(rank, rank, loops[rank]);
+            edge.data.forward = edge.data.backward = true;
+            edges.push_back(edge);
+        }
+
+        for (const auto arc : util::irange(first_arc[rank], first_arc[rank + 1]))
+        {
+            const auto &up = upward[arc];
+            const auto &down = downward[arc];
+            const auto same_metric = std::tie(up.weight, up.duration, up.id, up.shortcut) ==
+                                     std::tie(down.weight, down.duration, down.id, down.shortcut);
+            if (up.weight != INVALID_EDGE_WEIGHT)
+            {
+                auto edge = make_edge(rank, arc_head[arc], up);
+                edge.data.forward = true;
+                edge.data.backward = same_metric;
+                edges.push_back(edge);
+            }
+            if (down.weight != INVALID_EDGE_WEIGHT && !same_metric)
+            {
+                auto edge = make_edge(rank, arc_head[arc], down);
+                edge.data.forward = false;
+                edge.data.backward = true;
+                edges.push_back(edge);
+            }
+        }
+    }
+
+    return edges;
+}
+}
+}
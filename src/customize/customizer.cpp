@@ -1,12 +1,19 @@
 #include "customizer/customizer.hpp"
 #include "customizer/cell_customizer.hpp"
+#include "customizer/customizable_hierarchy.hpp"
 #include "customizer/edge_based_graph.hpp"
 
+#include "contractor/crc32_processor.hpp"
+#include "contractor/files.hpp"
+#include "contractor/query_graph.hpp"
+
 #include "partition/cell_storage.hpp"
 #include "partition/edge_based_graph_reader.hpp"
 #include "partition/files.hpp"
 #include "partition/multi_level_partition.hpp"
 
+#include "storage/io.hpp"
+#include "storage/serialization.hpp"
 #include "storage/shared_memory_ownership.hpp"
 
 #include "updater/updater.hpp"
@@ -14,6 +21,10 @@
 #include "util/log.hpp"
 #include "util/timing_util.hpp"
 
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+
 namespace osrm
 {
 namespace customizer
@@ -93,6 +104,62 @@ auto LoadAndUpdateEdgeExpandedGraph(const CustomizationConfig &config,
     return edge_based_graph;
 }
 
+int CustomizeContractionHierarchy(const CustomizationConfig &config,
+                                  const partition::MultiLevelPartition &mlp)
+{
+    TIMER_START(loading_data);
+    std::vector<EdgeWeight> node_weights;
+    {
+        storage::io::FileReader reader(config.node_weights_path,
+                                       storage::io::FileReader::VerifyFingerprint);
+        storage::serialization::read(reader, node_weights);
+    }
+
+    updater::Updater updater(config.updater_config);
+    std::vector<extractor::EdgeBasedEdge> edge_based_edge_list;
+    const auto max_edge_id =
+        updater.LoadAndUpdateEdgeExpandedGraph(edge_based_edge_list, node_weights);
+    const auto number_of_nodes = max_edge_id + 1;
+    TIMER_STOP(loading_data);
+    util::Log() << "Loading edge based graph took " << TIMER_SEC(loading_data) << " seconds";
+
+    TIMER_START(building);
+    CustomizableHierarchy hierarchy(
+        makeNestedDissectionOrder(number_of_nodes, mlp, edge_based_edge_list),
+        edge_based_edge_list);
+    TIMER_STOP(building);
+    util::Log() << "Building the hierarchy took " << TIMER_SEC(building) << " seconds: "
+                << hierarchy.GetNumberOfArcs() << " arcs for " << number_of_nodes << " nodes";
+
+    TIMER_START(customizing);
+    hierarchy.Customize(edge_based_edge_list, node_weights);
+    TIMER_STOP(customizing);
+    util::Log() << "Hierarchy customization took " << TIMER_SEC(customizing) << " seconds";
+
+    TIMER_START(writing);
+    auto edges = hierarchy.GetEdges();
+    // Sorting contracted edges in a way that the static query graph can read some in in-place.
+    tbb::parallel_sort(edges.begin(), edges.end());
+
+    contractor::RangebasedCRC32 crc32_calculator;
+    const unsigned checksum = crc32_calculator(edges);
+
+    contractor::QueryGraph query_graph{number_of_nodes, edges};
+    contractor::files::writeGraph(config.cch_graph_path, checksum, query_graph);
+
+    // all nodes are contracted, CoreCH looks up the marker of every settled node
+    const std::vector<char> core_markers(number_of_nodes, 0);
+    storage::io::FileWriter core_marker_file(config.cch_core_path,
+                                             storage::io::FileWriter::GenerateFingerprint);
+    core_marker_file.WriteElementCount64(core_markers.size());
+    core_marker_file.WriteFrom(core_markers.data(), core_markers.size());
+    TIMER_STOP(writing);
+    util::Log() << "Writing the hierarchy took " << TIMER_SEC(writing) << " seconds: "
+                << edges.size() << " edges";
+
+    return 0;
+}
+
 int Customizer::Run(const CustomizationConfig &config)
 {
     TIMER_START(loading_data);
@@ -100,6 +167,11 @@ int Customizer::Run(const CustomizationConfig &config)
     partition::MultiLevelPartition mlp;
     partition::files::readPartition(config.mld_partition_path, mlp);
 
+    if (config.customize_cch)
+    {
+        return CustomizeContractionHierarchy(config, mlp);
+    }
+
     auto edge_based_graph = LoadAndUpdateEdgeExpandedGraph(config, mlp);
 
     partition::CellStorage storage;
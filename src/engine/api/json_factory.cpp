@@ -303,7 +303,7 @@ util::json::Object makeWaypoint(const util::Coordinate location, std::string nam
 util::json::Object makeWaypoint(const util::Coordinate location, std::string name, const Hint &hint)
 {
     auto waypoint = makeWaypoint(location, name);
-    waypoint.values["hint"] = hint.ToBase64();
+    waypoint.values["hint"] = hint.ToCompactBase64();
     return waypoint;
 }
 
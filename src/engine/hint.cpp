@@ -5,6 +5,7 @@
 #include <boost/assert.hpp>
 
 #include <algorithm>
+#include <cstring>
 #include <iterator>
 #include <ostream>
 #include <tuple>
@@ -14,9 +15,96 @@ namespace osrm
 namespace engine
 {
 
+namespace
+{
+const constexpr std::uint8_t COMPACT_HINT_VERSION = 1;
+const constexpr std::uint8_t FORWARD_ENABLED = 1;
+const constexpr std::uint8_t REVERSE_ENABLED = 2;
+
+// Serialized layout of compact hints
+struct CompactHint
+{
+    std::uint8_t version;
+    std::uint8_t flags;
+    std::uint16_t fwd_segment_position;
+    std::uint32_t forward_segment_id;
+    std::uint32_t reverse_segment_id;
+    std::uint32_t checksum;
+};
+static_assert(sizeof(CompactHint) == 16, "CompactHint is bigger than expected");
+static_assert(ENCODED_COMPACT_HINT_SIZE / 4 * 3 >= sizeof(CompactHint),
+              "ENCODED_COMPACT_HINT_SIZE does not match size of CompactHint");
+
+// FNV-1a over the dataset checksum, the input coordinate and the referenced segment.
+// Binding the input coordinate keeps the semantic of full hints: a hint is only
+// used for the coordinate it was generated for.
+std::uint32_t compactChecksum(const std::uint32_t data_checksum,
+                              const util::Coordinate input_coordinate,
+                              const PhantomNode &phantom)
+{
+    const std::uint32_t values[] = {
+        data_checksum,
+        static_cast<std::uint32_t>(static_cast<std::int32_t>(input_coordinate.lon)),
+        static_cast<std::uint32_t>(static_cast<std::int32_t>(input_coordinate.lat)),
+        static_cast<std::uint32_t>(phantom.forward_segment_id.id),
+        static_cast<std::uint32_t>(phantom.reverse_segment_id.id),
+        static_cast<std::uint32_t>(phantom.forward_segment_id.enabled) |
+            static_cast<std::uint32_t>(phantom.reverse_segment_id.enabled) << 1 |
+            static_cast<std::uint32_t>(phantom.fwd_segment_position) << 2};
+
+    std::uint32_t hash = 2166136261u;
+    for (const auto value : values)
+    {
+        for (auto shift = 0; shift < 32; shift += 8)
+        {
+            hash ^= (value >> shift) & 0xff;
+            hash *= 16777619u;
+        }
+    }
+    return hash;
+}
+
+// Decodes into x only if the encoding is padded correctly and has exactly the size of T.
+// Hints come from any client, a longer encoding must not write past x.
+template <typename T> bool decodeHintBytewise(const std::string &encoded, T &x)
+{
+    const auto padding = encoded.find('=');
+    if (padding != std::string::npos &&
+        (encoded.size() - padding > 2 ||
+         encoded.find_first_not_of('=', padding) != std::string::npos))
+    {
+        return false;
+    }
+
+    const auto decoded = decodeBase64(encoded);
+    if (decoded.size() != sizeof(T))
+    {
+        return false;
+    }
+
+    std::memcpy(&x, decoded.data(), sizeof(T));
+    return true;
+}
+
+std::string makeURLSafe(std::string base64)
+{
+    // Make safe for usage as GET parameter in URLs
+    std::replace(begin(base64), end(base64), '+', '-');
+    std::replace(begin(base64), end(base64), '/', '_');
+    return base64;
+}
+}
+
 bool Hint::IsValid(const util::Coordinate new_input_coordinates,
                    const datafacade::BaseDataFacade &facade) const
 {
+    if (IsCompact())
+    {
+        return (phantom.forward_segment_id.enabled || phantom.reverse_segment_id.enabled) &&
+               compactChecksum(facade.GetCheckSum(), new_input_coordinates, phantom) ==
+                   data_checksum;
+    }
+
     auto is_same_input_coordinate = new_input_coordinates.lon == phantom.input_location.lon &&
                                     new_input_coordinates.lat == phantom.input_location.lat;
     // FIXME this does not use the number of nodes to validate the phantom because
@@ -27,18 +115,30 @@ bool Hint::IsValid(const util::Coordinate new_input_coordinates,
 
 std::string Hint::ToBase64() const
 {
-    auto base64 = encodeBase64Bytewise(*this);
+    return makeURLSafe(encodeBase64Bytewise(*this));
+}
 
-    // Make safe for usage as GET parameter in URLs
-    std::replace(begin(base64), end(base64), '+', '-');
-    std::replace(begin(base64), end(base64), '/', '_');
+std::string Hint::ToCompactBase64() const
+{
+    BOOST_ASSERT(!IsCompact());
 
-    return base64;
+    CompactHint compact;
+    compact.version = COMPACT_HINT_VERSION;
+    compact.flags = (phantom.forward_segment_id.enabled ? FORWARD_ENABLED : 0) |
+                    (phantom.reverse_segment_id.enabled ? REVERSE_ENABLED : 0);
+    compact.fwd_segment_position = phantom.fwd_segment_position;
+    compact.forward_segment_id = phantom.forward_segment_id.id;
+    compact.reverse_segment_id = phantom.reverse_segment_id.id;
+    compact.checksum = compactChecksum(data_checksum, phantom.input_location, phantom);
+
+    return makeURLSafe(encodeBase64Bytewise(compact));
 }
 
 Hint Hint::FromBase64(const std::string &base64Hint)
 {
-    BOOST_ASSERT_MSG(base64Hint.size() == ENCODED_HINT_SIZE, "Hint has invalid size");
+    BOOST_ASSERT_MSG(base64Hint.size() == ENCODED_HINT_SIZE ||
+                         base64Hint.size() == ENCODED_COMPACT_HINT_SIZE,
+                     "Hint has invalid size");
 
     // We need mutability but don't want to change the API
     auto encoded = base64Hint;
@@ -47,7 +147,29 @@ Hint Hint::FromBase64(const std::string &base64Hint)
     std::replace(begin(encoded), end(encoded), '-', '+');
     std::replace(begin(encoded), end(encoded), '_', '/');
 
-    return decodeBase64Bytewise<Hint>(encoded);
+    // Malformed hints and unknown versions yield a hint that is never valid and thus fall back
+    // to snapping
+    Hint hint{PhantomNode{}, 0};
+
+    if (encoded.size() != ENCODED_COMPACT_HINT_SIZE)
+    {
+        Hint full_hint;
+        return decodeHintBytewise(encoded, full_hint) ? full_hint : hint;
+    }
+
+    CompactHint compact;
+    if (decodeHintBytewise(encoded, compact) && compact.version == COMPACT_HINT_VERSION)
+    {
+        hint.phantom.forward_segment_id = {compact.forward_segment_id,
+                                           (compact.flags & FORWARD_ENABLED) != 0 &&
+                                               compact.forward_segment_id != SPECIAL_SEGMENTID};
+        hint.phantom.reverse_segment_id = {compact.reverse_segment_id,
+                                           (compact.flags & REVERSE_ENABLED) != 0 &&
+                                               compact.reverse_segment_id != SPECIAL_SEGMENTID};
+        hint.phantom.fwd_segment_position = compact.fwd_segment_position;
+        hint.data_checksum = compact.checksum;
+    }
+    return hint;
 }
 
 bool operator==(const Hint &lhs, const Hint &rhs)
@@ -0,0 +1,108 @@
+#include "engine/phantom_node_cache.hpp"
+
+#include "util/log.hpp"
+#include "util/std_hash.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <iomanip>
+
+namespace osrm
+{
+namespace engine
+{
+
+constexpr std::uint64_t PhantomNodeCache::LOG_INTERVAL;
+
+std::size_t PhantomNodeQueryHash::operator()(const PhantomNodeQuery &query) const
+{
+    return hash_val(static_cast<std::int32_t>(query.lon),
+                    static_cast<std::int32_t>(query.lat),
+                    query.max_results,
+                    query.max_distance,
+                    query.bearing,
+                    query.bearing_range,
+                    static_cast<std::uint8_t>(query.approach),
+                    query.with_alternative);
+}
+
+PhantomNodeCache::PhantomNodeCache(const std::size_t capacity)
+    : capacity_per_shard(capacity == 0 ? 0 : std::max<std::size_t>(1, capacity / NUM_SHARDS)),
+      hits(0), misses(0), lookups(0)
+{
+}
+
+PhantomNodeCache::~PhantomNodeCache()
+{
+    if (hits + misses > 0)
+    {
+        LogStatistics();
+    }
+}
+
+void PhantomNodeCache::LogStatistics() const
+{
+    util::Log() << "Phantom node cache: " << hits << " hits, " << misses << " misses ("
+                << std::fixed << std::setprecision(1) << (GetHitRatio() * 100.)
+                << "% hit ratio)";
+}
+
+double PhantomNodeCache::GetHitRatio() const
+{
+    const std::uint64_t num_hits = hits;
+    const auto num_lookups = num_hits + misses;
+    return num_lookups == 0 ? 0. : static_cast<double>(num_hits) / num_lookups;
+}
+
+PhantomNodeCache::Shard &PhantomNodeCache::GetShard(const PhantomNodeQuery &query) const
+{
+    // the low bits are used by the hash table of the shard
+    const auto hash = PhantomNodeQueryHash{}(query);
+    return shards[(hash >> 16) % NUM_SHARDS];
+}
+
+bool PhantomNodeCache::Lookup(const PhantomNodeQuery &query, Result &result) const
+{
+    if (++lookups % LOG_INTERVAL == 0)
+    {
+        LogStatistics();
+    }
+
+    auto &shard = GetShard(query);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const auto found = shard.index.find(query);
+        if (found != shard.index.end())
+        {
+            shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+            result = found->second->second;
+            ++hits;
+            return true;
+        }
+    }
+    ++misses;
+    return false;
+}
+
+void PhantomNodeCache::Insert(const PhantomNodeQuery &query, const Result &result) const
+{
+    auto &shard = GetShard(query);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // a concurrent request might have inserted the same query in the meantime
+    if (shard.index.count(query) > 0)
+        return;
+
+    shard.entries.emplace_front(query, result);
+    shard.index.emplace(query, shard.entries.begin());
+
+    if (shard.entries.size() > capacity_per_shard)
+    {
+        shard.index.erase(shard.entries.back().first);
+        shard.entries.pop_back();
+    }
+    BOOST_ASSERT(shard.entries.size() == shard.index.size());
+}
+}
+}
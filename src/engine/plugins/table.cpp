@@ -28,10 +28,11 @@ TablePlugin::TablePlugin(const int max_locations_distance_table)
 {
 }
 
+template <typename ResultT>
 Status TablePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
                                   const RoutingAlgorithmsInterface &algorithms,
                                   const api::TableParameters &params,
-                                  util::json::Object &result) const
+                                  ResultT &result) const
 {
     if (!algorithms.HasManyToManySearch())
     {
@@ -91,6 +92,17 @@ Status TablePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryData
 
     return Status::Ok;
 }
+
+template Status
+TablePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
+                           const RoutingAlgorithmsInterface &algorithms,
+                           const api::TableParameters &params,
+                           util::json::Object &result) const;
+template Status
+TablePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
+                           const RoutingAlgorithmsInterface &algorithms,
+                           const api::TableParameters &params,
+                           api::TableResult &result) const;
 }
 }
 }
@@ -26,11 +26,12 @@ ViaRoutePlugin::ViaRoutePlugin(int max_locations_viaroute)
 {
 }
 
+template <typename ResultT>
 Status
 ViaRoutePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
                               const RoutingAlgorithmsInterface &algorithms,
                               const api::RouteParameters &route_parameters,
-                              util::json::Object &json_result) const
+                              ResultT &result) const
 {
     BOOST_ASSERT(route_parameters.IsValid());
 
@@ -39,7 +40,7 @@ ViaRoutePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFaca
         return Error("NotImplemented",
                      "Shortest path search is not implemented for the chosen search algorithm. "
                      "Only two coordinates supported.",
-                     json_result);
+                     result);
     }
 
     if (!algorithms.HasDirectShortestPathSearch() && !algorithms.HasShortestPathSearch())
@@ -47,7 +48,7 @@ ViaRoutePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFaca
         return Error(
             "NotImplemented",
             "Direct shortest path search is not implemented for the chosen search algorithm.",
-            json_result);
+            result);
     }
 
     if (max_locations_viaroute > 0 &&
@@ -57,12 +58,12 @@ ViaRoutePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFaca
                      "Number of entries " + std::to_string(route_parameters.coordinates.size()) +
                          " is higher than current maximum (" +
                          std::to_string(max_locations_viaroute) + ")",
-                     json_result);
+                     result);
     }
 
     if (!CheckAllCoordinates(route_parameters.coordinates))
     {
-        return Error("InvalidValue", "Invalid coordinate value.", json_result);
+        return Error("InvalidValue", "Invalid coordinate value.", result);
     }
 
     auto phantom_node_pairs = GetPhantomNodes(facade, route_parameters);
@@ -71,7 +72,7 @@ ViaRoutePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFaca
         return Error("NoSegment",
                      std::string("Could not find a matching segment for coordinate ") +
                          std::to_string(phantom_node_pairs.size()),
-                     json_result);
+                     result);
     }
     BOOST_ASSERT(phantom_node_pairs.size() == route_parameters.coordinates.size());
 
@@ -111,7 +112,7 @@ ViaRoutePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFaca
 
     if (routes.routes[0].is_valid())
     {
-        route_api.MakeResponse(routes, json_result);
+        route_api.MakeResponse(routes, result);
     }
     else
     {
@@ -124,16 +125,27 @@ ViaRoutePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFaca
 
         if (not_in_same_component)
         {
-            return Error("NoRoute", "Impossible route between points", json_result);
+            return Error("NoRoute", "Impossible route between points", result);
         }
         else
         {
-            return Error("NoRoute", "No route found between points", json_result);
+            return Error("NoRoute", "No route found between points", result);
         }
     }
 
     return Status::Ok;
 }
+
+template Status
+ViaRoutePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
+                              const RoutingAlgorithmsInterface &algorithms,
+                              const api::RouteParameters &route_parameters,
+                              util::json::Object &result) const;
+template Status
+ViaRoutePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
+                              const RoutingAlgorithmsInterface &algorithms,
+                              const api::RouteParameters &route_parameters,
+                              api::RouteResult &result) const;
 }
 }
 }
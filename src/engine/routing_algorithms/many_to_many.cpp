@@ -3,6 +3,7 @@
 
 #include <boost/assert.hpp>
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <unordered_map>
@@ -20,6 +21,8 @@ namespace ch
 
 using ManyToManyQueryHeap = SearchEngineData<Algorithm>::ManyToManyQueryHeap;
 
+// The helpers below are shared with the core-aware search of corech. They stay internal to this
+// file, qualified names like ch::forwardRoutingStep still find them.
 namespace
 {
 struct NodeBucket
@@ -36,12 +39,14 @@ struct NodeBucket
 // FIXME This should be replaced by an std::unordered_multimap, though this needs benchmarking
 using SearchSpaceWithBuckets = std::unordered_map<NodeID, std::vector<NodeBucket>>;
 
+// Unlike relaxOutgoingEdges of routing_base_ch.hpp this also sums up the durations
 template <bool DIRECTION>
-void relaxOutgoingEdges(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
-                        const NodeID node,
-                        const EdgeWeight weight,
-                        const EdgeWeight duration,
-                        ManyToManyQueryHeap &query_heap)
+void relaxOutgoingEdgesWithDuration(
+    const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+    const NodeID node,
+    const EdgeWeight weight,
+    const EdgeWeight duration,
+    ManyToManyQueryHeap &query_heap)
 {
     for (auto edge : facade.GetAdjacentEdgeRange(node))
     {
@@ -72,6 +77,49 @@ void relaxOutgoingEdges(const datafacade::ContiguousInternalMemoryDataFacade<Alg
     }
 }
 
+// updates the weights of a row of the table with the buckets of a settled node
+void updateTableEntries(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                        const NodeID node,
+                        const EdgeWeight source_weight,
+                        const EdgeWeight source_duration,
+                        const unsigned row_idx,
+                        const unsigned number_of_targets,
+                        const std::vector<NodeBucket> &bucket_list,
+                        std::vector<EdgeWeight> &weights_table,
+                        std::vector<EdgeWeight> &durations_table)
+{
+    for (const NodeBucket &current_bucket : bucket_list)
+    {
+        // get target id from bucket entry
+        const unsigned column_idx = current_bucket.target_id;
+        const EdgeWeight target_weight = current_bucket.weight;
+        const EdgeWeight target_duration = current_bucket.duration;
+
+        auto &current_weight = weights_table[row_idx * number_of_targets + column_idx];
+        auto &current_duration = durations_table[row_idx * number_of_targets + column_idx];
+
+        // check if new weight is better
+        const EdgeWeight new_weight = source_weight + target_weight;
+        if (new_weight < 0)
+        {
+            const EdgeWeight loop_weight = ch::getLoopWeight<false>(facade, node);
+            const EdgeWeight new_weight_with_loop = new_weight + loop_weight;
+            if (loop_weight != INVALID_EDGE_WEIGHT && new_weight_with_loop >= 0)
+            {
+                current_weight = std::min(current_weight, new_weight_with_loop);
+                current_duration = std::min(current_duration,
+                                            source_duration + target_duration +
+                                                ch::getLoopWeight<true>(facade, node));
+            }
+        }
+        else if (new_weight < current_weight)
+        {
+            current_weight = new_weight;
+            current_duration = source_duration + target_duration;
+        }
+    }
+}
+
 void forwardRoutingStep(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
                         const unsigned row_idx,
                         const unsigned number_of_targets,
@@ -89,44 +137,23 @@ void forwardRoutingStep(const datafacade::ContiguousInternalMemoryDataFacade<Alg
     // iterate bucket if there exists one
     if (bucket_iterator != search_space_with_buckets.end())
     {
-        const std::vector<NodeBucket> &bucket_list = bucket_iterator->second;
-        for (const NodeBucket &current_bucket : bucket_list)
-        {
-            // get target id from bucket entry
-            const unsigned column_idx = current_bucket.target_id;
-            const EdgeWeight target_weight = current_bucket.weight;
-            const EdgeWeight target_duration = current_bucket.duration;
-
-            auto &current_weight = weights_table[row_idx * number_of_targets + column_idx];
-            auto &current_duration = durations_table[row_idx * number_of_targets + column_idx];
-
-            // check if new weight is better
-            const EdgeWeight new_weight = source_weight + target_weight;
-            if (new_weight < 0)
-            {
-                const EdgeWeight loop_weight = ch::getLoopWeight<false>(facade, node);
-                const EdgeWeight new_weight_with_loop = new_weight + loop_weight;
-                if (loop_weight != INVALID_EDGE_WEIGHT && new_weight_with_loop >= 0)
-                {
-                    current_weight = std::min(current_weight, new_weight_with_loop);
-                    current_duration = std::min(current_duration,
-                                                source_duration + target_duration +
-                                                    ch::getLoopWeight<true>(facade, node));
-                }
-            }
-            else if (new_weight < current_weight)
-            {
-                current_weight = new_weight;
-                current_duration = source_duration + target_duration;
-            }
-        }
+        updateTableEntries(facade,
+                           node,
+                           source_weight,
+                           source_duration,
+                           row_idx,
+                           number_of_targets,
+                           bucket_iterator->second,
+                           weights_table,
+                           durations_table);
     }
     if (ch::stallAtNode<FORWARD_DIRECTION>(facade, node, source_weight, query_heap))
     {
         return;
     }
 
-    relaxOutgoingEdges<FORWARD_DIRECTION>(facade, node, source_weight, source_duration, query_heap);
+    relaxOutgoingEdgesWithDuration<FORWARD_DIRECTION>(
+        facade, node, source_weight, source_duration, query_heap);
 }
 
 void backwardRoutingStep(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
@@ -146,7 +173,8 @@ void backwardRoutingStep(const datafacade::ContiguousInternalMemoryDataFacade<Al
         return;
     }
 
-    relaxOutgoingEdges<REVERSE_DIRECTION>(facade, node, target_weight, target_duration, query_heap);
+    relaxOutgoingEdgesWithDuration<REVERSE_DIRECTION>(
+        facade, node, target_weight, target_duration, query_heap);
 }
 }
 
@@ -243,6 +271,262 @@ manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
 }
 
 } // namespace ch
+
+namespace corech
+{
+
+using ManyToManyQueryHeap = SearchEngineData<Algorithm>::ManyToManyQueryHeap;
+
+namespace
+{
+// a core node settled by the search of a source, the core search starts from these nodes
+struct CoreEntryPoint
+{
+    NodeID node;
+    EdgeWeight weight;
+    EdgeWeight duration;
+};
+
+void forwardRoutingStep(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                        const unsigned row_idx,
+                        const unsigned number_of_targets,
+                        ManyToManyQueryHeap &query_heap,
+                        const ch::SearchSpaceWithBuckets &search_space_with_buckets,
+                        std::vector<CoreEntryPoint> &core_entry_points,
+                        std::vector<EdgeWeight> &weights_table,
+                        std::vector<EdgeWeight> &durations_table)
+{
+    if (facade.IsCoreNode(query_heap.Min()))
+    {
+        const NodeID node = query_heap.DeleteMin();
+        core_entry_points.push_back(
+            {node, query_heap.GetKey(node), query_heap.GetData(node).duration});
+        return;
+    }
+
+    ch::forwardRoutingStep(facade,
+                           row_idx,
+                           number_of_targets,
+                           query_heap,
+                           search_space_with_buckets,
+                           weights_table,
+                           durations_table);
+}
+
+void backwardRoutingStep(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                         const unsigned column_idx,
+                         ManyToManyQueryHeap &query_heap,
+                         ch::SearchSpaceWithBuckets &search_space_with_buckets,
+                         ch::SearchSpaceWithBuckets &core_buckets)
+{
+    // the core is not contracted, the target is only stored at the nodes where it enters the core
+    if (facade.IsCoreNode(query_heap.Min()))
+    {
+        const NodeID node = query_heap.DeleteMin();
+        core_buckets[node].emplace_back(
+            column_idx, query_heap.GetKey(node), query_heap.GetData(node).duration);
+        return;
+    }
+
+    ch::backwardRoutingStep(facade, column_idx, query_heap, search_space_with_buckets);
+}
+
+// Runs a one-to-many Dijkstra search through the core from the entry points of a source. The core
+// nodes are settled in the order of their weight, so the search stops once all targets that enter
+// the core are reached and no node is cheaper than the most expensive of them.
+void coreRoutingSearch(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                       const unsigned row_idx,
+                       const unsigned number_of_targets,
+                       ManyToManyQueryHeap &query_heap,
+                       const std::vector<CoreEntryPoint> &core_entry_points,
+                       const ch::SearchSpaceWithBuckets &core_buckets,
+                       const std::vector<bool> &enters_core,
+                       std::vector<EdgeWeight> &weights_table,
+                       std::vector<EdgeWeight> &durations_table)
+{
+    query_heap.Clear();
+    for (const auto &entry : core_entry_points)
+    {
+        query_heap.Insert(entry.node, entry.weight, {entry.node, entry.duration});
+    }
+
+    const auto row = weights_table.begin() + row_idx * number_of_targets;
+    std::size_t unreached_targets = 0;
+    EdgeWeight weight_upper_bound = std::numeric_limits<EdgeWeight>::min();
+    for (unsigned column_idx = 0; column_idx < number_of_targets; ++column_idx)
+    {
+        if (!enters_core[column_idx])
+            continue;
+        if (row[column_idx] == INVALID_EDGE_WEIGHT)
+            ++unreached_targets;
+        else
+            weight_upper_bound = std::max(weight_upper_bound, row[column_idx]);
+    }
+    const auto count_unreached = [&](const std::vector<ch::NodeBucket> &bucket_list) {
+        return std::count_if(
+            bucket_list.begin(), bucket_list.end(), [&](const ch::NodeBucket &bucket) {
+                return row[bucket.target_id] == INVALID_EDGE_WEIGHT;
+            });
+    };
+
+    while (!query_heap.Empty() &&
+           (unreached_targets > 0 || query_heap.MinKey() < weight_upper_bound))
+    {
+        const NodeID node = query_heap.DeleteMin();
+        const EdgeWeight source_weight = query_heap.GetKey(node);
+        const EdgeWeight source_duration = query_heap.GetData(node).duration;
+
+        const auto bucket_iterator = core_buckets.find(node);
+        if (bucket_iterator != core_buckets.end())
+        {
+            const auto &bucket_list = bucket_iterator->second;
+            const auto unreached_in_bucket = count_unreached(bucket_list);
+            ch::updateTableEntries(facade,
+                                   node,
+                                   source_weight,
+                                   source_duration,
+                                   row_idx,
+                                   number_of_targets,
+                                   bucket_list,
+                                   weights_table,
+                                   durations_table);
+            unreached_targets -= unreached_in_bucket - count_unreached(bucket_list);
+            // the entries only decrease, an outdated maximum is still an upper bound
+            for (const auto &bucket : bucket_list)
+            {
+                if (row[bucket.target_id] != INVALID_EDGE_WEIGHT)
+                    weight_upper_bound = std::max(weight_upper_bound, row[bucket.target_id]);
+            }
+        }
+
+        ch::relaxOutgoingEdgesWithDuration<FORWARD_DIRECTION>(
+            facade, node, source_weight, source_duration, query_heap);
+    }
+}
+}
+
+std::vector<EdgeWeight>
+manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
+                 const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                 const std::vector<PhantomNode> &phantom_nodes,
+                 const std::vector<std::size_t> &source_indices,
+                 const std::vector<std::size_t> &target_indices)
+{
+    const auto number_of_sources =
+        source_indices.empty() ? phantom_nodes.size() : source_indices.size();
+    const auto number_of_targets =
+        target_indices.empty() ? phantom_nodes.size() : target_indices.size();
+    const auto number_of_entries = number_of_sources * number_of_targets;
+
+    std::vector<EdgeWeight> weights_table(number_of_entries, INVALID_EDGE_WEIGHT);
+    std::vector<EdgeWeight> durations_table(number_of_entries, MAXIMAL_EDGE_DURATION);
+
+    engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(facade.GetNumberOfNodes());
+
+    auto &query_heap = *(engine_working_data.many_to_many_heap);
+
+    ch::SearchSpaceWithBuckets search_space_with_buckets;
+    ch::SearchSpaceWithBuckets core_buckets;
+    std::vector<bool> enters_core(number_of_targets, false);
+
+    unsigned column_idx = 0;
+    const auto search_target_phantom = [&](const PhantomNode &phantom) {
+        // clear heap and insert target nodes
+        query_heap.Clear();
+        insertTargetInHeap(query_heap, phantom);
+
+        // explore search space up to the core
+        while (!query_heap.Empty())
+        {
+            backwardRoutingStep(
+                facade, column_idx, query_heap, search_space_with_buckets, core_buckets);
+        }
+        ++column_idx;
+    };
+
+    // for each source do forward search
+    unsigned row_idx = 0;
+    std::vector<CoreEntryPoint> core_entry_points;
+    const auto search_source_phantom = [&](const PhantomNode &phantom) {
+        // clear heap and insert source nodes
+        query_heap.Clear();
+        insertSourceInHeap(query_heap, phantom);
+        core_entry_points.clear();
+
+        // explore search space up to the core
+        while (!query_heap.Empty())
+        {
+            forwardRoutingStep(facade,
+                               row_idx,
+                               number_of_targets,
+                               query_heap,
+                               search_space_with_buckets,
+                               core_entry_points,
+                               weights_table,
+                               durations_table);
+        }
+
+        // continue through the core to the targets that enter it
+        if (!core_entry_points.empty() && !core_buckets.empty())
+        {
+            coreRoutingSearch(facade,
+                              row_idx,
+                              number_of_targets,
+                              query_heap,
+                              core_entry_points,
+                              core_buckets,
+                              enters_core,
+                              weights_table,
+                              durations_table);
+        }
+        ++row_idx;
+    };
+
+    if (target_indices.empty())
+    {
+        for (const auto &phantom : phantom_nodes)
+        {
+            search_target_phantom(phantom);
+        }
+    }
+    else
+    {
+        for (const auto index : target_indices)
+        {
+            const auto &phantom = phantom_nodes[index];
+            search_target_phantom(phantom);
+        }
+    }
+
+    // the core search only needs to reach the targets that enter the core
+    for (const auto &core_bucket : core_buckets)
+    {
+        for (const auto &bucket : core_bucket.second)
+        {
+            enters_core[bucket.target_id] = true;
+        }
+    }
+
+    if (source_indices.empty())
+    {
+        for (const auto &phantom : phantom_nodes)
+        {
+            search_source_phantom(phantom);
+        }
+    }
+    else
+    {
+        for (const auto index : source_indices)
+        {
+            const auto &phantom = phantom_nodes[index];
+            search_source_phantom(phantom);
+        }
+    }
+
+    return durations_table;
+}
+
+} // namespace corech
 } // namespace routing_algorithms
 } // namespace engine
 } // namespace osrm
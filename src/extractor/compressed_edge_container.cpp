@@ -6,6 +6,8 @@
 #include <boost/filesystem/fstream.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 
+#include <algorithm>
+#include <iterator>
 #include <limits>
 #include <string>
 
@@ -192,6 +194,38 @@ void CompressedEdgeContainer::CompressEdge(const EdgeID edge_id_1,
     }
 }
 
+void CompressedEdgeContainer::AddCompressedEdge(const EdgeID edge_id,
+                                                OnewayEdgeBucket::const_iterator segments_begin,
+                                                OnewayEdgeBucket::const_iterator segments_end)
+{
+    BOOST_ASSERT(SPECIAL_EDGEID != edge_id);
+    BOOST_ASSERT(!HasEntryForID(edge_id));
+    BOOST_ASSERT(std::distance(segments_begin, segments_end) > 1);
+
+    if (0 == m_free_list.size())
+    {
+        // make sure there is a place to put the entries
+        IncreaseFreeList();
+    }
+    BOOST_ASSERT(!m_free_list.empty());
+    const unsigned edge_bucket_id = m_free_list.back();
+    m_free_list.pop_back();
+    m_edge_id_to_list_index_map[edge_id] = edge_bucket_id;
+
+    std::vector<OnewayCompressedEdge> &edge_bucket_list =
+        m_compressed_oneway_geometries[edge_bucket_id];
+    BOOST_ASSERT(edge_bucket_list.empty());
+    edge_bucket_list.reserve(std::distance(segments_begin, segments_end));
+    std::transform(segments_begin,
+                   segments_end,
+                   std::back_inserter(edge_bucket_list),
+                   [this](const OnewayCompressedEdge &segment) {
+                       return OnewayCompressedEdge{segment.node_id,
+                                                   ClipWeight(segment.weight),
+                                                   ClipDuration(segment.duration)};
+                   });
+}
+
 void CompressedEdgeContainer::AddUncompressedEdge(const EdgeID edge_id,
                                                   const NodeID target_node_id,
                                                   const SegmentWeight weight,
@@ -22,12 +22,16 @@
 #include <boost/assert.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 
+#include <tbb/pipeline.h>
+#include <tbb/task_scheduler_init.h>
+
 #include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <limits>
 #include <sstream>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 
 namespace osrm
@@ -331,9 +335,6 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
 
     TurnDataExternalContainer turn_data_container;
 
-    // Loop over all turns and generate new set of edges.
-    // Three nested loop look super-linear, but we are dealing with a (kind of)
-    // linear number of turns only.
     SuffixTable street_name_suffix_table(scripting_environment);
     guidance::TurnAnalysis turn_analysis(*m_node_based_graph,
                                          m_coordinates,
@@ -362,101 +363,183 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
     const auto weight_multiplier =
         scripting_environment.GetProfileProperties().GetWeightMultiplier();
 
+    // The intersections are processed in ranges of nodes that pass through a pipeline:
+    //
+    //  1. (parallel) compute the intersection shapes and turn types
+    //  2. (serial, in order) assign turn lanes, this registers new lane data in shared maps
+    //  3. (parallel) classify the intersections and compute the turn penalties
+    //  4. (serial, in order) assign entry/bearing classes and turn ids and write the turns
+    //
+    // Since all ids are assigned by the serial stages in node order, the output is the same as
+    // if all nodes were processed one after another.
+    struct EnteringRoad
     {
-        util::UnbufferedLog log;
+        NodeID node_at_center_of_intersection;
+        NodeID node_along_road_entering;
+        EdgeID incoming_edge;
+        guidance::Intersection intersection;
+        util::guidance::EntryClass entry_class;
+        util::guidance::BearingClass bearing_class;
+        // range of the turns of this road in EdgeExpansionBuffer::turns
+        std::size_t turns_begin;
+        std::size_t turns_end;
+    };
 
-        util::Percent progress(log, m_node_based_graph->GetNumberOfNodes());
-        // going over all nodes (which form the center of an intersection), we compute all
-        // possible turns along these intersections.
-        for (const auto node_at_center_of_intersection :
-             util::irange(0u, m_node_based_graph->GetNumberOfNodes()))
-        {
-            progress.PrintStatus(node_at_center_of_intersection);
-
-            const auto shape_result =
-                turn_analysis.ComputeIntersectionShapes(node_at_center_of_intersection);
-
-            // all nodes in the graph are connected in both directions. We check all outgoing nodes
-            // to
-            // find the incoming edge. This is a larger search overhead, but the cost we need to pay
-            // to
-            // generate edges here is worth the additional search overhead.
-            //
-            // a -> b <-> c
-            //      |
-            //      v
-            //      d
-            //
-            // will have:
-            // a: b,rev=0
-            // b: a,rev=1 c,rev=0 d,rev=0
-            // c: b,rev=0
-            //
-            // From the flags alone, we cannot determine which nodes are connected to `b` by an
-            // outgoing
-            // edge. Therefore, we have to search all connected edges for edges entering `b`
-            for (const EdgeID outgoing_edge :
-                 m_node_based_graph->GetAdjacentEdgeRange(node_at_center_of_intersection))
-            {
-                const NodeID node_along_road_entering =
-                    m_node_based_graph->GetTarget(outgoing_edge);
+    struct ExpandedTurn
+    {
+        guidance::TurnInstruction instruction;
+        LaneDataID lane_data_id;
+        util::guidance::TurnBearing pre_turn_bearing;
+        util::guidance::TurnBearing post_turn_bearing;
+        NodeID source;
+        NodeID target;
+        EdgeWeight weight;
+        EdgeWeight duration;
+        TurnPenalty weight_penalty;
+        TurnPenalty duration_penalty;
+        lookup::TurnIndexBlock turn_index_block;
+    };
+
+    struct EdgeExpansionBuffer
+    {
+        NodeID nodes_begin;
+        NodeID nodes_end;
+        std::vector<EnteringRoad> roads;
+        std::vector<ExpandedTurn> turns;
+    };
+    using EdgeExpansionBufferPtr = std::shared_ptr<EdgeExpansionBuffer>;
 
-                const auto incoming_edge = m_node_based_graph->FindEdge(
-                    node_along_road_entering, node_at_center_of_intersection);
+    const NodeID number_of_nodes = m_node_based_graph->GetNumberOfNodes();
+    const constexpr NodeID GRAINSIZE = 100;
+    NodeID next_node = 0;
 
-                if (m_node_based_graph->GetEdgeData(incoming_edge).reversed)
-                    continue;
+    const auto generate_node_ranges = tbb::make_filter<void, EdgeExpansionBufferPtr>(
+        tbb::filter::serial_in_order, [&](tbb::flow_control &flow_control) {
+            if (next_node >= number_of_nodes)
+            {
+                flow_control.stop();
+                return EdgeExpansionBufferPtr{};
+            }
+            auto buffer = std::make_shared<EdgeExpansionBuffer>();
+            buffer->nodes_begin = next_node;
+            buffer->nodes_end = std::min(number_of_nodes, next_node + GRAINSIZE);
+            next_node = buffer->nodes_end;
+            return buffer;
+        });
+
+    const auto compute_intersections = tbb::make_filter<EdgeExpansionBufferPtr,
+                                                        EdgeExpansionBufferPtr>(
+        tbb::filter::parallel, [&](EdgeExpansionBufferPtr buffer) {
+            // going over all nodes (which form the center of an intersection), we compute all
+            // possible turns along these intersections.
+            for (const auto node_at_center_of_intersection :
+                 util::irange(buffer->nodes_begin, buffer->nodes_end))
+            {
+                const auto shape_result =
+                    turn_analysis.ComputeIntersectionShapes(node_at_center_of_intersection);
+
+                // all nodes in the graph are connected in both directions. We check all outgoing
+                // nodes to find the incoming edge. This is a larger search overhead, but the cost
+                // we need to pay to generate edges here is worth the additional search overhead.
+                //
+                // a -> b <-> c
+                //      |
+                //      v
+                //      d
+                //
+                // will have:
+                // a: b,rev=0
+                // b: a,rev=1 c,rev=0 d,rev=0
+                // c: b,rev=0
+                //
+                // From the flags alone, we cannot determine which nodes are connected to `b` by
+                // an outgoing edge. Therefore, we have to search all connected edges for edges
+                // entering `b`
+                for (const EdgeID outgoing_edge :
+                     m_node_based_graph->GetAdjacentEdgeRange(node_at_center_of_intersection))
+                {
+                    const NodeID node_along_road_entering =
+                        m_node_based_graph->GetTarget(outgoing_edge);
 
-                ++node_based_edge_counter;
+                    const auto incoming_edge = m_node_based_graph->FindEdge(
+                        node_along_road_entering, node_at_center_of_intersection);
 
-                auto intersection_with_flags_and_angles =
-                    turn_analysis.GetIntersectionGenerator().TransformIntersectionShapeIntoView(
-                        node_along_road_entering,
-                        incoming_edge,
-                        shape_result.annotated_normalized_shape.normalized_shape,
-                        shape_result.intersection_shape,
-                        shape_result.annotated_normalized_shape.performed_merges);
+                    if (m_node_based_graph->GetEdgeData(incoming_edge).reversed)
+                        continue;
 
-                auto intersection = turn_analysis.AssignTurnTypes(
-                    node_along_road_entering, incoming_edge, intersection_with_flags_and_angles);
+                    auto intersection_with_flags_and_angles =
+                        turn_analysis.GetIntersectionGenerator()
+                            .TransformIntersectionShapeIntoView(
+                                node_along_road_entering,
+                                incoming_edge,
+                                shape_result.annotated_normalized_shape.normalized_shape,
+                                shape_result.intersection_shape,
+                                shape_result.annotated_normalized_shape.performed_merges);
+
+                    auto intersection =
+                        turn_analysis.AssignTurnTypes(node_along_road_entering,
+                                                      incoming_edge,
+                                                      intersection_with_flags_and_angles);
+
+                    OSRM_ASSERT(intersection.valid(),
+                                m_coordinates[node_at_center_of_intersection]);
+
+                    EnteringRoad road;
+                    road.node_at_center_of_intersection = node_at_center_of_intersection;
+                    road.node_along_road_entering = node_along_road_entering;
+                    road.incoming_edge = incoming_edge;
+                    road.intersection = std::move(intersection);
+                    buffer->roads.push_back(std::move(road));
+                }
+            }
+            return buffer;
+        });
 
-                OSRM_ASSERT(intersection.valid(), m_coordinates[node_at_center_of_intersection]);
+    const auto assign_turn_lanes = tbb::make_filter<EdgeExpansionBufferPtr, EdgeExpansionBufferPtr>(
+        tbb::filter::serial_in_order, [&](EdgeExpansionBufferPtr buffer) {
+            for (auto &road : buffer->roads)
+            {
+                road.intersection =
+                    turn_lane_handler.assignTurnLanes(road.node_along_road_entering,
+                                                      road.incoming_edge,
+                                                      std::move(road.intersection));
+            }
+            return buffer;
+        });
 
-                intersection = turn_lane_handler.assignTurnLanes(
-                    node_along_road_entering, incoming_edge, std::move(intersection));
+    const auto compute_turns = tbb::make_filter<EdgeExpansionBufferPtr, EdgeExpansionBufferPtr>(
+        tbb::filter::parallel, [&](EdgeExpansionBufferPtr buffer) {
+            std::vector<ExtractionTurn> extracted_turns;
+            for (auto &road : buffer->roads)
+            {
+                const auto &intersection = road.intersection;
+                const auto incoming_edge = road.incoming_edge;
+                const EdgeData &edge_data1 = m_node_based_graph->GetEdgeData(incoming_edge);
 
                 // the entry class depends on the turn, so we have to classify the interesction for
                 // every edge
-                const auto turn_classification = classifyIntersection(intersection);
+                std::tie(road.entry_class, road.bearing_class) = classifyIntersection(intersection);
 
-                const auto entry_class_id = [&](const util::guidance::EntryClass entry_class) {
-                    if (0 == entry_class_hash.count(entry_class))
-                    {
-                        const auto id = static_cast<std::uint16_t>(entry_class_hash.size());
-                        entry_class_hash[entry_class] = id;
-                        return id;
-                    }
-                    else
-                    {
-                        return entry_class_hash.find(entry_class)->second;
-                    }
-                }(turn_classification.first);
+                // compute weight and duration penalties of all turns with a single profile call
+                const auto is_traffic_light =
+                    m_traffic_lights.count(road.node_at_center_of_intersection);
+                extracted_turns.clear();
+                for (const auto &turn : intersection)
+                {
+                    // only keep valid turns
+                    if (!turn.entry_allowed)
+                        continue;
 
-                const auto bearing_class_id =
-                    [&](const util::guidance::BearingClass bearing_class) {
-                        if (0 == bearing_class_hash.count(bearing_class))
-                        {
-                            const auto id = static_cast<std::uint32_t>(bearing_class_hash.size());
-                            bearing_class_hash[bearing_class] = id;
-                            return id;
-                        }
-                        else
-                        {
-                            return bearing_class_hash.find(bearing_class)->second;
-                        }
-                    }(turn_classification.second);
-                bearing_class_by_node_based_node[node_at_center_of_intersection] = bearing_class_id;
+                    const EdgeData &edge_data2 = m_node_based_graph->GetEdgeData(turn.eid);
+                    ExtractionTurn extracted_turn(turn, is_traffic_light);
+                    extracted_turn.source_restricted = edge_data1.restricted;
+                    extracted_turn.target_restricted = edge_data2.restricted;
+                    extracted_turns.push_back(std::move(extracted_turn));
+                }
+                scripting_environment.ProcessTurns(extracted_turns);
 
+                road.turns_begin = buffer->turns.size();
+                auto extracted_turn = extracted_turns.begin();
                 for (const auto &turn : intersection)
                 {
                     // only keep valid turns
@@ -464,59 +547,24 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                         continue;
 
                     // only add an edge if turn is not prohibited
-                    const EdgeData &edge_data1 = m_node_based_graph->GetEdgeData(incoming_edge);
                     const EdgeData &edge_data2 = m_node_based_graph->GetEdgeData(turn.eid);
 
                     BOOST_ASSERT(edge_data1.edge_id != edge_data2.edge_id);
                     BOOST_ASSERT(!edge_data1.reversed);
                     BOOST_ASSERT(!edge_data2.reversed);
 
-                    // the following is the core of the loop.
-                    turn_data_container.push_back(
-                        turn.instruction,
-                        turn.lane_data_id,
-                        entry_class_id,
-                        util::guidance::TurnBearing(intersection[0].bearing),
-                        util::guidance::TurnBearing(turn.bearing));
-
-                    // compute weight and duration penalties
-                    auto is_traffic_light = m_traffic_lights.count(node_at_center_of_intersection);
-                    ExtractionTurn extracted_turn(turn, is_traffic_light);
-                    extracted_turn.source_restricted = edge_data1.restricted;
-                    extracted_turn.target_restricted = edge_data2.restricted;
-                    scripting_environment.ProcessTurn(extracted_turn);
-
                     // turn penalties are limited to [-2^15, 2^15) which roughly
                     // translates to 54 minutes and fits signed 16bit deci-seconds
+                    BOOST_ASSERT(extracted_turn != extracted_turns.end());
                     auto weight_penalty =
-                        boost::numeric_cast<TurnPenalty>(extracted_turn.weight * weight_multiplier);
+                        boost::numeric_cast<TurnPenalty>(extracted_turn->weight * weight_multiplier);
                     auto duration_penalty =
-                        boost::numeric_cast<TurnPenalty>(extracted_turn.duration * 10.);
+                        boost::numeric_cast<TurnPenalty>(extracted_turn->duration * 10.);
+                    ++extracted_turn;
 
                     BOOST_ASSERT(SPECIAL_NODEID != edge_data1.edge_id);
                     BOOST_ASSERT(SPECIAL_NODEID != edge_data2.edge_id);
 
-                    // NOTE: potential overflow here if we hit 2^32 routable edges
-                    BOOST_ASSERT(m_edge_based_edge_list.size() <=
-                                 std::numeric_limits<NodeID>::max());
-                    auto turn_id = m_edge_based_edge_list.size();
-                    auto weight =
-                        boost::numeric_cast<EdgeWeight>(edge_data1.weight + weight_penalty);
-                    auto duration =
-                        boost::numeric_cast<EdgeWeight>(edge_data1.duration + duration_penalty);
-                    m_edge_based_edge_list.emplace_back(edge_data1.edge_id,
-                                                        edge_data2.edge_id,
-                                                        turn_id,
-                                                        weight,
-                                                        duration,
-                                                        true,
-                                                        false);
-
-                    BOOST_ASSERT(turn_weight_penalties.size() == turn_id);
-                    turn_weight_penalties.push_back(weight_penalty);
-                    BOOST_ASSERT(turn_duration_penalties.size() == turn_id);
-                    turn_duration_penalties.push_back(duration_penalty);
-
                     // We write out the mapping between the edge-expanded edges and the
                     // original nodes. Since each edge represents a possible maneuver, external
                     // programs can use this to quickly perform updates to edge weights in order
@@ -530,19 +578,117 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                     const bool isTrivial = m_compressed_edge_container.IsTrivial(incoming_edge);
 
                     const auto &from_node =
-                        isTrivial ? node_along_road_entering
+                        isTrivial ? road.node_along_road_entering
                                   : m_compressed_edge_container.GetLastEdgeSourceID(incoming_edge);
                     const auto &via_node =
                         m_compressed_edge_container.GetLastEdgeTargetID(incoming_edge);
                     const auto &to_node =
                         m_compressed_edge_container.GetFirstEdgeTargetID(turn.eid);
 
-                    lookup::TurnIndexBlock turn_index_block = {from_node, via_node, to_node};
-
-                    turn_penalties_index_file.WriteOne(turn_index_block);
+                    ExpandedTurn expanded_turn;
+                    expanded_turn.instruction = turn.instruction;
+                    expanded_turn.lane_data_id = turn.lane_data_id;
+                    expanded_turn.pre_turn_bearing =
+                        util::guidance::TurnBearing(intersection[0].bearing);
+                    expanded_turn.post_turn_bearing = util::guidance::TurnBearing(turn.bearing);
+                    expanded_turn.source = edge_data1.edge_id;
+                    expanded_turn.target = edge_data2.edge_id;
+                    expanded_turn.weight =
+                        boost::numeric_cast<EdgeWeight>(edge_data1.weight + weight_penalty);
+                    expanded_turn.duration =
+                        boost::numeric_cast<EdgeWeight>(edge_data1.duration + duration_penalty);
+                    expanded_turn.weight_penalty = weight_penalty;
+                    expanded_turn.duration_penalty = duration_penalty;
+                    expanded_turn.turn_index_block = {from_node, via_node, to_node};
+                    buffer->turns.push_back(expanded_turn);
                 }
+                road.turns_end = buffer->turns.size();
+
+                // the turns hold everything that is needed from the intersection
+                road.intersection.clear();
+                road.intersection.shrink_to_fit();
             }
-        }
+            return buffer;
+        });
+
+    {
+        util::UnbufferedLog log;
+        util::Percent progress(log, number_of_nodes);
+
+        const auto write_turns = tbb::make_filter<EdgeExpansionBufferPtr, void>(
+            tbb::filter::serial_in_order, [&](EdgeExpansionBufferPtr buffer) {
+                for (const auto &road : buffer->roads)
+                {
+                    ++node_based_edge_counter;
+
+                    const auto entry_class_id = [&](const util::guidance::EntryClass entry_class) {
+                        if (0 == entry_class_hash.count(entry_class))
+                        {
+                            const auto id = static_cast<std::uint16_t>(entry_class_hash.size());
+                            entry_class_hash[entry_class] = id;
+                            return id;
+                        }
+                        else
+                        {
+                            return entry_class_hash.find(entry_class)->second;
+                        }
+                    }(road.entry_class);
+
+                    const auto bearing_class_id =
+                        [&](const util::guidance::BearingClass bearing_class) {
+                            if (0 == bearing_class_hash.count(bearing_class))
+                            {
+                                const auto id =
+                                    static_cast<std::uint32_t>(bearing_class_hash.size());
+                                bearing_class_hash[bearing_class] = id;
+                                return id;
+                            }
+                            else
+                            {
+                                return bearing_class_hash.find(bearing_class)->second;
+                            }
+                        }(road.bearing_class);
+                    bearing_class_by_node_based_node[road.node_at_center_of_intersection] =
+                        bearing_class_id;
+
+                    for (const auto turn_index : util::irange(road.turns_begin, road.turns_end))
+                    {
+                        const auto &turn = buffer->turns[turn_index];
+
+                        // the following is the core of the loop.
+                        turn_data_container.push_back(turn.instruction,
+                                                      turn.lane_data_id,
+                                                      entry_class_id,
+                                                      turn.pre_turn_bearing,
+                                                      turn.post_turn_bearing);
+
+                        // NOTE: potential overflow here if we hit 2^32 routable edges
+                        BOOST_ASSERT(m_edge_based_edge_list.size() <=
+                                     std::numeric_limits<NodeID>::max());
+                        auto turn_id = m_edge_based_edge_list.size();
+                        m_edge_based_edge_list.emplace_back(turn.source,
+                                                            turn.target,
+                                                            turn_id,
+                                                            turn.weight,
+                                                            turn.duration,
+                                                            true,
+                                                            false);
+
+                        BOOST_ASSERT(turn_weight_penalties.size() == turn_id);
+                        turn_weight_penalties.push_back(turn.weight_penalty);
+                        BOOST_ASSERT(turn_duration_penalties.size() == turn_id);
+                        turn_duration_penalties.push_back(turn.duration_penalty);
+
+                        turn_penalties_index_file.WriteOne(turn.turn_index_block);
+                    }
+                }
+                progress.PrintStatus(buffer->nodes_end);
+            });
+
+        // Every buffer in flight holds the intersections of GRAINSIZE nodes
+        tbb::parallel_pipeline(tbb::task_scheduler_init::default_num_threads() * 4,
+                               generate_node_ranges & compute_intersections & assign_turn_lanes &
+                                   compute_turns & write_turns);
     }
 
     // write weight penalties per turn
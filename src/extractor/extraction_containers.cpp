@@ -8,6 +8,7 @@
 
 #include "util/exception.hpp"
 #include "util/exception_utils.hpp"
+#include "util/external_sort.hpp"
 #include "util/fingerprint.hpp"
 #include "util/log.hpp"
 #include "util/name_table.hpp"
@@ -21,27 +22,16 @@
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/ref.hpp>
 
-#include <stxxl/sort>
-
 #include <chrono>
 #include <limits>
-#include <mutex>
+#include <functional>
 #include <sstream>
+#include <vector>
 
 namespace
 {
 namespace oe = osrm::extractor;
 
-// Needed for STXXL comparison - STXXL requires max_value(), min_value(), so we can not use
-// std::less<OSMNodeId>{}. Anonymous namespace to keep translation unit local.
-struct OSMNodeIDSTXXLLess
-{
-    using value_type = OSMNodeID;
-    bool operator()(const value_type left, const value_type right) const { return left < right; }
-    value_type max_value() { return MAX_OSM_NODEID; }
-    value_type min_value() { return MIN_OSM_NODEID; }
-};
-
 struct CmpEdgeByOSMStartID
 {
     using value_type = oe::InternalExtractorEdge;
@@ -49,9 +39,6 @@ struct CmpEdgeByOSMStartID
     {
         return lhs.result.osm_source_id < rhs.result.osm_source_id;
     }
-
-    value_type max_value() { return value_type::max_osm_value(); }
-    value_type min_value() { return value_type::min_osm_value(); }
 };
 
 struct CmpEdgeByOSMTargetID
@@ -61,9 +48,6 @@ struct CmpEdgeByOSMTargetID
     {
         return lhs.result.osm_target_id < rhs.result.osm_target_id;
     }
-
-    value_type max_value() { return value_type::max_osm_value(); }
-    value_type min_value() { return value_type::min_osm_value(); }
 };
 
 struct CmpEdgeByInternalSourceTargetAndName
@@ -92,21 +76,17 @@ struct CmpEdgeByInternalSourceTargetAndName
         if (rhs.result.name_id == EMPTY_NAMEID)
             return true;
 
-        std::lock_guard<std::mutex> lock(mutex);
         BOOST_ASSERT(!name_offsets.empty() && name_offsets.back() == name_data.size());
-        const oe::ExtractionContainers::STXXLNameCharData::const_iterator data = name_data.begin();
+        const auto data = name_data.begin();
         return std::lexicographical_compare(data + name_offsets[lhs.result.name_id],
                                             data + name_offsets[lhs.result.name_id + 1],
                                             data + name_offsets[rhs.result.name_id],
                                             data + name_offsets[rhs.result.name_id + 1]);
     }
 
-    value_type max_value() { return value_type::max_internal_value(); }
-    value_type min_value() { return value_type::min_internal_value(); }
-
-    std::mutex &mutex;
-    const oe::ExtractionContainers::STXXLNameCharData &name_data;
-    const oe::ExtractionContainers::STXXLNameOffsets &name_offsets;
+    // in memory copies, the external vectors can not be accessed concurrently
+    const std::vector<unsigned char> &name_data;
+    const std::vector<unsigned> &name_offsets;
 };
 }
 
@@ -115,7 +95,8 @@ namespace osrm
 namespace extractor
 {
 
-ExtractionContainers::ExtractionContainers()
+ExtractionContainers::ExtractionContainers(util::ExternalSortConfig sort_config)
+    : sort_config(std::move(sort_config))
 {
     // Check if stxxl can be instantiated
     stxxl::vector<unsigned> dummy_vector;
@@ -189,8 +170,10 @@ void ExtractionContainers::PrepareNodes()
         util::UnbufferedLog log;
         log << "Sorting used nodes        ... " << std::flush;
         TIMER_START(sorting_used_nodes);
-        stxxl::sort(
-            used_node_id_list.begin(), used_node_id_list.end(), OSMNodeIDSTXXLLess(), stxxl_memory);
+        util::externalSort(used_node_id_list.begin(),
+                           used_node_id_list.end(),
+                           std::less<OSMNodeID>(),
+                           sort_config);
         TIMER_STOP(sorting_used_nodes);
         log << "ok, after " << TIMER_SEC(sorting_used_nodes) << "s";
     }
@@ -209,10 +192,10 @@ void ExtractionContainers::PrepareNodes()
         util::UnbufferedLog log;
         log << "Sorting all nodes         ... " << std::flush;
         TIMER_START(sorting_nodes);
-        stxxl::sort(all_nodes_list.begin(),
-                    all_nodes_list.end(),
-                    ExternalMemoryNodeSTXXLCompare(),
-                    stxxl_memory);
+        util::externalSort(all_nodes_list.begin(),
+                           all_nodes_list.end(),
+                           ExternalMemoryNodeSTXXLCompare(),
+                           sort_config);
         TIMER_STOP(sorting_nodes);
         log << "ok, after " << TIMER_SEC(sorting_nodes) << "s";
     }
@@ -269,8 +252,8 @@ void ExtractionContainers::PrepareEdges(ScriptingEnvironment &scripting_environm
         util::UnbufferedLog log;
         log << "Sorting edges by start    ... " << std::flush;
         TIMER_START(sort_edges_by_start);
-        stxxl::sort(
-            all_edges_list.begin(), all_edges_list.end(), CmpEdgeByOSMStartID(), stxxl_memory);
+        util::externalSort(
+            all_edges_list.begin(), all_edges_list.end(), CmpEdgeByOSMStartID(), sort_config);
         TIMER_STOP(sort_edges_by_start);
         log << "ok, after " << TIMER_SEC(sort_edges_by_start) << "s";
     }
@@ -340,8 +323,8 @@ void ExtractionContainers::PrepareEdges(ScriptingEnvironment &scripting_environm
         util::UnbufferedLog log;
         log << "Sorting edges by target   ... " << std::flush;
         TIMER_START(sort_edges_by_target);
-        stxxl::sort(
-            all_edges_list.begin(), all_edges_list.end(), CmpEdgeByOSMTargetID(), stxxl_memory);
+        util::externalSort(
+            all_edges_list.begin(), all_edges_list.end(), CmpEdgeByOSMTargetID(), sort_config);
         TIMER_STOP(sort_edges_by_target);
         log << "ok, after " << TIMER_SEC(sort_edges_by_target) << "s";
     }
@@ -442,12 +425,12 @@ void ExtractionContainers::PrepareEdges(ScriptingEnvironment &scripting_environm
         util::UnbufferedLog log;
         log << "Sorting edges by renumbered start ... ";
         TIMER_START(sort_edges_by_renumbered_start);
-        std::mutex name_data_mutex;
-        stxxl::sort(
-            all_edges_list.begin(),
-            all_edges_list.end(),
-            CmpEdgeByInternalSourceTargetAndName{name_data_mutex, name_char_data, name_offsets},
-            stxxl_memory);
+        const std::vector<unsigned char> name_data(name_char_data.begin(), name_char_data.end());
+        const std::vector<unsigned> offsets(name_offsets.begin(), name_offsets.end());
+        util::externalSort(all_edges_list.begin(),
+                           all_edges_list.end(),
+                           CmpEdgeByInternalSourceTargetAndName{name_data, offsets},
+                           sort_config);
         TIMER_STOP(sort_edges_by_renumbered_start);
         log << "ok, after " << TIMER_SEC(sort_edges_by_renumbered_start) << "s";
     }
@@ -671,10 +654,10 @@ void ExtractionContainers::PrepareRestrictions()
         util::UnbufferedLog log;
         log << "Sorting used ways         ... ";
         TIMER_START(sort_ways);
-        stxxl::sort(way_start_end_id_list.begin(),
-                    way_start_end_id_list.end(),
-                    FirstAndLastSegmentOfWayStxxlCompare(),
-                    stxxl_memory);
+        util::externalSort(way_start_end_id_list.begin(),
+                           way_start_end_id_list.end(),
+                           FirstAndLastSegmentOfWayStxxlCompare(),
+                           sort_config);
         TIMER_STOP(sort_ways);
         log << "ok, after " << TIMER_SEC(sort_ways) << "s";
     }
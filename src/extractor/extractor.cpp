@@ -6,6 +6,7 @@
 #include "extractor/extraction_way.hpp"
 #include "extractor/extractor_callbacks.hpp"
 #include "extractor/files.hpp"
+#include "extractor/osm_change_applier.hpp"
 #include "extractor/raster_source.hpp"
 #include "extractor/restriction_parser.hpp"
 #include "extractor/scripting_environment.hpp"
@@ -19,6 +20,7 @@
 #include "util/log.hpp"
 #include "util/name_table.hpp"
 #include "util/range_table.hpp"
+#include "util/std_hash.hpp"
 #include "util/timing_util.hpp"
 
 #include "extractor/compressed_edge_container.hpp"
@@ -38,9 +40,13 @@
 
 #include <osmium/io/any_input.hpp>
 
+#include <tbb/blocked_range.h>
 #include <tbb/concurrent_vector.h>
+#include <tbb/parallel_for.h>
+#include <tbb/pipeline.h>
 #include <tbb/task_scheduler_init.h>
 
+#include <cstdint>
 #include <cstdlib>
 
 #include <algorithm>
@@ -52,6 +58,7 @@
 #include <iterator>
 #include <memory>
 #include <numeric> //partial_sum
+#include <string>
 #include <thread>
 #include <tuple>
 #include <type_traits>
@@ -91,6 +98,85 @@ transformTurnLaneMapIntoArrays(const guidance::LaneDescriptionMap &turn_lane_map
                   turn_lane_masks.begin() + turn_lane_offsets[entry->second]);
     return std::make_tuple(std::move(turn_lane_offsets), std::move(turn_lane_masks));
 }
+
+// Inverse of transformTurnLaneMapIntoArrays
+guidance::LaneDescriptionMap
+transformArraysIntoTurnLaneMap(const std::vector<std::uint32_t> &turn_lane_offsets,
+                               const std::vector<guidance::TurnLaneType::Mask> &turn_lane_masks)
+{
+    BOOST_ASSERT(turn_lane_offsets.size() >= 2);
+    guidance::LaneDescriptionMap turn_lane_map;
+    for (std::size_t id = 0; id + 2 < turn_lane_offsets.size(); ++id)
+    {
+        guidance::TurnLaneDescription description(
+            turn_lane_masks.begin() + turn_lane_offsets[id],
+            turn_lane_masks.begin() + turn_lane_offsets[id + 1]);
+        turn_lane_map[std::move(description)] = static_cast<LaneDescriptionID>(id);
+    }
+    return turn_lane_map;
+}
+
+// Keeps the segments that can be snapped to, the others are not added to the r-tree
+std::vector<EdgeBasedNodeSegment>
+filterSnappableSegments(std::vector<EdgeBasedNodeSegment> edge_based_node_segments,
+                        const std::vector<bool> &node_is_startpoint)
+{
+    BOOST_ASSERT(node_is_startpoint.size() == edge_based_node_segments.size());
+
+    // Filter node based edges based on startpoint
+    auto out_iter = edge_based_node_segments.begin();
+    auto in_iter = edge_based_node_segments.begin();
+    for (auto index : util::irange<std::size_t>(0UL, node_is_startpoint.size()))
+    {
+        BOOST_ASSERT(in_iter != edge_based_node_segments.end());
+        if (node_is_startpoint[index])
+        {
+            *out_iter = *in_iter;
+            out_iter++;
+        }
+        in_iter++;
+    }
+    auto new_size = out_iter - edge_based_node_segments.begin();
+    if (new_size == 0)
+    {
+        throw util::exception("There are no snappable edges left after processing.  Are you "
+                              "setting travel modes correctly in the profile?  Cannot continue." +
+                              SOURCE_REF);
+    }
+    edge_based_node_segments.resize(new_size);
+    return edge_based_node_segments;
+}
+
+// Hash of the options and the profile the parse stage depends on. Its inputs are checked by
+// their modification time.
+std::uint64_t hashParseConfig(const ExtractorConfig &config)
+{
+    std::string profile;
+    if (!config.profile_path.empty())
+    {
+        boost::filesystem::ifstream profile_stream(config.profile_path, std::ios::binary);
+        profile.assign(std::istreambuf_iterator<char>(profile_stream),
+                       std::istreambuf_iterator<char>());
+    }
+
+    auto seed = hash_val(config.input_path.string(),
+                         config.profile_path.string(),
+                         profile,
+                         config.use_metadata,
+                         config.parse_conditionals);
+    for (const auto &change_file : config.change_file_paths)
+    {
+        hash_combine(seed, change_file.string());
+    }
+    return seed;
+}
+
+// The expand stage uses the profile again and the options of the graph generation
+std::uint64_t hashExpandConfig(const ExtractorConfig &config)
+{
+    return hash_val(
+        hashParseConfig(config), config.small_component_size, config.generate_edge_lookup);
+}
 } // namespace
 
 /**
@@ -121,78 +207,234 @@ int Extractor::run(ScriptingEnvironment &scripting_environment)
     tbb::task_scheduler_init init(number_of_threads ? number_of_threads
                                                     : tbb::task_scheduler_init::automatic);
 
-    auto turn_restrictions = ParseOSMData(scripting_environment, number_of_threads);
-
-    // Transform the node-based graph that OSM is based on into an edge-based graph
-    // that is better for routing.  Every edge becomes a node, and every valid
-    // movement (e.g. turn from A->B, and B->A) becomes an edge
-    util::Log() << "Generating edge-expanded graph representation";
-
-    TIMER_START(expansion);
-
-    EdgeBasedNodeDataContainer edge_based_nodes_container;
-    std::vector<EdgeBasedNodeSegment> edge_based_node_segments;
-    util::DeallocatingVector<EdgeBasedEdge> edge_based_edge_list;
-    std::vector<bool> node_is_startpoint;
-    std::vector<EdgeWeight> edge_based_node_weights;
-    std::vector<util::Coordinate> coordinates;
-    extractor::PackedOSMIDs osm_node_ids;
+    // A requested stage is skipped on resume if its checkpoint was written with the same options,
+    // is newer than all its inputs and all outputs of the stage still exist
+    const auto needsRun = [this](const ExtractorConfig::Stage stage,
+                                 const std::string &checkpoint_path,
+                                 const std::uint64_t config_hash,
+                                 const std::vector<boost::filesystem::path> &inputs,
+                                 const std::vector<std::string> &outputs) {
+        if (!config.HasStage(stage))
+            return false;
+        if (!config.resume || !boost::filesystem::exists(checkpoint_path))
+            return true;
+
+        if (files::readCheckpointConfigHash(checkpoint_path) != config_hash)
+        {
+            util::Log() << "Running stage, " << checkpoint_path
+                        << " was written with different options";
+            return true;
+        }
 
-    auto graph_size = BuildEdgeExpandedGraph(scripting_environment,
-                                             coordinates,
-                                             osm_node_ids,
-                                             edge_based_nodes_container,
-                                             edge_based_node_segments,
-                                             node_is_startpoint,
-                                             edge_based_node_weights,
-                                             edge_based_edge_list,
-                                             config.intersection_class_data_output_path,
-                                             turn_restrictions);
+        const auto missing_output =
+            std::find_if(outputs.begin(), outputs.end(), [](const std::string &output) {
+                return !boost::filesystem::exists(output);
+            });
+        if (missing_output != outputs.end())
+        {
+            util::Log() << "Running stage, " << *missing_output << " is missing";
+            return true;
+        }
 
-    auto number_of_node_based_nodes = graph_size.first;
-    auto max_edge_id = graph_size.second;
+        const auto checkpoint_time = boost::filesystem::last_write_time(checkpoint_path);
+        const auto outdated = std::any_of(inputs.begin(), inputs.end(), [&](const auto &input) {
+            return !boost::filesystem::exists(input) ||
+                   boost::filesystem::last_write_time(input) > checkpoint_time;
+        });
+        if (!outdated)
+        {
+            util::Log() << "Skipping stage, " << checkpoint_path << " is up to date";
+        }
+        return outdated;
+    };
 
-    TIMER_STOP(expansion);
+    const auto requireCheckpoint = [](const std::string &checkpoint_path,
+                                      const std::uint64_t config_hash) {
+        if (!boost::filesystem::exists(checkpoint_path))
+        {
+            throw util::exception("Checkpoint " + checkpoint_path +
+                                  " not found, run the stage that writes it first" + SOURCE_REF);
+        }
+        if (files::readCheckpointConfigHash(checkpoint_path) != config_hash)
+        {
+            throw util::exception("Checkpoint " + checkpoint_path +
+                                  " was written with different options, run the stage that "
+                                  "writes it again" +
+                                  SOURCE_REF);
+        }
+    };
 
-    util::Log() << "Saving edge-based node weights to file.";
-    TIMER_START(timer_write_node_weights);
+    const auto parse_config_hash = hashParseConfig(config);
+    const auto expand_config_hash = hashExpandConfig(config);
+
+    std::vector<boost::filesystem::path> parse_inputs{config.input_path, config.profile_path};
+    parse_inputs.insert(
+        parse_inputs.end(), config.change_file_paths.begin(), config.change_file_paths.end());
+
+    bool parsed = false;
+    std::vector<TurnRestriction> turn_restrictions;
+    if (needsRun(ExtractorConfig::Stage::Parse,
+                 config.parse_checkpoint_path,
+                 parse_config_hash,
+                 parse_inputs,
+                 {config.output_file_name,
+                  config.restriction_file_name,
+                  config.names_file_name,
+                  config.timestamp_file_name,
+                  config.profile_properties_output_path}))
     {
-        storage::io::FileWriter writer(config.edge_based_node_weights_output_path,
-                                       storage::io::FileWriter::GenerateFingerprint);
-        storage::serialization::write(writer, edge_based_node_weights);
-    }
-    TIMER_STOP(timer_write_node_weights);
-    util::Log() << "Done writing. (" << TIMER_SEC(timer_write_node_weights) << ")";
+        turn_restrictions = ParseOSMData(scripting_environment, number_of_threads);
 
-    util::Log() << "Computing strictly connected components ...";
-    FindComponents(
-        max_edge_id, edge_based_edge_list, edge_based_node_segments, edge_based_nodes_container);
+        if (config.WritesCheckpoints())
+        {
+            std::vector<std::uint32_t> turn_lane_offsets;
+            std::vector<guidance::TurnLaneType::Mask> turn_lane_masks;
+            std::tie(turn_lane_offsets, turn_lane_masks) =
+                transformTurnLaneMapIntoArrays(turn_lane_map);
+            files::writeParseCheckpoint(config.parse_checkpoint_path,
+                                        parse_config_hash,
+                                        turn_restrictions,
+                                        turn_lane_offsets,
+                                        turn_lane_masks);
+        }
+        parsed = true;
+    }
 
-    util::Log() << "Building r-tree ...";
-    TIMER_START(rtree);
-    BuildRTree(std::move(edge_based_node_segments), std::move(node_is_startpoint), coordinates);
+    bool expanded = false;
+    std::vector<EdgeBasedNodeSegment> snappable_segments;
+    std::vector<util::Coordinate> coordinates;
+    extractor::PackedOSMIDs osm_node_ids;
+    if (needsRun(ExtractorConfig::Stage::Expand,
+                 config.expand_checkpoint_path,
+                 expand_config_hash,
+                 {config.parse_checkpoint_path, config.profile_path},
+                 {config.edge_graph_output_path,
+                  config.edge_based_node_weights_output_path,
+                  config.node_based_nodes_data_path,
+                  config.edge_based_nodes_data_path,
+                  config.geometry_output_path,
+                  config.edge_output_path,
+                  config.compressed_node_based_graph_output_path,
+                  config.cnbg_ebg_graph_mapping_output_path,
+                  config.intersection_class_data_output_path,
+                  config.turn_lane_descriptions_file_name,
+                  config.turn_weight_penalties_path,
+                  config.turn_duration_penalties_path}))
+    {
+        if (!parsed)
+        {
+            requireCheckpoint(config.parse_checkpoint_path, parse_config_hash);
+            util::Log() << "Loading " << config.parse_checkpoint_path;
+
+            std::vector<std::uint32_t> turn_lane_offsets;
+            std::vector<guidance::TurnLaneType::Mask> turn_lane_masks;
+            files::readParseCheckpoint(config.parse_checkpoint_path,
+                                       turn_restrictions,
+                                       turn_lane_offsets,
+                                       turn_lane_masks);
+            turn_lane_map = transformArraysIntoTurnLaneMap(turn_lane_offsets, turn_lane_masks);
+        }
 
-    TIMER_STOP(rtree);
+        // Transform the node-based graph that OSM is based on into an edge-based graph
+        // that is better for routing.  Every edge becomes a node, and every valid
+        // movement (e.g. turn from A->B, and B->A) becomes an edge
+        util::Log() << "Generating edge-expanded graph representation";
+
+        TIMER_START(expansion);
+
+        EdgeBasedNodeDataContainer edge_based_nodes_container;
+        std::vector<EdgeBasedNodeSegment> edge_based_node_segments;
+        util::DeallocatingVector<EdgeBasedEdge> edge_based_edge_list;
+        std::vector<bool> node_is_startpoint;
+        std::vector<EdgeWeight> edge_based_node_weights;
+
+        auto graph_size = BuildEdgeExpandedGraph(scripting_environment,
+                                                 coordinates,
+                                                 osm_node_ids,
+                                                 edge_based_nodes_container,
+                                                 edge_based_node_segments,
+                                                 node_is_startpoint,
+                                                 edge_based_node_weights,
+                                                 edge_based_edge_list,
+                                                 config.intersection_class_data_output_path,
+                                                 turn_restrictions);
+
+        auto number_of_node_based_nodes = graph_size.first;
+        auto max_edge_id = graph_size.second;
+
+        TIMER_STOP(expansion);
+
+        util::Log() << "Saving edge-based node weights to file.";
+        TIMER_START(timer_write_node_weights);
+        {
+            storage::io::FileWriter writer(config.edge_based_node_weights_output_path,
+                                           storage::io::FileWriter::GenerateFingerprint);
+            storage::serialization::write(writer, edge_based_node_weights);
+        }
+        TIMER_STOP(timer_write_node_weights);
+        util::Log() << "Done writing. (" << TIMER_SEC(timer_write_node_weights) << ")";
+
+        util::Log() << "Computing strictly connected components ...";
+        FindComponents(max_edge_id,
+                       edge_based_edge_list,
+                       edge_based_node_segments,
+                       edge_based_nodes_container);
+
+        util::Log() << "Writing nodes for nodes-based and edges-based graphs ...";
+        files::writeNodes(config.node_based_nodes_data_path, coordinates, osm_node_ids);
+        files::writeNodeData(config.edge_based_nodes_data_path, edge_based_nodes_container);
+
+        util::Log() << "Writing edge-based-graph edges       ... " << std::flush;
+        TIMER_START(write_edges);
+        files::writeEdgeBasedGraph(
+            config.edge_graph_output_path, max_edge_id, edge_based_edge_list);
+        TIMER_STOP(write_edges);
+        util::Log() << "ok, after " << TIMER_SEC(write_edges) << "s";
+
+        util::Log() << "Processed " << edge_based_edge_list.size() << " edges";
+
+        const auto nodes_per_second =
+            static_cast<std::uint64_t>(number_of_node_based_nodes / TIMER_SEC(expansion));
+        const auto edges_per_second =
+            static_cast<std::uint64_t>((max_edge_id + 1) / TIMER_SEC(expansion));
+
+        util::Log() << "Expansion: " << nodes_per_second << " nodes/sec and " << edges_per_second
+                    << " edges/sec";
+
+        snappable_segments =
+            filterSnappableSegments(std::move(edge_based_node_segments), node_is_startpoint);
+        if (config.WritesCheckpoints())
+        {
+            files::writeExpandCheckpoint(
+                config.expand_checkpoint_path, expand_config_hash, snappable_segments);
+        }
+        expanded = true;
+    }
 
-    util::Log() << "Writing nodes for nodes-based and edges-based graphs ...";
-    files::writeNodes(config.node_based_nodes_data_path, coordinates, osm_node_ids);
-    files::writeNodeData(config.edge_based_nodes_data_path, edge_based_nodes_container);
+    if (config.HasStage(ExtractorConfig::Stage::RTree))
+    {
+        if (!expanded)
+        {
+            requireCheckpoint(config.expand_checkpoint_path, expand_config_hash);
+            util::Log() << "Loading " << config.expand_checkpoint_path;
 
-    util::Log() << "Writing edge-based-graph edges       ... " << std::flush;
-    TIMER_START(write_edges);
-    files::writeEdgeBasedGraph(config.edge_graph_output_path, max_edge_id, edge_based_edge_list);
-    TIMER_STOP(write_edges);
-    util::Log() << "ok, after " << TIMER_SEC(write_edges) << "s";
+            files::readExpandCheckpoint(config.expand_checkpoint_path, snappable_segments);
+            files::readNodes(config.node_based_nodes_data_path, coordinates, osm_node_ids);
+        }
 
-    util::Log() << "Processed " << edge_based_edge_list.size() << " edges";
+        util::Log() << "Building r-tree ...";
+        TIMER_START(rtree);
+        BuildRTree(std::move(snappable_segments), coordinates);
+        TIMER_STOP(rtree);
 
-    const auto nodes_per_second =
-        static_cast<std::uint64_t>(number_of_node_based_nodes / TIMER_SEC(expansion));
-    const auto edges_per_second =
-        static_cast<std::uint64_t>((max_edge_id + 1) / TIMER_SEC(expansion));
+        // the last stage is done, nothing needs to be resumed anymore
+        if (!config.keep_checkpoints)
+        {
+            boost::filesystem::remove(config.parse_checkpoint_path);
+            boost::filesystem::remove(config.expand_checkpoint_path);
+        }
+    }
 
-    util::Log() << "Expansion: " << nodes_per_second << " nodes/sec and " << edges_per_second
-                << " edges/sec";
     util::Log() << "To prepare the data for routing, run: "
                 << "./osrm-contract " << config.output_file_name;
 
@@ -214,7 +456,10 @@ std::vector<TurnRestriction> Extractor::ParseOSMData(ScriptingEnvironment &scrip
     const osmium::io::File input_file(config.input_path.string());
 
     osmium::io::Reader reader(
-        input_file, (config.use_metadata ? osmium::io::read_meta::yes : osmium::io::read_meta::no));
+        input_file,
+        // changes are only applied to objects of an older version
+        (config.use_metadata || !config.change_file_paths.empty() ? osmium::io::read_meta::yes
+                                                                   : osmium::io::read_meta::no));
 
     const osmium::io::Header header = reader.header();
 
@@ -225,7 +470,12 @@ std::vector<TurnRestriction> Extractor::ParseOSMData(ScriptingEnvironment &scrip
     util::Log() << "Parsing in progress..";
     TIMER_START(parsing);
 
-    ExtractionContainers extraction_containers;
+    util::ExternalSortConfig sort_config;
+    sort_config.memory_budget = config.sort_memory * 1024 * 1024;
+    // sorted runs are stored next to the output files
+    sort_config.temporary_directory =
+        boost::filesystem::absolute(config.output_file_name).parent_path();
+    ExtractionContainers extraction_containers(sort_config);
     auto extractor_callbacks = std::make_unique<ExtractorCallbacks>(
         extraction_containers, scripting_environment.GetProfileProperties());
 
@@ -239,8 +489,32 @@ std::vector<TurnRestriction> Extractor::ParseOSMData(ScriptingEnvironment &scrip
     }
     util::Log() << "input file generated by " << generator;
 
-    // write .timestamp data file
-    std::string timestamp = header.get("osmosis_replication_timestamp");
+    std::unique_ptr<OSMChangeApplier> change_applier;
+    if (!config.change_file_paths.empty())
+    {
+        if (config.check_change_merge)
+        {
+            util::Log() << "Checking the merge of the input and the changes ...";
+            const auto number_of_differences =
+                checkChangeMerge(config.input_path, config.change_file_paths);
+            if (number_of_differences > 0)
+            {
+                throw util::exception(std::to_string(number_of_differences) +
+                                      " objects differ from an in-memory merge of the input and "
+                                      "the changes" +
+                                      SOURCE_REF);
+            }
+            util::Log() << "Merged input matches the in-memory merge";
+        }
+        change_applier = std::make_unique<OSMChangeApplier>(config.change_file_paths);
+    }
+
+    // write .timestamp data file, the data is as recent as the newest change file
+    std::string timestamp = change_applier ? change_applier->GetTimestamp() : std::string{};
+    if (timestamp.empty())
+    {
+        timestamp = header.get("osmosis_replication_timestamp");
+    }
     if (timestamp.empty())
     {
         timestamp = "n/a";
@@ -252,11 +526,6 @@ std::vector<TurnRestriction> Extractor::ParseOSMData(ScriptingEnvironment &scrip
 
     timestamp_file.WriteFrom(timestamp.c_str(), timestamp.length());
 
-    // initialize vectors holding parsed objects
-    tbb::concurrent_vector<std::pair<std::size_t, ExtractionNode>> resulting_nodes;
-    tbb::concurrent_vector<std::pair<std::size_t, ExtractionWay>> resulting_ways;
-    tbb::concurrent_vector<boost::optional<InputRestrictionContainer>> resulting_restrictions;
-
     std::vector<std::string> restrictions = scripting_environment.GetRestrictions();
     // setup restriction parser
     const RestrictionParser restriction_parser(
@@ -264,49 +533,148 @@ std::vector<TurnRestriction> Extractor::ParseOSMData(ScriptingEnvironment &scrip
         config.parse_conditionals,
         restrictions);
 
-    // create a vector of iterators into the buffer
-    for (std::vector<osmium::memory::Buffer::const_iterator> osm_elements;
-         const osmium::memory::Buffer buffer = reader.read();
-         osm_elements.clear())
+    // A buffer of OSM objects together with the parsed objects of the profile. It is handed
+    // through the stages of the parsing pipeline below.
+    struct ParsedBuffer
     {
-        for (auto iter = std::begin(buffer), end = std::end(buffer); iter != end; ++iter)
+        explicit ParsedBuffer(osmium::memory::Buffer buffer_) : buffer(std::move(buffer_))
         {
-            osm_elements.push_back(iter);
+            for (auto iter = buffer.cbegin(), end = buffer.cend(); iter != end; ++iter)
+            {
+                osm_elements.push_back(iter);
+            }
         }
 
-        // clear resulting vectors
-        resulting_nodes.clear();
-        resulting_ways.clear();
-        resulting_restrictions.clear();
-
-        scripting_environment.ProcessElements(osm_elements,
-                                              restriction_parser,
-                                              resulting_nodes,
-                                              resulting_ways,
-                                              resulting_restrictions);
+        osmium::memory::Buffer buffer;
+        std::vector<osmium::memory::Buffer::const_iterator> osm_elements;
+        tbb::concurrent_vector<std::pair<std::size_t, ExtractionNode>> resulting_nodes;
+        tbb::concurrent_vector<std::pair<std::size_t, ExtractionWay>> resulting_ways;
+        tbb::concurrent_vector<boost::optional<InputRestrictionContainer>> resulting_restrictions;
+        // interned names and turn lanes of resulting_ways
+        std::vector<ExtractorCallbacks::WayStrings> way_strings;
+    };
+    using ParsedBufferPtr = std::shared_ptr<ParsedBuffer>;
+
+    // Time spent in each stage. The processing stage runs for several buffers at once,
+    // so its time is summed over all buffers and can exceed the wall clock time.
+    std::chrono::steady_clock::duration reading_time{0};
+    std::atomic<std::chrono::steady_clock::rep> processing_time{0};
+    std::chrono::steady_clock::duration ingesting_time{0};
+
+    bool input_finished = false;
+
+    // Reading a buffer, processing it with the profile and handing the results to the
+    // callbacks are overlapped: while the callbacks ingest one buffer the next buffers are
+    // already decoded and processed. Reading and ingesting keep the order of the input.
+    const auto read_buffer = tbb::make_filter<void, ParsedBufferPtr>(
+        tbb::filter::serial_in_order, [&](tbb::flow_control &flow_control) {
+            const auto start = std::chrono::steady_clock::now();
+            osmium::memory::Buffer buffer;
+            // changes can remove all objects of a buffer, those buffers are skipped
+            while (!input_finished && !(buffer && buffer.committed() > 0))
+            {
+                buffer = reader.read();
+                if (!buffer)
+                {
+                    input_finished = true;
+                    if (change_applier)
+                    {
+                        // objects created after the last object of the input
+                        buffer = change_applier->Finish();
+                    }
+                }
+                else if (change_applier)
+                {
+                    buffer = change_applier->Apply(buffer);
+                }
+            }
+            if (!buffer || buffer.committed() == 0)
+            {
+                flow_control.stop();
+                return ParsedBufferPtr{};
+            }
+            auto parsed_buffer = std::make_shared<ParsedBuffer>(std::move(buffer));
+            reading_time += std::chrono::steady_clock::now() - start;
+            return parsed_buffer;
+        });
+
+    const auto process_buffer = tbb::make_filter<ParsedBufferPtr, ParsedBufferPtr>(
+        tbb::filter::parallel, [&](ParsedBufferPtr parsed_buffer) {
+            const auto start = std::chrono::steady_clock::now();
+            scripting_environment.ProcessElements(parsed_buffer->osm_elements,
+                                                  restriction_parser,
+                                                  parsed_buffer->resulting_nodes,
+                                                  parsed_buffer->resulting_ways,
+                                                  parsed_buffer->resulting_restrictions);
+
+            // The profile stores ways in the order they were processed. Restoring the input
+            // order makes the ids assigned on ingestion independent of the thread scheduling.
+            auto &resulting_ways = parsed_buffer->resulting_ways;
+            std::sort(resulting_ways.begin(),
+                      resulting_ways.end(),
+                      [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+
+            // Deduplicating the strings of the ways is the expensive part of ingesting them,
+            // so it is done here in parallel. Ingestion only assigns ids to new strings.
+            auto &way_strings = parsed_buffer->way_strings;
+            way_strings.resize(resulting_ways.size());
+            tbb::parallel_for(tbb::blocked_range<std::size_t>(0, resulting_ways.size()),
+                              [&](const tbb::blocked_range<std::size_t> &range) {
+                                  for (auto index = range.begin(); index != range.end(); ++index)
+                                  {
+                                      way_strings[index] = extractor_callbacks->InternWayStrings(
+                                          resulting_ways[index].second);
+                                  }
+                              });
+            processing_time += (std::chrono::steady_clock::now() - start).count();
+            return parsed_buffer;
+        });
+
+    const auto ingest_buffer = tbb::make_filter<ParsedBufferPtr, void>(
+        tbb::filter::serial_in_order, [&](ParsedBufferPtr parsed_buffer) {
+            const auto start = std::chrono::steady_clock::now();
+            const auto &osm_elements = parsed_buffer->osm_elements;
+
+            number_of_nodes += parsed_buffer->resulting_nodes.size();
+            // put parsed objects thru extractor callbacks
+            for (const auto &result : parsed_buffer->resulting_nodes)
+            {
+                extractor_callbacks->ProcessNode(
+                    static_cast<const osmium::Node &>(*(osm_elements[result.first])),
+                    result.second);
+            }
+            const auto &resulting_ways = parsed_buffer->resulting_ways;
+            number_of_ways += resulting_ways.size();
+            for (std::size_t index = 0; index < resulting_ways.size(); ++index)
+            {
+                extractor_callbacks->ProcessWay(
+                    static_cast<const osmium::Way &>(*(osm_elements[resulting_ways[index].first])),
+                    resulting_ways[index].second,
+                    parsed_buffer->way_strings[index]);
+            }
+            number_of_relations += parsed_buffer->resulting_restrictions.size();
+            for (const auto &result : parsed_buffer->resulting_restrictions)
+            {
+                extractor_callbacks->ProcessRestriction(result);
+            }
+            ingesting_time += std::chrono::steady_clock::now() - start;
+        });
+
+    // Every buffer in flight holds its decoded objects, so the number of buffers is limited
+    // to a few more than can be processed at the same time.
+    const auto max_buffers_in_flight = std::max(2u, number_of_threads + number_of_threads / 2);
+    tbb::parallel_pipeline(max_buffers_in_flight, read_buffer & process_buffer & ingest_buffer);
 
-        number_of_nodes += resulting_nodes.size();
-        // put parsed objects thru extractor callbacks
-        for (const auto &result : resulting_nodes)
-        {
-            extractor_callbacks->ProcessNode(
-                static_cast<const osmium::Node &>(*(osm_elements[result.first])), result.second);
-        }
-        number_of_ways += resulting_ways.size();
-        for (const auto &result : resulting_ways)
-        {
-            extractor_callbacks->ProcessWay(
-                static_cast<const osmium::Way &>(*(osm_elements[result.first])), result.second);
-        }
-        number_of_relations += resulting_restrictions.size();
-        for (const auto &result : resulting_restrictions)
-        {
-            extractor_callbacks->ProcessRestriction(result);
-        }
-    }
     TIMER_STOP(parsing);
     util::Log() << "Parsing finished after " << TIMER_SEC(parsing) << " seconds";
 
+    const auto to_seconds = [](const std::chrono::steady_clock::duration duration) {
+        return std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+    };
+    util::Log() << "Parsing stages: reading " << to_seconds(reading_time) << "s, processing "
+                << to_seconds(std::chrono::steady_clock::duration{processing_time})
+                << "s (summed over buffers), ingesting " << to_seconds(ingesting_time) << "s";
+
     util::Log() << "Raw input contains " << number_of_nodes << " nodes, " << number_of_ways
                 << " ways, and " << number_of_relations << " relations";
 
@@ -543,39 +911,14 @@ Extractor::BuildEdgeExpandedGraph(ScriptingEnvironment &scripting_environment,
 
     Saves tree into '.ramIndex' and leaves into '.fileIndex'.
  */
-void Extractor::BuildRTree(std::vector<EdgeBasedNodeSegment> edge_based_node_segments,
-                           std::vector<bool> node_is_startpoint,
+void Extractor::BuildRTree(std::vector<EdgeBasedNodeSegment> snappable_segments,
                            const std::vector<util::Coordinate> &coordinates)
 {
-    util::Log() << "Constructing r-tree of " << edge_based_node_segments.size()
+    util::Log() << "Constructing r-tree of " << snappable_segments.size()
                 << " segments build on-top of " << coordinates.size() << " coordinates";
 
-    BOOST_ASSERT(node_is_startpoint.size() == edge_based_node_segments.size());
-
-    // Filter node based edges based on startpoint
-    auto out_iter = edge_based_node_segments.begin();
-    auto in_iter = edge_based_node_segments.begin();
-    for (auto index : util::irange<std::size_t>(0UL, node_is_startpoint.size()))
-    {
-        BOOST_ASSERT(in_iter != edge_based_node_segments.end());
-        if (node_is_startpoint[index])
-        {
-            *out_iter = *in_iter;
-            out_iter++;
-        }
-        in_iter++;
-    }
-    auto new_size = out_iter - edge_based_node_segments.begin();
-    if (new_size == 0)
-    {
-        throw util::exception("There are no snappable edges left after processing.  Are you "
-                              "setting travel modes correctly in the profile?  Cannot continue." +
-                              SOURCE_REF);
-    }
-    edge_based_node_segments.resize(new_size);
-
     TIMER_START(construction);
-    util::StaticRTree<EdgeBasedNodeSegment> rtree(edge_based_node_segments,
+    util::StaticRTree<EdgeBasedNodeSegment> rtree(snappable_segments,
                                                   config.rtree_nodes_output_path,
                                                   config.rtree_leafs_output_path,
                                                   coordinates);
@@ -654,8 +997,15 @@ void Extractor::WriteCompressedNodeBasedGraph(const std::string &path,
     // Writes:  | Fingerprint | #e | #n | edges | coordinates |
     // - uint64: number of edges (from, to) pairs
     // - uint64: number of nodes and therefore also coordinates
-    // - (uint32_t, uint32_t): num_edges * edges
+    // - (uint32_t, uint32_t): num_edges * edges, grouped by source
     // - (int32_t, int32_t: num_nodes * coordinates (lon, lat)
+    //
+    // osrm-partition maps the file and uses the edges and coordinates in place, so all sections
+    // have to stay aligned and the edges have to be grouped by their source.
+    static_assert(sizeof(util::FingerPrint) % alignof(std::uint64_t) == 0,
+                  "the element counts need to be aligned");
+    static_assert(sizeof(util::Coordinate) == 2 * sizeof(std::int32_t),
+                  "coordinates need to be stored as (lon, lat) pairs");
 
     const auto num_edges = graph.GetNumberOfEdges();
     const auto num_nodes = graph.GetNumberOfNodes();
@@ -678,11 +1028,7 @@ void Extractor::WriteCompressedNodeBasedGraph(const std::string &path,
     }
 
     // FIXME this is unneccesary: We have this data
-    for (const auto &qnode : coordinates)
-    {
-        writer.WriteOne(qnode.lon);
-        writer.WriteOne(qnode.lat);
-    }
+    writer.WriteFrom(coordinates);
 }
 
 } // namespace extractor
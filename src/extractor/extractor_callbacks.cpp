@@ -33,6 +33,104 @@ namespace extractor
 using TurnLaneDescription = guidance::TurnLaneDescription;
 namespace TurnLaneType = guidance::TurnLaneType;
 
+namespace
+{
+TurnLaneDescription laneStringToDescription(const std::string &lane_string)
+{
+    if (lane_string.empty())
+        return {};
+
+    TurnLaneDescription lane_description;
+
+    typedef boost::tokenizer<boost::char_separator<char>> tokenizer;
+    boost::char_separator<char> sep("|", "", boost::keep_empty_tokens);
+    boost::char_separator<char> inner_sep(";", "");
+    tokenizer tokens(lane_string, sep);
+
+    const constexpr std::size_t num_osm_tags = 11;
+    const constexpr char *osm_lane_strings[num_osm_tags] = {"none",
+                                                            "through",
+                                                            "sharp_left",
+                                                            "left",
+                                                            "slight_left",
+                                                            "slight_right",
+                                                            "right",
+                                                            "sharp_right",
+                                                            "reverse",
+                                                            "merge_to_left",
+                                                            "merge_to_right"};
+
+    const constexpr TurnLaneType::Mask masks_by_osm_string[num_osm_tags + 1] = {
+        TurnLaneType::none,
+        TurnLaneType::straight,
+        TurnLaneType::sharp_left,
+        TurnLaneType::left,
+        TurnLaneType::slight_left,
+        TurnLaneType::slight_right,
+        TurnLaneType::right,
+        TurnLaneType::sharp_right,
+        TurnLaneType::uturn,
+        TurnLaneType::merge_to_left,
+        TurnLaneType::merge_to_right,
+        TurnLaneType::empty}; // fallback, if string not found
+
+    for (auto iter = tokens.begin(); iter != tokens.end(); ++iter)
+    {
+        tokenizer inner_tokens(*iter, inner_sep);
+        guidance::TurnLaneType::Mask lane_mask = inner_tokens.begin() == inner_tokens.end()
+                                                     ? TurnLaneType::none
+                                                     : TurnLaneType::empty;
+        for (auto token_itr = inner_tokens.begin(); token_itr != inner_tokens.end();
+             ++token_itr)
+        {
+            auto position =
+                std::find(osm_lane_strings, osm_lane_strings + num_osm_tags, *token_itr);
+            const auto translated_mask =
+                masks_by_osm_string[std::distance(osm_lane_strings, position)];
+            if (translated_mask == TurnLaneType::empty)
+            {
+                // if we have unsupported tags, don't handle them
+                util::Log(logDEBUG) << "Unsupported lane tag found: \"" << *token_itr << "\"";
+                return {};
+            }
+
+            // In case of multiple times the same lane indicators withn a lane, as in
+            // "left;left|.."  or-ing the masks generates a single "left" enum.
+            // Which is fine since this is data issue and we can't represent it anyway.
+            lane_mask |= translated_mask;
+        }
+        // add the lane to the description
+        lane_description.push_back(lane_mask);
+    }
+    return lane_description;
+}
+
+// Only true if the way is assigned a valid speed/duration and, if there is no duration fallback,
+// a valid rate/weight
+bool isRoutable(const ExtractionWay &parsed_way, const bool fallback_to_duration)
+{
+    if ((parsed_way.forward_travel_mode == TRAVEL_MODE_INACCESSIBLE ||
+         parsed_way.forward_speed <= 0) &&
+        (parsed_way.backward_travel_mode == TRAVEL_MODE_INACCESSIBLE ||
+         parsed_way.backward_speed <= 0) &&
+        parsed_way.duration <= 0)
+    {
+        return false;
+    }
+
+    if (!fallback_to_duration && (parsed_way.forward_travel_mode == TRAVEL_MODE_INACCESSIBLE ||
+                                  parsed_way.forward_rate <= 0) &&
+        (parsed_way.backward_travel_mode == TRAVEL_MODE_INACCESSIBLE ||
+         parsed_way.backward_rate <= 0) &&
+        parsed_way.weight <= 0)
+    {
+        return false;
+    }
+
+    return true;
+}
+}
+
 ExtractorCallbacks::ExtractorCallbacks(ExtractionContainers &extraction_containers_,
                                        const ProfileProperties &properties)
     : external_memory(extraction_containers_),
@@ -40,7 +138,7 @@ ExtractorCallbacks::ExtractorCallbacks(ExtractionContainers &extraction_containe
       force_split_edges(properties.force_split_edges)
 {
     // we reserved 0, 1, 2, 3 for the empty case
-    string_map[MapKey("", "", "", "")] = 0;
+    name_interner.Intern(MapKey("", "", "", ""), [] { return EMPTY_NAMEID; });
     lane_description_map[TurnLaneDescription()] = 0;
 }
 
@@ -74,6 +172,41 @@ void ExtractorCallbacks::ProcessRestriction(
         //                           "y" : "n");
     }
 }
+/**
+ * Deduplicates the names and turn lane strings of a way without assigning ids to them.
+ *
+ * This is thread-safe, so the expensive hashing and parsing of the strings can be done in
+ * parallel for all ways of a buffer, leaving only the id assignment to the serial ProcessWay.
+ */
+ExtractorCallbacks::WayStrings ExtractorCallbacks::InternWayStrings(const ExtractionWay &parsed_way)
+{
+    // ProcessWay discards these ways before looking at their strings
+    if (!isRoutable(parsed_way, fallback_to_duration))
+        return {nullptr, nullptr, nullptr};
+
+    const auto internLanes = [this](const std::string &lane_string) -> LaneInterner::Entry * {
+        if (lane_string.empty())
+            return nullptr;
+        return &lane_interner.Intern(lane_string, [&lane_string] {
+            return InternedLaneDescription{laneStringToDescription(lane_string),
+                                           INVALID_LANE_DESCRIPTIONID};
+        });
+    };
+
+    auto &name = name_interner.Intern(
+        MapKey(parsed_way.name, parsed_way.destinations, parsed_way.ref, parsed_way.pronunciation),
+        [] { return INVALID_NAMEID; });
+
+    return {&name,
+            internLanes(parsed_way.turn_lanes_forward),
+            internLanes(parsed_way.turn_lanes_backward)};
+}
+
+void ExtractorCallbacks::ProcessWay(const osmium::Way &input_way, const ExtractionWay &parsed_way)
+{
+    ProcessWay(input_way, parsed_way, InternWayStrings(parsed_way));
+}
+
 /**
  * Takes the geometry contained in the ```input_way``` and the tags computed
  * by the lua profile inside ```parsed_way``` and computes all edge segments.
@@ -83,25 +216,15 @@ void ExtractorCallbacks::ProcessRestriction(
  *
  * warning: caller needs to take care of synchronization!
  */
-void ExtractorCallbacks::ProcessWay(const osmium::Way &input_way, const ExtractionWay &parsed_way)
+void ExtractorCallbacks::ProcessWay(const osmium::Way &input_way,
+                                    const ExtractionWay &parsed_way,
+                                    const WayStrings &way_strings)
 {
-    if ((parsed_way.forward_travel_mode == TRAVEL_MODE_INACCESSIBLE ||
-         parsed_way.forward_speed <= 0) &&
-        (parsed_way.backward_travel_mode == TRAVEL_MODE_INACCESSIBLE ||
-         parsed_way.backward_speed <= 0) &&
-        parsed_way.duration <= 0)
-    { // Only true if the way is assigned a valid speed/duration
-        return;
-    }
-
-    if (!fallback_to_duration && (parsed_way.forward_travel_mode == TRAVEL_MODE_INACCESSIBLE ||
-                                  parsed_way.forward_rate <= 0) &&
-        (parsed_way.backward_travel_mode == TRAVEL_MODE_INACCESSIBLE ||
-         parsed_way.backward_rate <= 0) &&
-        parsed_way.weight <= 0)
-    { // Only true if the way is assigned a valid rate/weight and there is no duration fallback
+    if (!isRoutable(parsed_way, fallback_to_duration))
+    {
         return;
     }
+    BOOST_ASSERT(way_strings.name != nullptr);
 
     const auto &nodes = input_way.nodes();
     if (nodes.size() <= 1)
@@ -175,109 +298,39 @@ void ExtractorCallbacks::ProcessWay(const osmium::Way &input_way, const Extracti
         }
     }
 
-    const auto laneStringToDescription = [](const std::string &lane_string) -> TurnLaneDescription {
-        if (lane_string.empty())
-            return {};
-
-        TurnLaneDescription lane_description;
-
-        typedef boost::tokenizer<boost::char_separator<char>> tokenizer;
-        boost::char_separator<char> sep("|", "", boost::keep_empty_tokens);
-        boost::char_separator<char> inner_sep(";", "");
-        tokenizer tokens(lane_string, sep);
-
-        const constexpr std::size_t num_osm_tags = 11;
-        const constexpr char *osm_lane_strings[num_osm_tags] = {"none",
-                                                                "through",
-                                                                "sharp_left",
-                                                                "left",
-                                                                "slight_left",
-                                                                "slight_right",
-                                                                "right",
-                                                                "sharp_right",
-                                                                "reverse",
-                                                                "merge_to_left",
-                                                                "merge_to_right"};
-
-        const constexpr TurnLaneType::Mask masks_by_osm_string[num_osm_tags + 1] = {
-            TurnLaneType::none,
-            TurnLaneType::straight,
-            TurnLaneType::sharp_left,
-            TurnLaneType::left,
-            TurnLaneType::slight_left,
-            TurnLaneType::slight_right,
-            TurnLaneType::right,
-            TurnLaneType::sharp_right,
-            TurnLaneType::uturn,
-            TurnLaneType::merge_to_left,
-            TurnLaneType::merge_to_right,
-            TurnLaneType::empty}; // fallback, if string not found
-
-        for (auto iter = tokens.begin(); iter != tokens.end(); ++iter)
-        {
-            tokenizer inner_tokens(*iter, inner_sep);
-            guidance::TurnLaneType::Mask lane_mask = inner_tokens.begin() == inner_tokens.end()
-                                                         ? TurnLaneType::none
-                                                         : TurnLaneType::empty;
-            for (auto token_itr = inner_tokens.begin(); token_itr != inner_tokens.end();
-                 ++token_itr)
-            {
-                auto position =
-                    std::find(osm_lane_strings, osm_lane_strings + num_osm_tags, *token_itr);
-                const auto translated_mask =
-                    masks_by_osm_string[std::distance(osm_lane_strings, position)];
-                if (translated_mask == TurnLaneType::empty)
-                {
-                    // if we have unsupported tags, don't handle them
-                    util::Log(logDEBUG) << "Unsupported lane tag found: \"" << *token_itr << "\"";
-                    return {};
-                }
-
-                // In case of multiple times the same lane indicators withn a lane, as in
-                // "left;left|.."  or-ing the masks generates a single "left" enum.
-                // Which is fine since this is data issue and we can't represent it anyway.
-                lane_mask |= translated_mask;
-            }
-            // add the lane to the description
-            lane_description.push_back(lane_mask);
-        }
-        return lane_description;
-    };
-
     // convert the lane description into an ID and, if necessary, remember the description in the
-    // description_map
-    const auto requestId = [&](const std::string &lane_string) {
-        if (lane_string.empty())
+    // description_map. Ids are assigned in the order ways are ingested, which keeps them stable
+    // no matter how the interning of the strings was scheduled.
+    const auto requestId = [&](LaneInterner::Entry *lanes) {
+        if (lanes == nullptr)
             return INVALID_LANE_DESCRIPTIONID;
-        TurnLaneDescription lane_description = laneStringToDescription(std::move(lane_string));
 
-        const auto lane_description_itr = lane_description_map.find(lane_description);
-        if (lane_description_itr == lane_description_map.end())
+        auto &interned = lanes->second;
+        if (interned.id == INVALID_LANE_DESCRIPTIONID)
         {
-            const LaneDescriptionID new_id =
-                boost::numeric_cast<LaneDescriptionID>(lane_description_map.size());
-            lane_description_map[lane_description] = new_id;
-            return new_id;
-        }
-        else
-        {
-            return lane_description_itr->second;
+            const auto lane_description_itr = lane_description_map.find(interned.description);
+            if (lane_description_itr == lane_description_map.end())
+            {
+                interned.id = boost::numeric_cast<LaneDescriptionID>(lane_description_map.size());
+                lane_description_map[interned.description] = interned.id;
+            }
+            else
+            {
+                interned.id = lane_description_itr->second;
+            }
         }
+        return interned.id;
     };
 
-    // Deduplicates street names, refs, destinations, pronunciation based on the string_map.
-    // In case we do not already store the key, inserts (key, id) tuple and return id.
-    // Otherwise fetches the id based on the name and returns it without insertion.
-    const auto turn_lane_id_forward = requestId(parsed_way.turn_lanes_forward);
-    const auto turn_lane_id_backward = requestId(parsed_way.turn_lanes_backward);
+    const auto turn_lane_id_forward = requestId(way_strings.turn_lanes_forward);
+    const auto turn_lane_id_backward = requestId(way_strings.turn_lanes_backward);
 
     const auto road_classification = parsed_way.road_classification;
 
-    // Get the unique identifier for the street name, destination, and ref
-    const auto name_iterator = string_map.find(
-        MapKey(parsed_way.name, parsed_way.destinations, parsed_way.ref, parsed_way.pronunciation));
-    NameID name_id = EMPTY_NAMEID;
-    if (string_map.end() == name_iterator)
+    // Get the unique identifier for the street name, destination, and ref.
+    // The first way with a new name stores its strings and assigns the name id.
+    NameID &name_id = way_strings.name->second;
+    if (name_id == INVALID_NAMEID)
     {
         // name_offsets has a sentinel element with the total name data size
         // take the sentinels index as the name id of the new name data pack
@@ -303,15 +356,6 @@ void ExtractorCallbacks::ProcessWay(const osmium::Way &input_way, const Extracti
                   parsed_way.ref.end(),
                   std::back_inserter(external_memory.name_char_data));
         external_memory.name_offsets.push_back(external_memory.name_char_data.size());
-
-        auto k = MapKey{
-            parsed_way.name, parsed_way.destinations, parsed_way.ref, parsed_way.pronunciation};
-        auto v = MapVal{name_id};
-        string_map.emplace(std::move(k), std::move(v));
-    }
-    else
-    {
-        name_id = name_iterator->second;
     }
 
     const bool in_forward_direction =
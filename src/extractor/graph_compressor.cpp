@@ -8,11 +8,62 @@
 
 #include "util/log.hpp"
 
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
 namespace osrm
 {
 namespace extractor
 {
 
+namespace
+{
+// The two edges of a compressible node as they were before the compression.
+// The first neighbor is the target of the forward edge, the second the target of the reverse edge.
+struct ChainLink
+{
+    std::array<NodeID, 2> neighbors;
+    std::array<EdgeWeight, 2> weights;
+    std::array<EdgeDuration, 2> durations;
+};
+
+// Geometries of compressed edges collected by one thread
+struct GeometryBuffer
+{
+    std::vector<EdgeID> edges;
+    std::vector<std::size_t> offsets;
+    std::vector<CompressedEdgeContainer::OnewayCompressedEdge> segments;
+};
+
+EdgeID GetForwardEdge(const util::NodeBasedDynamicGraph &graph, const NodeID node_v)
+{
+    const bool reverse_edge_order = graph.GetEdgeData(graph.BeginEdges(node_v)).reversed;
+    return graph.BeginEdges(node_v) + reverse_edge_order;
+}
+
+EdgeID GetReverseEdge(const util::NodeBasedDynamicGraph &graph, const NodeID node_v)
+{
+    const bool reverse_edge_order = graph.GetEdgeData(graph.BeginEdges(node_v)).reversed;
+    return graph.BeginEdges(node_v) + 1 - reverse_edge_order;
+}
+}
+
+// The compression runs in three phases:
+//  1. All nodes are checked in parallel for the properties that do not change while chains are
+//     compressed: the degree, barriers, traffic lights, via nodes of restrictions and the
+//     compatibility of the adjacent edges.
+//  2. The candidates are compressed in order of their ids. This only checks for existing edges
+//     between the neighbors and updates the graph and the turn restrictions, which are shared
+//     between all chains. The result is the same as checking every node serially.
+//  3. The geometries of the compressed chains are collected in parallel into thread-local buffers
+//     and moved to the CompressedEdgeContainer.
 void GraphCompressor::Compress(const std::unordered_set<NodeID> &barrier_nodes,
                                const std::unordered_set<NodeID> &traffic_lights,
                                RestrictionMap &restriction_map,
@@ -22,31 +73,112 @@ void GraphCompressor::Compress(const std::unordered_set<NodeID> &barrier_nodes,
     const unsigned original_number_of_nodes = graph.GetNumberOfNodes();
     const unsigned original_number_of_edges = graph.GetNumberOfEdges();
 
-    {
-        util::UnbufferedLog log;
-        util::Percent progress(log, original_number_of_nodes);
+    const auto is_compressible = [&](const NodeID node_v) {
+        // only contract degree 2 vertices
+        if (2 != graph.GetOutDegree(node_v))
+        {
+            return false;
+        }
 
-        for (const NodeID node_v : util::irange(0u, original_number_of_nodes))
+        // don't contract barrier node
+        if (barrier_nodes.end() != barrier_nodes.find(node_v))
         {
-            progress.PrintStatus(node_v);
+            return false;
+        }
 
-            // only contract degree 2 vertices
-            if (2 != graph.GetOutDegree(node_v))
-            {
-                continue;
-            }
+        // check if v is a via node for a turn restriction, i.e. a 'directed' barrier node
+        if (restriction_map.IsViaNode(node_v))
+        {
+            return false;
+        }
 
-            // don't contract barrier node
-            if (barrier_nodes.end() != barrier_nodes.find(node_v))
-            {
-                continue;
-            }
+        // Do not compress edge if it crosses a traffic signal.
+        // This can't be done in CanCombineWith, becase we only store the
+        // traffic signals in the `traffic_lights` list, which EdgeData
+        // doesn't have access to.
+        if (traffic_lights.end() != traffic_lights.find(node_v))
+        {
+            return false;
+        }
 
-            // check if v is a via node for a turn restriction, i.e. a 'directed' barrier node
-            if (restriction_map.IsViaNode(node_v))
-            {
-                continue;
-            }
+        const EdgeID forward_e2 = GetForwardEdge(graph, node_v);
+        const EdgeID reverse_e2 = GetReverseEdge(graph, node_v);
+        const NodeID node_w = graph.GetTarget(forward_e2);
+        const NodeID node_u = graph.GetTarget(reverse_e2);
+        BOOST_ASSERT(node_u != node_v && node_w != node_v);
+
+        // both edges lead to the same node, compressing them would create a loop
+        if (node_u == node_w)
+        {
+            return false;
+        }
+
+        const EdgeData &fwd_edge_data1 = graph.GetEdgeData(graph.FindEdge(node_u, node_v));
+        const EdgeData &rev_edge_data1 = graph.GetEdgeData(graph.FindEdge(node_w, node_v));
+        const EdgeData &fwd_edge_data2 = graph.GetEdgeData(forward_e2);
+        const EdgeData &rev_edge_data2 = graph.GetEdgeData(reverse_e2);
+
+        // this case can happen if two ways with different names overlap
+        if (fwd_edge_data1.name_id != rev_edge_data1.name_id ||
+            fwd_edge_data2.name_id != rev_edge_data2.name_id)
+        {
+            return false;
+        }
+
+        // The names and the compatibility of the edges are not changed by the compression, so
+        // the edges that are merged into the edges of u and w later on pass this check as well.
+        return fwd_edge_data1.CanCombineWith(fwd_edge_data2) &&
+               rev_edge_data1.CanCombineWith(rev_edge_data2);
+    };
+
+    std::vector<std::uint8_t> is_candidate(original_number_of_nodes, false);
+    tbb::parallel_for(tbb::blocked_range<NodeID>(0, original_number_of_nodes),
+                      [&](const tbb::blocked_range<NodeID> &range) {
+                          for (auto node_v = range.begin(); node_v != range.end(); ++node_v)
+                          {
+                              is_candidate[node_v] = is_compressible(node_v);
+                          }
+                      });
+
+    std::vector<NodeID> candidates;
+    for (const NodeID node_v : util::irange(0u, original_number_of_nodes))
+    {
+        if (is_candidate[node_v])
+        {
+            candidates.push_back(node_v);
+        }
+    }
+    is_candidate.clear();
+    is_candidate.shrink_to_fit();
+
+    // remember the original edges of the candidates, they are removed by the compression
+    std::vector<ChainLink> links(candidates.size());
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, candidates.size()),
+                      [&](const tbb::blocked_range<std::size_t> &range) {
+                          for (auto index = range.begin(); index != range.end(); ++index)
+                          {
+                              const NodeID node_v = candidates[index];
+                              const EdgeID forward_e2 = GetForwardEdge(graph, node_v);
+                              const EdgeID reverse_e2 = GetReverseEdge(graph, node_v);
+                              const EdgeData &fwd_edge_data2 = graph.GetEdgeData(forward_e2);
+                              const EdgeData &rev_edge_data2 = graph.GetEdgeData(reverse_e2);
+                              links[index] = {{graph.GetTarget(forward_e2),
+                                               graph.GetTarget(reverse_e2)},
+                                              {fwd_edge_data2.weight, rev_edge_data2.weight},
+                                              {fwd_edge_data2.duration, rev_edge_data2.duration}};
+                          }
+                      });
+
+    std::vector<std::uint8_t> is_compressed(candidates.size(), false);
+    {
+        util::UnbufferedLog log;
+        util::Percent progress(log, candidates.size());
+
+        for (const auto index : util::irange<std::size_t>(0, candidates.size()))
+        {
+            progress.PrintStatus(index);
+
+            const NodeID node_v = candidates[index];
 
             //    reverse_e2   forward_e2
             // u <---------- v -----------> w
@@ -61,12 +193,11 @@ void GraphCompressor::Compress(const std::unordered_set<NodeID> &barrier_nodes,
             //    forward_e1
             //
             // If the edges are compatible.
-            const bool reverse_edge_order = graph.GetEdgeData(graph.BeginEdges(node_v)).reversed;
-            const EdgeID forward_e2 = graph.BeginEdges(node_v) + reverse_edge_order;
+            const EdgeID forward_e2 = GetForwardEdge(graph, node_v);
             BOOST_ASSERT(SPECIAL_EDGEID != forward_e2);
             BOOST_ASSERT(forward_e2 >= graph.BeginEdges(node_v) &&
                          forward_e2 < graph.EndEdges(node_v));
-            const EdgeID reverse_e2 = graph.BeginEdges(node_v) + 1 - reverse_edge_order;
+            const EdgeID reverse_e2 = GetReverseEdge(graph, node_v);
             BOOST_ASSERT(SPECIAL_EDGEID != reverse_e2);
             BOOST_ASSERT(reverse_e2 >= graph.BeginEdges(node_v) &&
                          reverse_e2 < graph.EndEdges(node_v));
@@ -88,144 +219,166 @@ void GraphCompressor::Compress(const std::unordered_set<NodeID> &barrier_nodes,
             BOOST_ASSERT(SPECIAL_EDGEID != reverse_e1);
             BOOST_ASSERT(node_v == graph.GetTarget(reverse_e1));
 
-            const EdgeData &fwd_edge_data1 = graph.GetEdgeData(forward_e1);
-            const EdgeData &rev_edge_data1 = graph.GetEdgeData(reverse_e1);
-
             if (graph.FindEdgeInEitherDirection(node_u, node_w) != SPECIAL_EDGEID)
             {
                 continue;
             }
 
-            // this case can happen if two ways with different names overlap
-            if (fwd_edge_data1.name_id != rev_edge_data1.name_id ||
-                fwd_edge_data2.name_id != rev_edge_data2.name_id)
-            {
-                continue;
-            }
+            BOOST_ASSERT(graph.GetEdgeData(forward_e1).CanCombineWith(fwd_edge_data2));
+            BOOST_ASSERT(graph.GetEdgeData(reverse_e1).CanCombineWith(rev_edge_data2));
+
+            // add weight of e2's to e1
+            graph.GetEdgeData(forward_e1).weight += fwd_edge_data2.weight;
+            graph.GetEdgeData(reverse_e1).weight += rev_edge_data2.weight;
+
+            // add duration of e2's to e1
+            graph.GetEdgeData(forward_e1).duration += fwd_edge_data2.duration;
+            graph.GetEdgeData(reverse_e1).duration += rev_edge_data2.duration;
+
+            // extend e1's to targets of e2's
+            graph.SetTarget(forward_e1, node_w);
+            graph.SetTarget(reverse_e1, node_u);
+            /*
+             * Remember Lane Data for compressed parts. This handles scenarios where lane-data
+             * is
+             * only kept up until a traffic light.
+             *
+             *                |    |
+             * ----------------    |
+             *         -^ |        |
+             * -----------         |
+             *         -v |        |
+             * ---------------     |
+             *                |    |
+             *
+             *  u ------- v ---- w
+             *
+             * Since the edge is compressable, we can transfer:
+             * "left|right" (uv) and "" (uw) into a string with "left|right" (uw) for the
+             * compressed
+             * edge.
+             * Doing so, we might mess up the point from where the lanes are shown. It should be
+             * reasonable, since the announcements have to come early anyhow. So there is a
+             * potential danger in here, but it saves us from adding a lot of additional edges
+             * for
+             * turn-lanes. Without this,we would have to treat any turn-lane beginning/ending
+             * just
+             * like a barrier.
+             */
+            const auto selectLaneID = [](const LaneDescriptionID front,
+                                         const LaneDescriptionID back) {
+                // A lane has tags: u - (front) - v - (back) - w
+                // During contraction, we keep only one of the tags. Usually the one closer to
+                // the
+                // intersection is preferred. If its empty, however, we keep the non-empty one
+                if (back == INVALID_LANE_DESCRIPTIONID)
+                    return front;
+                return back;
+            };
+            graph.GetEdgeData(forward_e1).lane_description_id =
+                selectLaneID(graph.GetEdgeData(forward_e1).lane_description_id,
+                             fwd_edge_data2.lane_description_id);
+            graph.GetEdgeData(reverse_e1).lane_description_id =
+                selectLaneID(graph.GetEdgeData(reverse_e1).lane_description_id,
+                             rev_edge_data2.lane_description_id);
+
+            // remove e2's (if bidir, otherwise only one)
+            graph.DeleteEdge(node_v, forward_e2);
+            graph.DeleteEdge(node_v, reverse_e2);
+
+            // update any involved turn restrictions
+            restriction_map.FixupStartingTurnRestriction(node_u, node_v, node_w);
+            restriction_map.FixupArrivingTurnRestriction(node_u, node_v, node_w, graph);
+
+            restriction_map.FixupStartingTurnRestriction(node_w, node_v, node_u);
+            restriction_map.FixupArrivingTurnRestriction(node_w, node_v, node_u, graph);
+
+            is_compressed[index] = true;
+        }
+    }
 
-            if (fwd_edge_data1.CanCombineWith(fwd_edge_data2) &&
-                rev_edge_data1.CanCombineWith(rev_edge_data2))
+    PrintStatistics(original_number_of_nodes, original_number_of_edges, graph);
+
+    // index of a compressed node in the candidates, or NOT_COMPRESSED for the end of a chain
+    const constexpr auto NOT_COMPRESSED = std::numeric_limits<std::size_t>::max();
+    const auto find_compressed = [&](const NodeID node) -> std::size_t {
+        const auto iter = std::lower_bound(candidates.begin(), candidates.end(), node);
+        if (iter == candidates.end() || *iter != node)
+            return NOT_COMPRESSED;
+        const std::size_t index = std::distance(candidates.begin(), iter);
+        return is_compressed[index] ? index : NOT_COMPRESSED;
+    };
+
+    // Every chain u - v_1 - ... - v_k - w of compressed nodes has been merged into one edge from u
+    // to w and one from w to u. Each of them is collected by walking the chain from its source.
+    tbb::enumerable_thread_specific<GeometryBuffer> geometry_buffers;
+    tbb::parallel_for(
+        tbb::blocked_range<std::size_t>(0, candidates.size()),
+        [&](const tbb::blocked_range<std::size_t> &range) {
+            auto &buffer = geometry_buffers.local();
+            for (auto index = range.begin(); index != range.end(); ++index)
             {
-                BOOST_ASSERT(graph.GetEdgeData(forward_e1).name_id ==
-                             graph.GetEdgeData(reverse_e1).name_id);
-                BOOST_ASSERT(graph.GetEdgeData(forward_e2).name_id ==
-                             graph.GetEdgeData(reverse_e2).name_id);
-
-                // Do not compress edge if it crosses a traffic signal.
-                // This can't be done in CanCombineWith, becase we only store the
-                // traffic signals in the `traffic_lights` list, which EdgeData
-                // doesn't have access to.
-                const bool has_node_penalty = traffic_lights.find(node_v) != traffic_lights.end();
-                if (has_node_penalty)
+                if (!is_compressed[index])
                     continue;
 
-                // Get weights before graph is modified
-                const auto forward_weight1 = fwd_edge_data1.weight;
-                const auto forward_weight2 = fwd_edge_data2.weight;
-                const auto forward_duration1 = fwd_edge_data1.duration;
-                const auto forward_duration2 = fwd_edge_data2.duration;
-
-                BOOST_ASSERT(0 != forward_weight1);
-                BOOST_ASSERT(0 != forward_weight2);
-
-                const auto reverse_weight1 = rev_edge_data1.weight;
-                const auto reverse_weight2 = rev_edge_data2.weight;
-                const auto reverse_duration1 = rev_edge_data1.duration;
-                const auto reverse_duration2 = rev_edge_data2.duration;
-
-                BOOST_ASSERT(0 != reverse_weight1);
-                BOOST_ASSERT(0 != reverse_weight2);
-
-                // add weight of e2's to e1
-                graph.GetEdgeData(forward_e1).weight += forward_weight2;
-                graph.GetEdgeData(reverse_e1).weight += reverse_weight2;
-
-                // add duration of e2's to e1
-                graph.GetEdgeData(forward_e1).duration += forward_duration2;
-                graph.GetEdgeData(reverse_e1).duration += reverse_duration2;
-
-                // extend e1's to targets of e2's
-                graph.SetTarget(forward_e1, node_w);
-                graph.SetTarget(reverse_e1, node_u);
-
-                /*
-                 * Remember Lane Data for compressed parts. This handles scenarios where lane-data
-                 * is
-                 * only kept up until a traffic light.
-                 *
-                 *                |    |
-                 * ----------------    |
-                 *         -^ |        |
-                 * -----------         |
-                 *         -v |        |
-                 * ---------------     |
-                 *                |    |
-                 *
-                 *  u ------- v ---- w
-                 *
-                 * Since the edge is compressable, we can transfer:
-                 * "left|right" (uv) and "" (uw) into a string with "left|right" (uw) for the
-                 * compressed
-                 * edge.
-                 * Doing so, we might mess up the point from where the lanes are shown. It should be
-                 * reasonable, since the announcements have to come early anyhow. So there is a
-                 * potential danger in here, but it saves us from adding a lot of additional edges
-                 * for
-                 * turn-lanes. Without this,we would have to treat any turn-lane beginning/ending
-                 * just
-                 * like a barrier.
-                 */
-                const auto selectLaneID = [](const LaneDescriptionID front,
-                                             const LaneDescriptionID back) {
-                    // A lane has tags: u - (front) - v - (back) - w
-                    // During contraction, we keep only one of the tags. Usually the one closer to
-                    // the
-                    // intersection is preferred. If its empty, however, we keep the non-empty one
-                    if (back == INVALID_LANE_DESCRIPTIONID)
-                        return front;
-                    return back;
-                };
-                graph.GetEdgeData(forward_e1).lane_description_id =
-                    selectLaneID(graph.GetEdgeData(forward_e1).lane_description_id,
-                                 fwd_edge_data2.lane_description_id);
-                graph.GetEdgeData(reverse_e1).lane_description_id =
-                    selectLaneID(graph.GetEdgeData(reverse_e1).lane_description_id,
-                                 rev_edge_data2.lane_description_id);
-
-                // remove e2's (if bidir, otherwise only one)
-                graph.DeleteEdge(node_v, forward_e2);
-                graph.DeleteEdge(node_v, reverse_e2);
-
-                // update any involved turn restrictions
-                restriction_map.FixupStartingTurnRestriction(node_u, node_v, node_w);
-                restriction_map.FixupArrivingTurnRestriction(node_u, node_v, node_w, graph);
-
-                restriction_map.FixupStartingTurnRestriction(node_w, node_v, node_u);
-                restriction_map.FixupArrivingTurnRestriction(node_w, node_v, node_u, graph);
-
-                // store compressed geometry in container
-                geometry_compressor.CompressEdge(forward_e1,
-                                                 forward_e2,
-                                                 node_v,
-                                                 node_w,
-                                                 forward_weight1,
-                                                 forward_weight2,
-                                                 forward_duration1,
-                                                 forward_duration2);
-                geometry_compressor.CompressEdge(reverse_e1,
-                                                 reverse_e2,
-                                                 node_v,
-                                                 node_u,
-                                                 reverse_weight1,
-                                                 reverse_weight2,
-                                                 reverse_duration1,
-                                                 reverse_duration2);
+                for (const auto side : {0, 1})
+                {
+                    const NodeID node_u = links[index].neighbors[side];
+                    if (find_compressed(node_u) != NOT_COMPRESSED)
+                        continue;
+
+                    // the weight of the first segment is only stored in the merged edge
+                    const auto offset = buffer.segments.size();
+                    buffer.segments.push_back({candidates[index], 0, 0});
+                    EdgeWeight remaining_weight = 0;
+                    EdgeDuration remaining_duration = 0;
+
+                    auto previous = node_u;
+                    auto current = index;
+                    NodeID node_w = SPECIAL_NODEID;
+                    while (current != NOT_COMPRESSED)
+                    {
+                        const auto &link = links[current];
+                        const auto next = link.neighbors[0] == previous ? 1 : 0;
+                        BOOST_ASSERT(link.neighbors[1 - next] == previous);
+
+                        node_w = link.neighbors[next];
+                        buffer.segments.push_back(
+                            {node_w,
+                             static_cast<SegmentWeight>(link.weights[next]),
+                             static_cast<SegmentDuration>(link.durations[next])});
+                        remaining_weight += link.weights[next];
+                        remaining_duration += link.durations[next];
+
+                        previous = candidates[current];
+                        current = find_compressed(node_w);
+                    }
+
+                    const EdgeID edge = graph.FindEdge(node_u, node_w);
+                    BOOST_ASSERT(SPECIAL_EDGEID != edge);
+                    const EdgeData &data = graph.GetEdgeData(edge);
+                    buffer.segments[offset].weight = data.weight - remaining_weight;
+                    buffer.segments[offset].duration = data.duration - remaining_duration;
+                    BOOST_ASSERT(0 != buffer.segments[offset].weight);
+
+                    buffer.edges.push_back(edge);
+                    buffer.offsets.push_back(offset);
+                }
             }
+        });
+
+    for (auto &buffer : geometry_buffers)
+    {
+        buffer.offsets.push_back(buffer.segments.size());
+        for (const auto index : util::irange<std::size_t>(0, buffer.edges.size()))
+        {
+            geometry_compressor.AddCompressedEdge(
+                buffer.edges[index],
+                buffer.segments.begin() + buffer.offsets[index],
+                buffer.segments.begin() + buffer.offsets[index + 1]);
         }
     }
 
-    PrintStatistics(original_number_of_nodes, original_number_of_edges, graph);
-
     // Repeate the loop, but now add all edges as uncompressed values.
     // The function AddUncompressedEdge does nothing if the edge is already
     // in the CompressedEdgeContainer.
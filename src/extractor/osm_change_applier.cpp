@@ -0,0 +1,293 @@
+#include "extractor/osm_change_applier.hpp"
+
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/log.hpp"
+
+#include <boost/filesystem/operations.hpp>
+
+#include <osmium/io/any_input.hpp>
+#include <osmium/osm/entity_bits.hpp>
+#include <osmium/osm/object_comparisons.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+
+namespace osrm
+{
+namespace extractor
+{
+
+namespace
+{
+// Order of the objects in sorted OSM files, matching osmium::object_order_type_id_reverse_version
+auto typeIdKey(const osmium::item_type type, const osmium::object_id_type id)
+{
+    return std::make_tuple(type, id < 0, id < 0 ? -id : id);
+}
+
+auto typeIdKey(const osmium::OSMObject &object) { return typeIdKey(object.type(), object.id()); }
+
+bool isObject(const osmium::memory::Item &item)
+{
+    return item.type() == osmium::item_type::node || item.type() == osmium::item_type::way ||
+           item.type() == osmium::item_type::relation;
+}
+}
+
+OSMChangeApplier::OSMChangeApplier(const std::vector<boost::filesystem::path> &change_files)
+    : has_last_object(false), number_of_modified(0), number_of_deleted(0), number_of_created(0),
+      number_of_outdated(0)
+{
+    for (const auto &change_file : change_files)
+    {
+        util::Log() << "Reading changes from " << change_file.filename().string();
+        osmium::io::Reader reader(change_file.string(), osmium::osm_entity_bits::nwr);
+        const auto header_timestamp = reader.header().get("osmosis_replication_timestamp");
+        if (!header_timestamp.empty())
+        {
+            newest_timestamp = std::max(newest_timestamp, osmium::Timestamp(header_timestamp));
+        }
+        while (osmium::memory::Buffer buffer = reader.read())
+        {
+            for (const auto &item : buffer)
+            {
+                if (isObject(item))
+                {
+                    const auto &object = static_cast<const osmium::OSMObject &>(item);
+                    newest_timestamp = std::max(newest_timestamp, object.timestamp());
+                    changes.push_back(&object);
+                }
+            }
+            // the objects stay at the same address when the buffer is moved
+            change_buffers.push_back(std::move(buffer));
+        }
+        reader.close();
+    }
+
+    // Sort by type, id and newest version first. For equal versions the stable sort keeps the
+    // reversed input order, so the change of the last file comes first.
+    std::reverse(changes.begin(), changes.end());
+    std::stable_sort(changes.begin(),
+                     changes.end(),
+                     [](const osmium::OSMObject *lhs, const osmium::OSMObject *rhs) {
+                         return osmium::object_order_type_id_reverse_version{}(*lhs, *rhs);
+                     });
+    changes.erase(std::unique(changes.begin(),
+                              changes.end(),
+                              [](const osmium::OSMObject *lhs, const osmium::OSMObject *rhs) {
+                                  return osmium::object_equal_type_id{}(*lhs, *rhs);
+                              }),
+                  changes.end());
+    next_change = changes.begin();
+
+    util::Log() << "Loaded changes of " << changes.size() << " objects";
+}
+
+osmium::memory::Buffer OSMChangeApplier::Apply(const osmium::memory::Buffer &base_buffer)
+{
+    osmium::memory::Buffer buffer(base_buffer.committed(), osmium::memory::Buffer::auto_grow::yes);
+
+    for (const auto &item : base_buffer)
+    {
+        if (!isObject(item))
+        {
+            buffer.add_item(item);
+            buffer.commit();
+            continue;
+        }
+
+        const auto &object = static_cast<const osmium::OSMObject &>(item);
+        const auto key = typeIdKey(object);
+        if (has_last_object && !(typeIdKey(last_type, last_id) < key))
+        {
+            throw util::exception("Changes can only be applied to files sorted by type and id, " +
+                                  std::string(osmium::item_type_to_name(object.type())) + " " +
+                                  std::to_string(object.id()) + " is out of order" + SOURCE_REF);
+        }
+        last_type = object.type();
+        last_id = object.id();
+        has_last_object = true;
+
+        // objects created in front of this one
+        while (next_change != changes.end() && typeIdKey(**next_change) < key)
+        {
+            AddChange(buffer, **next_change, false);
+            ++next_change;
+        }
+
+        const bool has_change = next_change != changes.end() && typeIdKey(**next_change) == key;
+        // stale or overlapping diffs must not replace a newer version of the base file
+        if (has_change && (*next_change)->version() > object.version())
+        {
+            AddChange(buffer, **next_change, true);
+        }
+        else
+        {
+            number_of_outdated += has_change ? 1 : 0;
+            buffer.add_item(object);
+            buffer.commit();
+        }
+        if (has_change)
+        {
+            ++next_change;
+        }
+    }
+
+    return buffer;
+}
+
+osmium::memory::Buffer OSMChangeApplier::Finish()
+{
+    osmium::memory::Buffer buffer(1024 * 1024, osmium::memory::Buffer::auto_grow::yes);
+    for (; next_change != changes.end(); ++next_change)
+    {
+        AddChange(buffer, **next_change, false);
+    }
+
+    util::Log() << "Applied changes: " << number_of_modified << " modified, " << number_of_deleted
+                << " deleted and " << number_of_created << " created objects";
+    if (number_of_outdated > 0)
+    {
+        util::Log(logWARNING) << "Ignored " << number_of_outdated
+                              << " changes that are not newer than the input";
+    }
+
+    return buffer;
+}
+
+std::string OSMChangeApplier::GetTimestamp() const
+{
+    return newest_timestamp.valid() ? newest_timestamp.to_iso() : std::string{};
+}
+
+void OSMChangeApplier::AddChange(osmium::memory::Buffer &buffer,
+                                 const osmium::OSMObject &change,
+                                 const bool replaces)
+{
+    if (!change.visible())
+    {
+        // deleting objects that are not in the base file is a no-op
+        number_of_deleted += replaces ? 1 : 0;
+        return;
+    }
+
+    if (replaces)
+        ++number_of_modified;
+    else
+        ++number_of_created;
+
+    buffer.add_item(change);
+    buffer.commit();
+}
+
+std::size_t checkChangeMerge(const boost::filesystem::path &base_file,
+                            const std::vector<boost::filesystem::path> &change_files)
+{
+    const auto base_file_size = boost::filesystem::file_size(base_file);
+    if (base_file_size > MAX_CHANGE_MERGE_CHECK_INPUT_SIZE)
+    {
+        throw util::exception("Checking the merge of the changes loads the whole input into "
+                              "memory and is limited to inputs of " +
+                              std::to_string(MAX_CHANGE_MERGE_CHECK_INPUT_SIZE >> 20) +
+                              " MiB, " + base_file.string() + " has " +
+                              std::to_string(base_file_size >> 20) + " MiB" + SOURCE_REF);
+    }
+
+    std::vector<osmium::memory::Buffer> reference_buffers;
+    const auto load = [&](const boost::filesystem::path &path,
+                          std::vector<const osmium::OSMObject *> &objects) {
+        osmium::io::Reader reader(path.string(), osmium::osm_entity_bits::nwr);
+        while (osmium::memory::Buffer buffer = reader.read())
+        {
+            for (const auto &object : buffer.select<osmium::OSMObject>())
+            {
+                objects.push_back(&object);
+            }
+            reference_buffers.push_back(std::move(buffer));
+        }
+        reader.close();
+    };
+    std::vector<const osmium::OSMObject *> reference;
+    load(base_file, reference);
+    std::vector<const osmium::OSMObject *> changes;
+    for (const auto &change_file : change_files)
+    {
+        load(change_file, changes);
+    }
+
+    // Newest version of every object. For equal versions the base file wins over the changes
+    // and later change files win over earlier ones.
+    reference.insert(reference.end(), changes.rbegin(), changes.rend());
+    std::stable_sort(reference.begin(),
+                     reference.end(),
+                     [](const osmium::OSMObject *lhs, const osmium::OSMObject *rhs) {
+                         return osmium::object_order_type_id_reverse_version{}(*lhs, *rhs);
+                     });
+    reference.erase(std::unique(reference.begin(),
+                                reference.end(),
+                                [](const osmium::OSMObject *lhs, const osmium::OSMObject *rhs) {
+                                    return osmium::object_equal_type_id{}(*lhs, *rhs);
+                                }),
+                    reference.end());
+    reference.erase(std::remove_if(reference.begin(),
+                                   reference.end(),
+                                   [](const osmium::OSMObject *object) {
+                                       return !object->visible();
+                                   }),
+                    reference.end());
+
+    std::size_t number_of_differences = 0;
+    const auto report = [&number_of_differences](const osmium::OSMObject &object) {
+        // the first differences are enough to find the cause
+        if (number_of_differences++ < 10)
+        {
+            util::Log(logWARNING) << "Merged input differs at "
+                                  << osmium::item_type_to_name(object.type()) << " "
+                                  << object.id();
+        }
+    };
+
+    auto expected = reference.begin();
+    const auto compare = [&](const osmium::memory::Buffer &buffer) {
+        for (const auto &object : buffer.select<osmium::OSMObject>())
+        {
+            for (; expected != reference.end() && typeIdKey(**expected) < typeIdKey(object);
+                 ++expected)
+            {
+                report(**expected);
+            }
+
+            if (expected == reference.end() || typeIdKey(object) < typeIdKey(**expected))
+            {
+                report(object);
+                continue;
+            }
+
+            if (object.byte_size() != (*expected)->byte_size() ||
+                std::memcmp(object.data(), (*expected)->data(), object.byte_size()) != 0)
+            {
+                report(object);
+            }
+            ++expected;
+        }
+    };
+
+    OSMChangeApplier applier(change_files);
+    osmium::io::Reader reader(base_file.string(), osmium::osm_entity_bits::nwr);
+    while (osmium::memory::Buffer buffer = reader.read())
+    {
+        compare(applier.Apply(buffer));
+    }
+    reader.close();
+    compare(applier.Finish());
+    for (; expected != reference.end(); ++expected)
+    {
+        report(**expected);
+    }
+
+    return number_of_differences;
+}
+}
+}
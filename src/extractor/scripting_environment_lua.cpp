@@ -427,15 +427,20 @@ void Sol2ScriptingEnvironment::InitContext(LuaScriptingContext &context)
 
     context.state.script_file(file_name);
 
-    sol::function turn_function = context.state["turn_function"];
-    sol::function node_function = context.state["node_function"];
-    sol::function way_function = context.state["way_function"];
-    sol::function segment_function = context.state["segment_function"];
+    context.turn_function = context.state.get<sol::function>("turn_function");
+    context.turn_batch_function = context.state.get<sol::function>("turn_batch_function");
+    context.node_function = context.state.get<sol::function>("node_function");
+    context.way_function = context.state.get<sol::function>("way_function");
+    context.segment_function = context.state.get<sol::function>("segment_function");
 
-    context.has_turn_penalty_function = turn_function.valid();
-    context.has_node_function = node_function.valid();
-    context.has_way_function = way_function.valid();
-    context.has_segment_function = segment_function.valid();
+    context.has_turn_penalty_function = context.turn_function.valid();
+    context.has_turn_batch_function = context.turn_batch_function.valid();
+    context.has_node_function = context.node_function.valid();
+    context.has_way_function = context.way_function.valid();
+    context.has_segment_function = context.segment_function.valid();
+
+    context.turn_batch = context.state.create_table();
+    context.turn_batch_size = 0;
 
     // Check profile API version
     auto maybe_version = context.state.get<sol::optional<int>>("api_version");
@@ -462,6 +467,11 @@ void Sol2ScriptingEnvironment::InitContext(LuaScriptingContext &context)
         break;
     case 0:
         BOOST_ASSERT(context.properties.GetWeightName() == "duration");
+        if (context.has_turn_batch_function)
+        {
+            throw util::exception("turn_batch_function requires profile API version 1" +
+                                  SOURCE_REF);
+        }
         break;
     }
 }
@@ -473,11 +483,12 @@ const ProfileProperties &Sol2ScriptingEnvironment::GetProfileProperties()
 
 LuaScriptingContext &Sol2ScriptingEnvironment::GetSol2Context()
 {
-    std::lock_guard<std::mutex> lock(init_mutex);
+    // local() is thread-safe, only the initialization of a new context needs to be serialized
     bool initialized = false;
     auto &ref = script_contexts.local(initialized);
     if (!initialized)
     {
+        std::lock_guard<std::mutex> lock(init_mutex);
         ref = std::make_unique<LuaScriptingContext>();
         InitContext(*ref);
     }
@@ -590,7 +601,7 @@ void Sol2ScriptingEnvironment::ProcessTurn(ExtractionTurn &turn)
 {
     auto &context = GetSol2Context();
 
-    sol::function turn_function = context.state["turn_function"];
+    auto &turn_function = context.turn_function;
     switch (context.api_version)
     {
     case 1:
@@ -636,13 +647,50 @@ void Sol2ScriptingEnvironment::ProcessTurn(ExtractionTurn &turn)
     }
 }
 
+void Sol2ScriptingEnvironment::ProcessTurns(std::vector<ExtractionTurn> &turns)
+{
+    auto &context = GetSol2Context();
+
+    if (!context.has_turn_batch_function)
+    {
+        for (auto &turn : turns)
+            ProcessTurn(turn);
+        return;
+    }
+
+    BOOST_ASSERT(context.api_version == 1);
+
+    // The turns are passed by reference, so the profile modifies them in place. Entries
+    // of a previous larger batch are removed so the length of the table is correct.
+    auto &turn_batch = context.turn_batch;
+    for (std::size_t index = 0; index < turns.size(); ++index)
+    {
+        turn_batch[index + 1] = &turns[index];
+    }
+    for (std::size_t index = turns.size(); index < context.turn_batch_size; ++index)
+    {
+        turn_batch[index + 1] = sol::nil;
+    }
+    context.turn_batch_size = turns.size();
+
+    context.turn_batch_function(turn_batch);
+
+    // Turn weight falls back to the duration value in deciseconds
+    // or uses the extracted unit-less weight value
+    if (context.properties.fallback_to_duration)
+    {
+        for (auto &turn : turns)
+            turn.weight = turn.duration;
+    }
+}
+
 void Sol2ScriptingEnvironment::ProcessSegment(ExtractionSegment &segment)
 {
     auto &context = GetSol2Context();
 
     if (context.has_segment_function)
     {
-        sol::function segment_function = context.state["segment_function"];
+        auto &segment_function = context.segment_function;
         switch (context.api_version)
         {
         case 1:
@@ -660,8 +708,6 @@ void LuaScriptingContext::ProcessNode(const osmium::Node &node, ExtractionNode &
 {
     BOOST_ASSERT(state.lua_state() != nullptr);
 
-    sol::function node_function = state["node_function"];
-
     node_function(node, result);
 }
 
@@ -669,8 +715,6 @@ void LuaScriptingContext::ProcessWay(const osmium::Way &way, ExtractionWay &resu
 {
     BOOST_ASSERT(state.lua_state() != nullptr);
 
-    sol::function way_function = state["way_function"];
-
     way_function(way, result);
 }
 }
@@ -8,9 +8,11 @@
 #include "osrm/tile_parameters.hpp"
 #include "osrm/trip_parameters.hpp"
 
+#include <algorithm>
 #include <exception>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "nodejs/node_osrm.hpp"
 #include "nodejs/node_osrm_support.hpp"
@@ -40,6 +42,8 @@ NAN_MODULE_INIT(Engine::Init)
     SetPrototypeMethod(fnTp, "tile", tile);
     SetPrototypeMethod(fnTp, "match", match);
     SetPrototypeMethod(fnTp, "trip", trip);
+    SetPrototypeMethod(fnTp, "routeBatch", routeBatch);
+    SetPrototypeMethod(fnTp, "tableBatch", tableBatch);
 
     const auto fn = Nan::GetFunction(fnTp).ToLocalChecked();
 
@@ -104,6 +108,38 @@ NAN_METHOD(Engine::New)
     }
 }
 
+// All services return json::Object .. except for Tile and the batch services!
+template <typename ParamPtr> struct ServiceResult
+{
+    using type = osrm::json::Object;
+};
+
+template <> struct ServiceResult<tile_parameters_ptr>
+{
+    using type = std::string;
+};
+
+template <> struct ServiceResult<route_batch_parameters_ptr>
+{
+    using type = std::vector<osrm::json::Object>;
+};
+
+template <> struct ServiceResult<table_batch_parameters_ptr>
+{
+    using type = std::vector<osrm::json::Object>;
+};
+
+template <typename ParamType> inline bool isValid(const ParamType &params)
+{
+    return params.IsValid();
+}
+
+template <typename ParamType> inline bool isValid(const std::vector<ParamType> &batch)
+{
+    return std::all_of(
+        batch.begin(), batch.end(), [](const ParamType &params) { return params.IsValid(); });
+}
+
 template <typename ParameterParser, typename ServiceMemFn>
 inline void async(const Nan::FunctionCallbackInfo<v8::Value> &info,
                   ParameterParser argsToParams,
@@ -114,7 +150,7 @@ inline void async(const Nan::FunctionCallbackInfo<v8::Value> &info,
     if (!params)
         return;
 
-    BOOST_ASSERT(params->IsValid());
+    BOOST_ASSERT(isValid(*params));
 
     if (!info[info.Length() - 1]->IsFunction())
         return Nan::ThrowTypeError("last argument must be a callback function");
@@ -160,13 +196,7 @@ inline void async(const Nan::FunctionCallbackInfo<v8::Value> &info,
         ServiceMemFn service;
         const ParamPtr params;
 
-        // All services return json::Object .. except for Tile!
-        using ObjectOrString =
-            typename std::conditional<std::is_same<ParamPtr, tile_parameters_ptr>::value,
-                                      std::string,
-                                      osrm::json::Object>::type;
-
-        ObjectOrString result;
+        typename ServiceResult<ParamPtr>::type result;
     };
 
     auto *callback = new Nan::Callback{info[info.Length() - 1].As<v8::Function>()};
@@ -448,6 +478,68 @@ NAN_METHOD(Engine::trip) //
     async(info, &argumentsToTripParameter, &osrm::OSRM::Trip, true);
 }
 
+// clang-format off
+/**
+ * Computes many independent routes in parallel. All routes of a batch are computed on the same
+ * dataset, which is faster than calling `route` in a loop.
+ *
+ * @name routeBatch
+ * @memberof OSRM
+ * @param {Array} options - Array of object literals, each containing the parameters of a single route query as described in [route](#route).
+ * @param {Function} callback
+ *
+ * @returns {Array} containing one result per route query in the same order.
+ * Successful queries return the same object as [route](#route).
+ * Failed queries return an object with the `code` and `message` of the error.
+ *
+ * @example
+ * var osrm = new OSRM("berlin-latest.osrm");
+ * var options = [
+ *   {coordinates: [[13.438640,52.519930], [13.415852,52.513191]]},
+ *   {coordinates: [[13.388860,52.517037], [13.397634,52.529407]]}
+ * ];
+ * osrm.routeBatch(options, function(err, results) {
+ *   if(err) throw err;
+ *   console.log(results[0].routes); // array of Route objects of the first query
+ * });
+ */
+// clang-format on
+NAN_METHOD(Engine::routeBatch) //
+{
+    async(info, &argumentsToRouteBatchParameters, &osrm::OSRM::RouteBatch, true);
+}
+
+// clang-format off
+/**
+ * Computes many independent duration tables in parallel. All tables of a batch are computed on
+ * the same dataset, which is faster than calling `table` in a loop.
+ *
+ * @name tableBatch
+ * @memberof OSRM
+ * @param {Array} options - Array of object literals, each containing the parameters of a single table query as described in [table](#table).
+ * @param {Function} callback
+ *
+ * @returns {Array} containing one result per table query in the same order.
+ * Successful queries return the same object as [table](#table).
+ * Failed queries return an object with the `code` and `message` of the error.
+ *
+ * @example
+ * var osrm = new OSRM('network.osrm');
+ * var options = [
+ *   {coordinates: [[13.388860,52.517037], [13.397634,52.529407], [13.428555,52.523219]]},
+ *   {coordinates: [[13.388860,52.517037], [13.428555,52.523219]], sources: [0]}
+ * ];
+ * osrm.tableBatch(options, function(err, results) {
+ *   if(err) throw err;
+ *   console.log(results[1].durations); // matrix of the second query
+ * });
+ */
+// clang-format on
+NAN_METHOD(Engine::tableBatch) //
+{
+    async(info, &argumentsToTableBatchParameters, &osrm::OSRM::TableBatch, true);
+}
+
 /**
  * Responses
  * @class Responses
@@ -2,6 +2,7 @@
 #include "engine/algorithm.hpp"
 #include "engine/api/match_parameters.hpp"
 #include "engine/api/nearest_parameters.hpp"
+#include "engine/api/results.hpp"
 #include "engine/api/route_parameters.hpp"
 #include "engine/api/table_parameters.hpp"
 #include "engine/api/trip_parameters.hpp"
@@ -110,6 +111,18 @@ engine::Status OSRM::Table(const engine::api::TableParameters &params, json::Obj
     return engine_->Table(params, result);
 }
 
+engine::Status OSRM::Route(const engine::api::RouteParameters &params,
+                           engine::api::RouteResult &result) const
+{
+    return engine_->Route(params, result);
+}
+
+engine::Status OSRM::Table(const engine::api::TableParameters &params,
+                           engine::api::TableResult &result) const
+{
+    return engine_->Table(params, result);
+}
+
 engine::Status OSRM::Nearest(const engine::api::NearestParameters &params,
                              json::Object &result) const
 {
@@ -131,4 +144,16 @@ engine::Status OSRM::Tile(const engine::api::TileParameters &params, std::string
     return engine_->Tile(params, result);
 }
 
+engine::Status OSRM::RouteBatch(const std::vector<engine::api::RouteParameters> &params,
+                                std::vector<json::Object> &results) const
+{
+    return engine_->RouteBatch(params, results);
+}
+
+engine::Status OSRM::TableBatch(const std::vector<engine::api::TableParameters> &params,
+                                std::vector<json::Object> &results) const
+{
+    return engine_->TableBatch(params, results);
+}
+
 } // ns osrm
@@ -273,6 +273,19 @@ void AnnotatedPartition::SearchLevels(const std::vector<SizedID> &implicit_tree,
     }
 }
 
+double AnnotatedPartition::EstimateQueryNodes(const std::vector<CellLevelMetrics> &metrics)
+{
+    if (metrics.empty())
+        return 0.;
+
+    // above the highest level the searches meet on the boundary nodes of all cells
+    double query_nodes = metrics.back().boundary_nodes;
+    for (const auto &level : metrics)
+        query_nodes += 2 * level.query_nodes_per_cell;
+
+    return query_nodes;
+}
+
 AnnotatedPartition::LevelMetrics
 AnnotatedPartition::AnalyseLevel(const BisectionGraph &graph,
                                  const std::vector<std::uint32_t> &cell_ids) const
@@ -2,10 +2,11 @@
 #include "util/integer_range.hpp"
 
 #include <algorithm>
+#include <cstdlib>
+#include <iterator>
 #include <limits>
 #include <numeric>
 #include <queue>
-#include <set>
 #include <stack>
 
 namespace osrm
@@ -18,11 +19,11 @@ namespace
 
 const auto constexpr INVALID_LEVEL = std::numeric_limits<DinicMaxFlow::Level>::max();
 
-auto makeHasNeighborNotInCheck(const DinicMaxFlow::SourceSinkNodes &set, const GraphView &view)
+auto makeHasNeighborNotInCheck(const std::vector<bool> &is_contained, const GraphView &view)
 {
     return [&](const NodeID nid) {
-        const auto is_not_contained = [&set](const BisectionEdge &edge) {
-            return set.count(edge.target) == 0;
+        const auto is_not_contained = [&is_contained](const BisectionEdge &edge) {
+            return !is_contained[edge.target];
         };
         return view.EndEdges(nid) !=
                std::find_if(view.BeginEdges(nid), view.EndEdges(nid), is_not_contained);
@@ -31,44 +32,108 @@ auto makeHasNeighborNotInCheck(const DinicMaxFlow::SourceSinkNodes &set, const G
 
 } // end namespace
 
+DinicMaxFlow::EdgeIndex::EdgeIndex(const GraphView &view)
+{
+    first_edge.reserve(view.NumberOfNodes() + 1);
+    first_edge.push_back(0);
+    for (const auto nid : util::irange<NodeID>(0, view.NumberOfNodes()))
+        first_edge.push_back(first_edge.back() +
+                             std::distance(view.BeginEdges(nid), view.EndEdges(nid)));
+
+    const auto num_edges = first_edge.back();
+    reverse.resize(num_edges, num_edges);
+
+    // position of the edge from `from` to `to`
+    const auto find_edge = [&](const NodeID from, const NodeID to) -> EdgeID {
+        const auto has_target = [to](const BisectionEdge &edge) { return edge.target == to; };
+        const auto itr = std::find_if(view.BeginEdges(from), view.EndEdges(from), has_target);
+        if (itr == view.EndEdges(from))
+            return num_edges;
+        return first_edge[from] + std::distance(view.BeginEdges(from), itr);
+    };
+
+    for (const auto nid : util::irange<NodeID>(0, view.NumberOfNodes()))
+    {
+        auto eid = first_edge[nid];
+        for (const auto &edge : view.Edges(nid))
+        {
+            BOOST_ASSERT(find_edge(nid, edge.target) == eid);
+            // the bisection graph is undirected, so every edge has an opposite direction
+            reverse[eid] = find_edge(edge.target, nid);
+            BOOST_ASSERT(reverse[eid] != num_edges);
+            ++eid;
+        }
+    }
+}
+
+DinicMaxFlow::FlowEdges::FlowEdges(const EdgeIndex &edge_index)
+    : edge_index(edge_index), flow(edge_index.NumberOfEdges() + 1, false)
+{
+}
+
+void DinicMaxFlow::FlowEdges::Augment(const EdgeID eid)
+{
+    // The graph (V,E) contains undirected edges for all (u,v) \in V x V. Since flow can be either
+    // from `s` to `t` or from `t` to `s`, we can remove `(s,t)` from the flow, if we send flow back
+    // the first time, and insert `(t,s)` only if we send flow again.
+    const auto reverse = edge_index.Reverse(eid);
+    if (flow[reverse])
+        flow[reverse] = false; // remove flow from reverse edges first
+    else
+        flow[eid] = true; // only add flow if no opposite flow exists
+    BOOST_ASSERT(!flow.back());
+}
+
+DinicMaxFlow::MinCut DinicMaxFlow::operator()(const GraphView &view,
+                                              const SourceSinkNodes &source_nodes,
+                                              const SourceSinkNodes &sink_nodes) const
+{
+    return (*this)(view, EdgeIndex(view), source_nodes, sink_nodes);
+}
+
 DinicMaxFlow::MinCut DinicMaxFlow::operator()(const GraphView &view,
+                                              const EdgeIndex &edge_index,
                                               const SourceSinkNodes &source_nodes,
                                               const SourceSinkNodes &sink_nodes) const
 {
     BOOST_ASSERT(Validate(view, source_nodes, sink_nodes));
+    BOOST_ASSERT(edge_index.BeginEdge(view.NumberOfNodes()) == edge_index.NumberOfEdges());
     // for the inertial flow algorithm, we use quite a large set of nodes as source/sink nodes. Only
     // a few of them can be part of the process, since they are grouped together. A standard
     // parameterisation would be 25% sink/source nodes. This already includes 50% of the graph. By
     // only focussing on a small set on the outside of the source/sink blob, we can save quite some
     // overhead in initialisation/search cost.
 
+    NodeFlags is_source(view.NumberOfNodes(), false);
+    for (const auto node_id : source_nodes)
+        is_source[node_id] = true;
+    NodeFlags is_sink(view.NumberOfNodes(), false);
+    for (const auto node_id : sink_nodes)
+        is_sink[node_id] = true;
+
     std::vector<NodeID> border_source_nodes;
     border_source_nodes.reserve(0.01 * source_nodes.size());
 
     std::copy_if(source_nodes.begin(),
                  source_nodes.end(),
                  std::back_inserter(border_source_nodes),
-                 makeHasNeighborNotInCheck(source_nodes, view));
+                 makeHasNeighborNotInCheck(is_source, view));
 
     std::vector<NodeID> border_sink_nodes;
     border_sink_nodes.reserve(0.01 * sink_nodes.size());
     std::copy_if(sink_nodes.begin(),
                  sink_nodes.end(),
                  std::back_inserter(border_sink_nodes),
-                 makeHasNeighborNotInCheck(sink_nodes, view));
-
-    // edges in current flow that have capacity
-    // The graph (V,E) contains undirected edges for all (u,v) \in V x V. We describe the flow as a
-    // set of vertices (s,t) with flow set to `true`. Since flow can be either from `s` to `t` or
-    // from `t` to `s`, we can remove `(s,t)` from the flow, if we send flow back the first time,
-    // and insert `(t,s)` only if we send flow again.
+                 makeHasNeighborNotInCheck(is_sink, view));
 
-    // allocate storage for the flow
-    FlowEdges flow(view.NumberOfNodes());
+    // allocate storage for the flow, edges in the current flow have no capacity left
+    FlowEdges flow(edge_index);
     std::size_t flow_value = 0;
+    LevelGraph levels(view.NumberOfNodes());
     do
     {
-        auto levels = ComputeLevelGraph(view, border_source_nodes, source_nodes, sink_nodes, flow);
+        ComputeLevelGraph(
+            levels, view, edge_index, border_source_nodes, is_source, is_sink, flow);
 
         // check if the sink can be reached from the source, it's enough to check the border
         const auto separated = std::find_if(border_sink_nodes.begin(),
@@ -79,7 +144,8 @@ DinicMaxFlow::MinCut DinicMaxFlow::operator()(const GraphView &view,
 
         if (!separated)
         {
-            flow_value += BlockingFlow(flow, levels, view, source_nodes, border_sink_nodes);
+            flow_value +=
+                BlockingFlow(flow, levels, view, edge_index, is_source, border_sink_nodes);
         }
         else
         {
@@ -87,38 +153,87 @@ DinicMaxFlow::MinCut DinicMaxFlow::operator()(const GraphView &view,
             // heuristic)
             for (auto s : source_nodes)
                 levels[s] = 0;
-            const auto cut = MakeCut(view, levels, flow_value);
-            return cut;
+            return MakeCut(
+                view, edge_index, levels, border_sink_nodes, sink_nodes, flow, flow_value);
         }
     } while (true);
 }
 
 DinicMaxFlow::MinCut DinicMaxFlow::MakeCut(const GraphView &view,
+                                           const EdgeIndex &edge_index,
                                            const LevelGraph &levels,
+                                           const std::vector<NodeID> &border_sink_nodes,
+                                           const SourceSinkNodes &sink_nodes,
+                                           const FlowEdges &flow,
                                            const std::size_t flow_value) const
 {
     const auto is_valid_level = [](const Level level) { return level != INVALID_LEVEL; };
 
     // all elements within `levels` are on the source side
-    // This part should opt to find the most balanced cut, which is not necessarily the case right
-    // now. There is potential for optimisation here.
+    BOOST_ASSERT(view.NumberOfNodes() == levels.size());
+    const std::size_t source_side_count =
+        std::count_if(levels.begin(), levels.end(), is_valid_level);
+
+    // all nodes that can still reach a sink in the residual graph are on the sink side of the
+    // alternative cut
+    std::vector<bool> reaches_sink(view.NumberOfNodes(), false);
+    std::queue<NodeID> sink_queue;
+    for (const auto node_id : sink_nodes)
+        reaches_sink[node_id] = true;
+    for (const auto node_id : border_sink_nodes)
+        sink_queue.push(node_id);
+
+    std::size_t sink_side_count = sink_nodes.size();
+    while (!sink_queue.empty())
+    {
+        const auto node_id = sink_queue.front();
+        sink_queue.pop();
+
+        auto eid = edge_index.BeginEdge(node_id);
+        for (const auto &edge : view.Edges(node_id))
+        {
+            // the edge can be used towards the sink if there is no flow on it in that direction
+            if (!reaches_sink[edge.target] && !flow.HasReverseFlow(eid))
+            {
+                BOOST_ASSERT(!is_valid_level(levels[edge.target]));
+                reaches_sink[edge.target] = true;
+                sink_queue.push(edge.target);
+                ++sink_side_count;
+            }
+            ++eid;
+        }
+    }
+
+    const auto balance_delta = [&view](const std::size_t num_nodes_source) {
+        const std::int64_t difference =
+            static_cast<std::int64_t>(view.NumberOfNodes()) / 2 - num_nodes_source;
+        return std::abs(difference);
+    };
+
     std::vector<bool> result(view.NumberOfNodes());
+    const auto alternative_source_side_count = view.NumberOfNodes() - sink_side_count;
+    if (balance_delta(alternative_source_side_count) < balance_delta(source_side_count))
+    {
+        std::transform(reaches_sink.begin(),
+                       reaches_sink.end(),
+                       result.begin(),
+                       [](const bool reaches) { return !reaches; });
+        return {alternative_source_side_count, flow_value, std::move(result)};
+    }
 
-    BOOST_ASSERT(view.NumberOfNodes() == levels.size());
-    std::size_t source_side_count = std::count_if(levels.begin(), levels.end(), is_valid_level);
     std::transform(levels.begin(), levels.end(), result.begin(), is_valid_level);
-
     return {source_side_count, flow_value, std::move(result)};
 }
 
-DinicMaxFlow::LevelGraph
-DinicMaxFlow::ComputeLevelGraph(const GraphView &view,
-                                const std::vector<NodeID> &border_source_nodes,
-                                const SourceSinkNodes &source_nodes,
-                                const SourceSinkNodes &sink_nodes,
-                                const FlowEdges &flow) const
+void DinicMaxFlow::ComputeLevelGraph(LevelGraph &levels,
+                                     const GraphView &view,
+                                     const EdgeIndex &edge_index,
+                                     const std::vector<NodeID> &border_source_nodes,
+                                     const NodeFlags &is_source,
+                                     const NodeFlags &is_sink,
+                                     const FlowEdges &flow) const
 {
-    LevelGraph levels(view.NumberOfNodes(), INVALID_LEVEL);
+    std::fill(levels.begin(), levels.end(), INVALID_LEVEL);
     std::queue<NodeID> level_queue;
 
     // set the front of the source nodes to zero and add them to the BFS queue. In addition, set all
@@ -129,34 +244,28 @@ DinicMaxFlow::ComputeLevelGraph(const GraphView &view,
         levels[node_id] = 0;
         level_queue.push(node_id);
         for (const auto &edge : view.Edges(node_id))
-            if (source_nodes.count(edge.target))
+            if (is_source[edge.target])
                 levels[edge.target] = 0;
     }
-    // check if there is flow present on an edge
-    const auto has_flow = [&](const NodeID from, const NodeID to) {
-        return flow[from].find(to) != flow[from].end();
-    };
 
     // perform a relaxation step in the BFS algorithm
     const auto relax_node = [&](const NodeID node_id) {
         // don't relax sink nodes
-        if (sink_nodes.count(node_id))
+        if (is_sink[node_id])
             return;
 
         const auto level = levels[node_id] + 1;
+        auto eid = edge_index.BeginEdge(node_id);
         for (const auto &edge : view.Edges(node_id))
         {
             const auto target = edge.target;
-            // don't relax edges with flow on them
-            if (has_flow(node_id, target))
-                continue;
-
-            // don't go back, only follow edges to new nodes
-            if (levels[target] > level)
+            // don't relax edges with flow on them, don't go back, only follow edges to new nodes
+            if (!flow.HasFlow(eid) && levels[target] > level)
             {
                 level_queue.push(target);
                 levels[target] = level;
             }
+            ++eid;
         }
     };
 
@@ -166,40 +275,19 @@ DinicMaxFlow::ComputeLevelGraph(const GraphView &view,
         relax_node(level_queue.front());
         level_queue.pop();
     }
-
-    return levels;
 }
 
 std::size_t DinicMaxFlow::BlockingFlow(FlowEdges &flow,
                                        LevelGraph &levels,
                                        const GraphView &view,
-                                       const SourceSinkNodes &source_nodes,
+                                       const EdgeIndex &edge_index,
+                                       const NodeFlags &is_source,
                                        const std::vector<NodeID> &border_sink_nodes) const
 {
     // track the number of augmenting paths (which in sum will equal the number of unique border
     // edges) (since our graph is undirected)
     std::size_t flow_increase = 0;
 
-    // augment the flow along a path in the level graph
-    const auto augment_flow = [&flow, &view](const std::vector<NodeID> &path) {
-
-        // add/remove flow edges from the current residual graph
-        const auto augment_one = [&flow, &view](const NodeID from, const NodeID to) {
-            // check if there is flow in the opposite direction
-            auto existing_edge = flow[to].find(from);
-            if (existing_edge != flow[to].end())
-                flow[to].erase(existing_edge); // remove flow from reverse edges first
-            else
-                flow[from].insert(to); // only add flow if no opposite flow exists
-
-            // do augmentation on all pairs, never stop early:
-            return false;
-        };
-
-        // augment all adjacent edges
-        std::adjacent_find(path.begin(), path.end(), augment_one);
-    };
-
     const auto augment_all_paths = [&](const NodeID sink_node_id) {
         // only augment sinks
         if (levels[sink_node_id] == INVALID_LEVEL)
@@ -208,12 +296,15 @@ std::size_t DinicMaxFlow::BlockingFlow(FlowEdges &flow,
         while (true)
         {
             // as long as there are augmenting paths from the sink, add them
-            const auto path = GetAugmentingPath(levels, sink_node_id, view, flow, source_nodes);
+            const auto path =
+                GetAugmentingPath(levels, sink_node_id, view, edge_index, flow, is_source);
             if (path.empty())
                 break;
             else
             {
-                augment_flow(path);
+                // add/remove flow edges from the current residual graph
+                for (const auto eid : path)
+                    flow.Augment(eid);
                 ++flow_increase;
             }
         }
@@ -226,24 +317,28 @@ std::size_t DinicMaxFlow::BlockingFlow(FlowEdges &flow,
 
 // performs a dfs in the level graph, by adjusting levels that don't offer any further paths to
 // INVALID_LEVEL and by following the level graph, this looks at every edge at most `c` times (O(E))
-std::vector<NodeID> DinicMaxFlow::GetAugmentingPath(LevelGraph &levels,
+std::vector<EdgeID> DinicMaxFlow::GetAugmentingPath(LevelGraph &levels,
                                                     const NodeID node_id,
                                                     const GraphView &view,
+                                                    const EdgeIndex &edge_index,
                                                     const FlowEdges &flow,
-                                                    const SourceSinkNodes &source_nodes) const
+                                                    const NodeFlags &is_source) const
 {
     std::vector<NodeID> path;
-    BOOST_ASSERT(source_nodes.find(node_id) == source_nodes.end());
+    std::vector<EdgeID> path_edges;
+    BOOST_ASSERT(!is_source[node_id]);
 
     // Keeps the local state of the DFS in forms of the iterators
     struct DFSState
     {
         BisectionGraph::ConstEdgeIterator edge_iterator;
         const BisectionGraph::ConstEdgeIterator end_iterator;
+        EdgeID edge_id;
     };
 
     std::stack<DFSState> dfs_stack;
-    DFSState initial_state = {view.BeginEdges(node_id), view.EndEdges(node_id)};
+    DFSState initial_state = {
+        view.BeginEdges(node_id), view.EndEdges(node_id), edge_index.BeginEdge(node_id)};
     dfs_stack.push(std::move(initial_state));
     path.push_back(node_id);
 
@@ -251,62 +346,78 @@ std::vector<NodeID> DinicMaxFlow::GetAugmentingPath(LevelGraph &levels,
     {
         // the dfs_stack and the path have to be kept in sync
         BOOST_ASSERT(dfs_stack.size() == path.size());
+        BOOST_ASSERT(path_edges.size() + 1 == path.size());
 
         while (dfs_stack.top().edge_iterator != dfs_stack.top().end_iterator)
         {
             const auto target = dfs_stack.top().edge_iterator->target;
+            const auto edge_id = dfs_stack.top().edge_id;
 
             // look at every edge only once, so advance the state of the current node (last in
             // path)
             dfs_stack.top().edge_iterator++;
+            dfs_stack.top().edge_id++;
 
-            // check if the edge is valid
-            const auto has_capacity = flow[target].count(path.back()) == 0;
+            // check if the edge is valid, the path leads from the target to the current node
+            const auto has_capacity = !flow.HasReverseFlow(edge_id);
             const auto descends_level_graph = levels[target] + 1 == levels[path.back()];
 
             if (has_capacity && descends_level_graph)
             {
                 // recurse
                 path.push_back(target);
+                path_edges.push_back(edge_index.Reverse(edge_id));
 
                 // termination
-                if (source_nodes.find(target) != source_nodes.end())
+                if (is_source[target])
                 {
-                    std::reverse(path.begin(), path.end());
-                    return path;
+                    std::reverse(path_edges.begin(), path_edges.end());
+                    return path_edges;
                 }
 
                 // start next iteration
-                dfs_stack.push({view.BeginEdges(target), view.EndEdges(target)});
+                dfs_stack.push(
+                    {view.BeginEdges(target), view.EndEdges(target), edge_index.BeginEdge(target)});
             }
         }
 
         // backtrack - mark that there is no way to the target
         levels[path.back()] = -1;
         path.pop_back();
+        if (!path_edges.empty())
+            path_edges.pop_back();
         dfs_stack.pop();
     }
     BOOST_ASSERT(path.empty());
-    return path;
+    BOOST_ASSERT(path_edges.empty());
+    return path_edges;
 }
 
 bool DinicMaxFlow::Validate(const GraphView &view,
                             const SourceSinkNodes &source_nodes,
                             const SourceSinkNodes &sink_nodes) const
 {
-    // sink and source cannot share a common node
-    const auto separated =
-        std::find_if(source_nodes.begin(), source_nodes.end(), [&sink_nodes](const auto node) {
-            return sink_nodes.count(node);
-        }) == source_nodes.end();
-
     const auto invalid_id = [&view](const NodeID nid) { return nid >= view.NumberOfNodes(); };
     const auto in_range_source =
         std::find_if(source_nodes.begin(), source_nodes.end(), invalid_id) == source_nodes.end();
     const auto in_range_sink =
         std::find_if(sink_nodes.begin(), sink_nodes.end(), invalid_id) == sink_nodes.end();
 
-    return separated && in_range_source && in_range_sink;
+    if (!in_range_source || !in_range_sink)
+        return false;
+
+    // nodes can only be listed once and sink and source cannot share a common node
+    std::vector<bool> listed(view.NumberOfNodes(), false);
+    const auto listed_before = [&listed](const NodeID nid) {
+        const bool was_listed = listed[nid];
+        listed[nid] = true;
+        return was_listed;
+    };
+    const auto separated =
+        std::none_of(source_nodes.begin(), source_nodes.end(), listed_before) &&
+        std::none_of(sink_nodes.begin(), sink_nodes.end(), listed_before);
+
+    return separated;
 }
 
 } // namespace partition
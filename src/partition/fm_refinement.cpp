@@ -0,0 +1,173 @@
+#include "partition/fm_refinement.hpp"
+
+#include "util/integer_range.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <queue>
+#include <tuple>
+#include <vector>
+
+namespace osrm
+{
+namespace partition
+{
+
+namespace
+{
+
+// a pass gives up after this many moves that did not result in a better cut
+const constexpr std::size_t MAX_MOVES_WITHOUT_IMPROVEMENT = 100;
+
+// the reduction of crossing edges when moving a node to the other side
+using Gain = std::int64_t;
+
+struct Move
+{
+    Gain gain;
+    NodeID node;
+
+    // the priority queue returns the largest gain first, ties are broken by the node id to be
+    // independent of the order of insertion
+    bool operator<(const Move &other) const
+    {
+        return std::tie(gain, other.node) < std::tie(other.gain, node);
+    }
+};
+
+Gain computeGain(const GraphView &view, const std::vector<bool> &side, const NodeID nid)
+{
+    Gain gain = 0;
+    for (const auto &edge : view.Edges(nid))
+        gain += side[edge.target] != side[nid] ? 1 : -1;
+    return gain;
+}
+
+std::size_t countCrossingEdges(const GraphView &view, const std::vector<bool> &side)
+{
+    std::size_t crossing_edges = 0;
+    for (const auto nid : util::irange<NodeID>(0, view.NumberOfNodes()))
+        for (const auto &edge : view.Edges(nid))
+            crossing_edges += side[edge.target] != side[nid];
+
+    // the edges of the view are undirected, so every crossing edge was counted from both sides
+    BOOST_ASSERT(crossing_edges % 2 == 0);
+    return crossing_edges / 2;
+}
+
+// Runs a single Fiduccia-Mattheyses pass and returns the reduction of crossing edges. The sides
+// are updated to the best cut that was found during the pass.
+Gain refinePass(const GraphView &view, std::vector<bool> &side, const std::size_t max_side_size)
+{
+    const auto number_of_nodes = view.NumberOfNodes();
+    std::array<std::size_t, 2> side_sizes{{0, 0}};
+    for (const auto nid : util::irange<NodeID>(0, number_of_nodes))
+        ++side_sizes[side[nid]];
+
+    // candidate moves, indexed by the side the node would leave. Entries are not removed when the
+    // gain of a node changes, outdated entries are skipped instead.
+    std::array<std::priority_queue<Move>, 2> moves_from;
+    std::vector<Gain> gains(number_of_nodes);
+    std::vector<bool> locked(number_of_nodes, false);
+    for (const auto nid : util::irange<NodeID>(0, number_of_nodes))
+    {
+        gains[nid] = computeGain(view, side, nid);
+        // only nodes at the cut can improve it, other nodes are added once a neighbor moves
+        const auto degree = std::distance(view.BeginEdges(nid), view.EndEdges(nid));
+        if (gains[nid] > -degree)
+            moves_from[side[nid]].push({gains[nid], nid});
+    }
+
+    const auto has_move_from = [&](const bool from) {
+        auto &queue = moves_from[from];
+        while (!queue.empty() &&
+               (locked[queue.top().node] || queue.top().gain != gains[queue.top().node]))
+            queue.pop();
+        // a node can only leave a side if the other side does not get too large
+        return !queue.empty() && side_sizes[!from] < max_side_size;
+    };
+
+    std::vector<NodeID> moved_nodes;
+    Gain total_gain = 0;
+    Gain best_gain = 0;
+    std::size_t best_num_moves = 0;
+    std::size_t best_larger_side = std::max(side_sizes[0], side_sizes[1]);
+
+    while (moved_nodes.size() - best_num_moves < MAX_MOVES_WITHOUT_IMPROVEMENT)
+    {
+        const auto from_false = has_move_from(false);
+        const auto from_true = has_move_from(true);
+        if (!from_false && !from_true)
+            break;
+
+        // take the best move, on equal gains move away from the larger side
+        bool from = from_true;
+        if (from_false && from_true)
+            from = std::make_tuple(moves_from[true].top().gain, side_sizes[true]) >
+                   std::make_tuple(moves_from[false].top().gain, side_sizes[false]);
+
+        const auto move = moves_from[from].top();
+        moves_from[from].pop();
+
+        locked[move.node] = true;
+        side[move.node] = !from;
+        --side_sizes[from];
+        ++side_sizes[!from];
+        total_gain += move.gain;
+        moved_nodes.push_back(move.node);
+
+        for (const auto &edge : view.Edges(move.node))
+        {
+            // edges to the new side stop crossing the cut, edges to the old side start crossing it
+            gains[edge.target] += side[edge.target] == side[move.node] ? -2 : 2;
+            if (!locked[edge.target])
+                moves_from[side[edge.target]].push({gains[edge.target], edge.target});
+        }
+
+        const auto larger_side = std::max(side_sizes[0], side_sizes[1]);
+        if (total_gain > best_gain || (total_gain == best_gain && larger_side < best_larger_side))
+        {
+            best_gain = total_gain;
+            best_num_moves = moved_nodes.size();
+            best_larger_side = larger_side;
+        }
+    }
+
+    // undo all moves after the best cut
+    std::for_each(moved_nodes.begin() + best_num_moves, moved_nodes.end(), [&](const NodeID nid) {
+        side[nid] = !side[nid];
+    });
+
+    return best_gain;
+}
+
+} // namespace
+
+DinicMaxFlow::MinCut refineCut(const GraphView &view,
+                               DinicMaxFlow::MinCut cut,
+                               const double balance,
+                               const std::size_t num_passes)
+{
+    BOOST_ASSERT(cut.flags.size() == view.NumberOfNodes());
+
+    const std::size_t larger_side =
+        std::max(cut.num_nodes_source, view.NumberOfNodes() - cut.num_nodes_source);
+    const std::size_t max_side_size =
+        std::max<std::size_t>(balance * (view.NumberOfNodes() / 2), larger_side);
+
+    for (std::size_t pass = 0; pass < num_passes; ++pass)
+    {
+        if (refinePass(view, cut.flags, max_side_size) <= 0)
+            break;
+    }
+
+    cut.num_nodes_source = std::count(cut.flags.begin(), cut.flags.end(), true);
+    cut.num_edges = countCrossingEdges(view, cut.flags);
+    return cut;
+}
+
+} // namespace partition
+} // namespace osrm
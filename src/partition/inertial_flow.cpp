@@ -9,7 +9,6 @@
 #include <mutex>
 #include <set>
 #include <tuple>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -26,8 +25,8 @@ namespace
 // The node ids refer to nodes in the GraphView.
 struct SpatialOrder
 {
-    std::unordered_set<NodeID> sources;
-    std::unordered_set<NodeID> sinks;
+    DinicMaxFlow::SourceSinkNodes sources;
+    DinicMaxFlow::SourceSinkNodes sinks;
 };
 
 // Creates a spatial order of n * sources "first" and n * sink "last" node ids.
@@ -79,10 +78,10 @@ SpatialOrder makeSpatialOrder(const GraphView &view, const double ratio, const d
     order.sinks.reserve(n);
 
     for (auto it = begin(embedding), last = begin(embedding) + n; it != last; ++it)
-        order.sources.insert(it->nid);
+        order.sources.push_back(it->nid);
 
     for (auto it = end(embedding) - n, last = end(embedding); it != last; ++it)
-        order.sinks.insert(it->nid);
+        order.sinks.push_back(it->nid);
 
     return order;
 }
@@ -110,6 +109,9 @@ bestMinCut(const GraphView &view, const std::size_t n, const double ratio, const
 
     std::mutex lock;
 
+    // the numbering of the edges is the same for all slopes
+    const DinicMaxFlow::EdgeIndex edge_index(view);
+
     tbb::blocked_range<std::size_t> range{0, n, 1};
 
     const auto balance_delta = [&view](const auto num_nodes_source) {
@@ -124,7 +126,7 @@ bestMinCut(const GraphView &view, const std::size_t n, const double ratio, const
             const auto slope = -1. + round * (2. / n);
 
             auto order = makeSpatialOrder(view, ratio, slope);
-            auto cut = DinicMaxFlow()(view, order.sources, order.sinks);
+            auto cut = DinicMaxFlow()(view, edge_index, order.sources, order.sinks);
             auto cut_balance = get_balance(cut.num_nodes_source);
 
             {
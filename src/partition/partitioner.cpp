@@ -1,4 +1,5 @@
 #include "partition/partitioner.hpp"
+#include "partition/annotated_partition.hpp"
 #include "partition/bisection_graph.hpp"
 #include "partition/bisection_to_partition.hpp"
 #include "partition/cell_storage.hpp"
@@ -17,13 +18,17 @@
 #include "util/geojson_debug_policies.hpp"
 #include "util/integer_range.hpp"
 #include "util/json_container.hpp"
+#include "util/json_renderer.hpp"
 #include "util/log.hpp"
+#include "util/meminfo.hpp"
 #include "util/mmap_file.hpp"
 
 #include <algorithm>
 #include <iterator>
 #include <vector>
 
+#include <boost/filesystem/fstream.hpp>
+
 #include <boost/assert.hpp>
 #include <boost/filesystem/operations.hpp>
 
@@ -37,6 +42,40 @@ namespace osrm
 namespace partition
 {
 
+namespace
+{
+void WriteReport(const boost::filesystem::path &path,
+                 const std::vector<AnnotatedPartition::CellLevelMetrics> &metrics,
+                 const double query_nodes)
+{
+    util::json::Array levels;
+    for (const auto &level : metrics)
+    {
+        util::json::Object json_level;
+        json_level.values["max_cell_size"] = util::json::Number(level.max_cell_size);
+        json_level.values["cells"] = util::json::Number(level.number_of_cells);
+        json_level.values["largest_cell"] = util::json::Number(level.largest_cell);
+        json_level.values["oversized_cells"] = util::json::Number(level.oversized_cells);
+        json_level.values["boundary_nodes"] = util::json::Number(level.boundary_nodes);
+        json_level.values["max_boundary_nodes_per_cell"] =
+            util::json::Number(level.max_boundary_nodes_per_cell);
+        json_level.values["clique_entries"] = util::json::Number(level.clique_entries);
+        json_level.values["max_clique_entries"] = util::json::Number(level.max_clique_entries);
+        json_level.values["customization_cost"] = util::json::Number(level.customization_cost);
+        json_level.values["query_nodes_per_cell"] = util::json::Number(level.query_nodes_per_cell);
+        levels.values.push_back(std::move(json_level));
+    }
+
+    util::json::Object report;
+    report.values["levels"] = std::move(levels);
+    report.values["query_nodes"] = util::json::Number(query_nodes);
+
+    boost::filesystem::ofstream out(path);
+    util::json::render(out, report);
+    out << std::endl;
+}
+}
+
 void LogGeojson(const std::string &filename, const std::vector<std::uint32_t> &bisection_ids)
 {
     // reload graph, since we destroyed the old one
@@ -46,12 +85,9 @@ void LogGeojson(const std::string &filename, const std::vector<std::uint32_t> &b
                 << compressed_node_based_graph.edges.size() << " edges, "
                 << compressed_node_based_graph.coordinates.size() << " nodes";
 
-    groupEdgesBySource(begin(compressed_node_based_graph.edges),
-                       end(compressed_node_based_graph.edges));
-
-    auto graph =
-        makeBisectionGraph(compressed_node_based_graph.coordinates,
-                           adaptToBisectionEdge(std::move(compressed_node_based_graph.edges)));
+    // the edges are stored grouped by source and are used directly from the mapped file
+    auto graph = makeBisectionGraph(compressed_node_based_graph.coordinates,
+                                    compressed_node_based_graph.edges);
 
     const auto get_level = [](const std::uint32_t lhs, const std::uint32_t rhs) {
         auto xored = lhs ^ rhs;
@@ -97,30 +133,37 @@ void LogGeojson(const std::string &filename, const std::vector<std::uint32_t> &b
 
 int Partitioner::Run(const PartitionConfig &config)
 {
-    auto compressed_node_based_graph =
-        LoadCompressedNodeBasedGraph(config.compressed_node_based_graph_path.string());
-
-    util::Log() << "Loaded compressed node based graph: "
-                << compressed_node_based_graph.edges.size() << " edges, "
-                << compressed_node_based_graph.coordinates.size() << " nodes";
-
-    groupEdgesBySource(begin(compressed_node_based_graph.edges),
-                       end(compressed_node_based_graph.edges));
-
-    auto graph =
-        makeBisectionGraph(compressed_node_based_graph.coordinates,
-                           adaptToBisectionEdge(std::move(compressed_node_based_graph.edges)));
-
-    util::Log() << " running partition: " << config.max_cell_sizes.front() << " " << config.balance
-                << " " << config.boundary_factor << " " << config.num_optimizing_cuts << " "
-                << config.small_component_size
-                << " # max_cell_size balance boundary cuts small_component_size";
-    RecursiveBisection recursive_bisection(graph,
-                                           config.max_cell_sizes.front(),
-                                           config.balance,
-                                           config.boundary_factor,
-                                           config.num_optimizing_cuts,
-                                           config.small_component_size);
+    // Partition ids, keyed by node based graph nodes. The bisection graph is only needed to
+    // compute them, so it is released before the edge based graph is loaded.
+    std::vector<BisectionID> node_based_partition_ids;
+    {
+        auto compressed_node_based_graph =
+            LoadCompressedNodeBasedGraph(config.compressed_node_based_graph_path.string());
+
+        util::Log() << "Loaded compressed node based graph: "
+                    << compressed_node_based_graph.edges.size() << " edges, "
+                    << compressed_node_based_graph.coordinates.size() << " nodes";
+
+        // the edges are stored grouped by source and are used directly from the mapped file
+        auto graph = makeBisectionGraph(compressed_node_based_graph.coordinates,
+                                        compressed_node_based_graph.edges);
+        util::DumpMemoryStats("building the bisection graph");
+
+        util::Log() << " running partition: " << config.max_cell_sizes.front() << " "
+                    << config.balance << " " << config.boundary_factor << " "
+                    << config.num_optimizing_cuts << " " << config.small_component_size << " "
+                    << config.num_refinement_passes << " # max_cell_size balance boundary cuts "
+                                                       "small_component_size refinement_passes";
+        RecursiveBisection recursive_bisection(graph,
+                                               config.max_cell_sizes.front(),
+                                               config.balance,
+                                               config.boundary_factor,
+                                               config.num_optimizing_cuts,
+                                               config.small_component_size,
+                                               config.num_refinement_passes);
+        node_based_partition_ids = recursive_bisection.BisectionIDs();
+    }
+    util::DumpMemoryStats("recursive bisection");
 
     // Up until now we worked on the compressed node based graph.
     // But what we actually need is a partition for the edge based graph to work on.
@@ -136,12 +179,10 @@ int Partitioner::Run(const PartitionConfig &config)
     util::Log() << "Loaded edge based graph for mapping partition ids: "
                 << edge_based_graph.GetNumberOfEdges() << " edges, "
                 << edge_based_graph.GetNumberOfNodes() << " nodes";
+    util::DumpMemoryStats("loading the edge based graph");
 
     // TODO: node based graph to edge based graph partition id mapping should be done split off.
 
-    // Partition ids, keyed by node based graph nodes
-    const auto &node_based_partition_ids = recursive_bisection.BisectionIDs();
-
     // Partition ids, keyed by edge based graph nodes
     std::vector<NodeID> edge_based_partition_ids(edge_based_graph.GetNumberOfNodes(),
                                                  SPECIAL_NODEID);
@@ -160,6 +201,11 @@ int Partitioner::Run(const PartitionConfig &config)
         if (backward_node != SPECIAL_NODEID)
             edge_based_partition_ids[backward_node] = node_based_partition_ids[v];
     }
+    // release the node based data before the partitions and cells are built
+    mapping.clear();
+    mapping.shrink_to_fit();
+    node_based_partition_ids.clear();
+    node_based_partition_ids.shrink_to_fit();
 
     std::vector<Partition> partitions;
     std::vector<std::uint32_t> level_to_num_cells;
@@ -210,6 +256,20 @@ int Partitioner::Run(const PartitionConfig &config)
     CellStorage storage(mlp, edge_based_graph);
     TIMER_STOP(cell_storage);
     util::Log() << "CellStorage constructed in " << TIMER_SEC(cell_storage) << " seconds";
+    util::DumpMemoryStats("building the cell storage");
+
+    const auto metrics =
+        AnnotatedPartition::AnalyseCells(edge_based_graph, mlp, storage, config.max_cell_sizes);
+    const auto query_nodes = AnnotatedPartition::EstimateQueryNodes(metrics);
+    util::Log() << "Partition quality:";
+    for (std::size_t level = 0; level < metrics.size(); ++level)
+        metrics[level].print(util::Log() << "  ", level + 1);
+    util::Log() << "  estimated nodes settled by a query: " << query_nodes;
+    if (!config.report_path.empty())
+    {
+        WriteReport(config.report_path, metrics, query_nodes);
+        util::Log() << "Wrote partition report to " << config.report_path;
+    }
 
     TIMER_START(writing_mld_data);
     files::writePartition(config.partition_path, mlp);
@@ -1,4 +1,5 @@
 #include "partition/recursive_bisection.hpp"
+#include "partition/fm_refinement.hpp"
 #include "partition/inertial_flow.hpp"
 
 #include "partition/graph_view.hpp"
@@ -27,7 +28,8 @@ RecursiveBisection::RecursiveBisection(BisectionGraph &bisection_graph_,
                                        const double balance,
                                        const double boundary_factor,
                                        const std::size_t num_optimizing_cuts,
-                                       const std::size_t small_component_size)
+                                       const std::size_t small_component_size,
+                                       const std::size_t num_refinement_passes)
     : bisection_graph(bisection_graph_), internal_state(bisection_graph_)
 {
     auto components = internal_state.PrePartitionWithSCC(small_component_size);
@@ -70,8 +72,11 @@ RecursiveBisection::RecursiveBisection(BisectionGraph &bisection_graph_,
 
     // Bisect graph into two parts. Get partition point and recurse left and right in parallel.
     tbb::parallel_do(begin(forest), end(forest), [&](const TreeNode &node, Feeder &feeder) {
-        const auto cut =
+        auto cut =
             computeInertialFlowCut(node.graph, num_optimizing_cuts, balance, boundary_factor);
+        if (num_refinement_passes > 0)
+            cut = refineCut(node.graph, std::move(cut), balance, num_refinement_passes);
+
         const auto center = internal_state.ApplyBisection(
             node.graph.Begin(), node.graph.End(), node.depth, cut.flags);
 
@@ -1,12 +1,16 @@
 #include "server/connection.hpp"
 #include "server/request_handler.hpp"
 #include "server/request_parser.hpp"
+#include "server/request_scheduler.hpp"
+
+#include "util/log.hpp"
 
 #include <boost/assert.hpp>
 #include <boost/bind.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 
+#include <exception>
 #include <iterator>
 #include <string>
 #include <vector>
@@ -16,8 +20,11 @@ namespace osrm
 namespace server
 {
 
-Connection::Connection(boost::asio::io_service &io_service, RequestHandler &handler)
-    : strand(io_service), TCP_socket(io_service), request_handler(handler)
+Connection::Connection(boost::asio::io_service &io_service,
+                       RequestHandler &handler,
+                       RequestScheduler &scheduler)
+    : strand(io_service), TCP_socket(io_service), request_handler(handler),
+      request_scheduler(scheduler)
 {
 }
 
@@ -53,6 +60,53 @@ void Connection::handle_read(const boost::system::error_code &error, std::size_t
     if (result == RequestParser::RequestStatus::valid)
     {
         current_request.endpoint = TCP_socket.remote_endpoint().address();
+
+        // the query itself is run by the scheduler, so that expensive requests can't
+        // block the threads that accept and read new connections
+        const auto request_class = request_scheduler.Classify(current_request.uri);
+        auto self = this->shared_from_this();
+        if (!request_scheduler.Submit(
+                request_class,
+                [self, compression_type] { self->handle_request(compression_type); },
+                [self] { self->reject_request(); }))
+        {
+            util::Log(logDEBUG) << "[scheduler] rejected request with cost "
+                                << request_class.cost << ": " << current_request.uri;
+            current_reply = http::reply::stock_reply(http::reply::service_unavailable);
+
+            boost::asio::async_write(TCP_socket,
+                                     current_reply.to_buffers(),
+                                     strand.wrap(boost::bind(&Connection::handle_write,
+                                                             this->shared_from_this(),
+                                                             boost::asio::placeholders::error)));
+        }
+    }
+    else if (result == RequestParser::RequestStatus::invalid)
+    { // request is not parseable
+        current_reply = http::reply::stock_reply(http::reply::bad_request);
+
+        boost::asio::async_write(TCP_socket,
+                                 current_reply.to_buffers(),
+                                 strand.wrap(boost::bind(&Connection::handle_write,
+                                                         this->shared_from_this(),
+                                                         boost::asio::placeholders::error)));
+    }
+    else
+    {
+        // we don't have a result yet, so continue reading
+        TCP_socket.async_read_some(
+            boost::asio::buffer(incoming_data_buffer),
+            strand.wrap(boost::bind(&Connection::handle_read,
+                                    this->shared_from_this(),
+                                    boost::asio::placeholders::error,
+                                    boost::asio::placeholders::bytes_transferred)));
+    }
+}
+
+void Connection::handle_request(const http::compression_type compression_type)
+{
+    try
+    {
         request_handler.HandleRequest(current_request, current_reply);
 
         // compress the result w/ gzip/deflate if requested
@@ -82,33 +136,32 @@ void Connection::handle_read(const boost::system::error_code &error, std::size_t
             output_buffer = current_reply.to_buffers();
             break;
         }
-        // write result to stream
-        boost::asio::async_write(TCP_socket,
-                                 output_buffer,
-                                 strand.wrap(boost::bind(&Connection::handle_write,
-                                                         this->shared_from_this(),
-                                                         boost::asio::placeholders::error)));
-    }
-    else if (result == RequestParser::RequestStatus::invalid)
-    { // request is not parseable
-        current_reply = http::reply::stock_reply(http::reply::bad_request);
-
-        boost::asio::async_write(TCP_socket,
-                                 current_reply.to_buffers(),
-                                 strand.wrap(boost::bind(&Connection::handle_write,
-                                                         this->shared_from_this(),
-                                                         boost::asio::placeholders::error)));
     }
-    else
+    catch (const std::exception &e)
     {
-        // we don't have a result yet, so continue reading
-        TCP_socket.async_read_some(
-            boost::asio::buffer(incoming_data_buffer),
-            strand.wrap(boost::bind(&Connection::handle_read,
-                                    this->shared_from_this(),
-                                    boost::asio::placeholders::error,
-                                    boost::asio::placeholders::bytes_transferred)));
+        // the client always gets a reply, even if the handler or the compression failed
+        util::Log(logWARNING) << "[server error] " << e.what() << ", uri: " << current_request.uri;
+        current_reply = http::reply::stock_reply(http::reply::internal_server_error);
+        output_buffer = current_reply.to_buffers();
     }
+
+    // write result to stream
+    boost::asio::async_write(TCP_socket,
+                             output_buffer,
+                             strand.wrap(boost::bind(&Connection::handle_write,
+                                                     this->shared_from_this(),
+                                                     boost::asio::placeholders::error)));
+}
+
+void Connection::reject_request()
+{
+    // The scheduler is only stopped on shutdown, after the io_service has been stopped. Thus the
+    // reply is written synchronously, an asynchronous write would never be completed.
+    current_reply = http::reply::stock_reply(http::reply::service_unavailable);
+
+    boost::system::error_code ignore_error;
+    boost::asio::write(TCP_socket, current_reply.to_buffers(), ignore_error);
+    TCP_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignore_error);
 }
 
 /// Handle completion of a write operation.
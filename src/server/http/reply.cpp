@@ -13,11 +13,14 @@ const char ok_html[] = "";
 const char bad_request_html[] = "";
 const char internal_server_error_html[] =
     "{\"code\": \"InternalError\",\"message\":\"Internal Server Error\"}";
+const char service_unavailable_html[] =
+    "{\"code\": \"TooBusy\",\"message\":\"Server is overloaded, try again later\"}";
 const char seperators[] = {':', ' '};
 const char crlf[] = {'\r', '\n'};
 const std::string http_ok_string = "HTTP/1.0 200 OK\r\n";
 const std::string http_bad_request_string = "HTTP/1.0 400 Bad Request\r\n";
 const std::string http_internal_server_error_string = "HTTP/1.0 500 Internal Server Error\r\n";
+const std::string http_service_unavailable_string = "HTTP/1.0 503 Service Unavailable\r\n";
 
 void reply::set_size(const std::size_t size)
 {
@@ -87,6 +90,10 @@ std::string reply::status_to_string(const reply::status_type status)
     {
         return bad_request_html;
     }
+    if (reply::service_unavailable == status)
+    {
+        return service_unavailable_html;
+    }
     return internal_server_error_html;
 }
 
@@ -100,6 +107,10 @@ boost::asio::const_buffer reply::status_to_buffer(const reply::status_type statu
     {
         return boost::asio::buffer(http_internal_server_error_string);
     }
+    if (reply::service_unavailable == status)
+    {
+        return boost::asio::buffer(http_service_unavailable_string);
+    }
     return boost::asio::buffer(http_bad_request_string);
 }
 
@@ -0,0 +1,267 @@
+#include "server/request_scheduler.hpp"
+
+#include "server/api/parsed_url.hpp"
+#include "server/api/url_parser.hpp"
+
+#include "util/log.hpp"
+#include "util/string_util.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+
+namespace osrm
+{
+namespace server
+{
+
+namespace
+{
+const std::string POLYLINE_PREFIX = "polyline(";
+const std::string POLYLINE6_PREFIX = "polyline6(";
+
+bool startsWith(const std::string &value, const std::string &prefix)
+{
+    return value.size() >= prefix.size() && std::equal(prefix.begin(), prefix.end(), value.begin());
+}
+
+// Counts the coordinates without decoding them: every coordinate in a polyline
+// consists of two integers and each integer ends in a chunk without continuation bit.
+std::size_t countCoordinates(const std::string &coordinates)
+{
+    if (coordinates.empty())
+        return 0;
+
+    const auto prefix_length = startsWith(coordinates, POLYLINE_PREFIX)
+                                   ? POLYLINE_PREFIX.size()
+                                   : startsWith(coordinates, POLYLINE6_PREFIX)
+                                         ? POLYLINE6_PREFIX.size()
+                                         : 0;
+    if (prefix_length > 0)
+    {
+        const auto num_integers =
+            std::count_if(coordinates.begin() + prefix_length, coordinates.end(), [](char c) {
+                return c != ')' && ((c - 63) & 0x20) == 0;
+            });
+        return std::max<std::size_t>(1, num_integers / 2);
+    }
+
+    return std::count(coordinates.begin(), coordinates.end(), ';') + 1;
+}
+
+// Returns the number of indices of a sources/destinations style option or
+// default_count if the option is not specified or set to 'all'.
+std::size_t
+countIndices(const std::string &options, const std::string &name, const std::size_t default_count)
+{
+    const auto key = name + "=";
+    auto position = options.find(key);
+    while (position != std::string::npos && position != 0 && options[position - 1] != '&')
+    {
+        position = options.find(key, position + 1);
+    }
+    if (position == std::string::npos)
+        return default_count;
+
+    const auto value_begin = position + key.size();
+    const auto value_end = std::min(options.find('&', value_begin), options.size());
+    const auto value = options.substr(value_begin, value_end - value_begin);
+    if (value.empty() || value == "all")
+        return default_count;
+
+    return std::count(value.begin(), value.end(), ';') + 1;
+}
+}
+
+RequestClass classifyRequest(const api::ParsedURL &parsed_url, const std::size_t heavy_request_cost)
+{
+    const auto options_begin = parsed_url.query.find('?');
+    const auto coordinates = parsed_url.query.substr(0, options_begin);
+    const auto options = options_begin == std::string::npos
+                             ? std::string{}
+                             : parsed_url.query.substr(options_begin + 1);
+    const auto num_coordinates = countCoordinates(coordinates);
+
+    RequestClass request_class{RequestPriority::Normal, num_coordinates};
+    if (parsed_url.service == "nearest" || parsed_url.service == "tile")
+    {
+        request_class = {RequestPriority::Interactive, 1};
+    }
+    else if (parsed_url.service == "table")
+    {
+        const auto num_sources = countIndices(options, "sources", num_coordinates);
+        const auto num_destinations = countIndices(options, "destinations", num_coordinates);
+        request_class.cost = num_sources * num_destinations;
+    }
+    else if (parsed_url.service == "trip")
+    {
+        // trip computes a full table before solving the TSP
+        request_class.cost = num_coordinates * num_coordinates;
+    }
+
+    if (request_class.cost > heavy_request_cost)
+    {
+        request_class.priority = RequestPriority::Bulk;
+    }
+
+    return request_class;
+}
+
+RequestScheduler::RequestScheduler(const SchedulerConfig &config)
+    : config(config),
+      // keep a quarter of the workers, but at least one, free for cheap requests
+      max_bulk_workers(config.num_workers > 1
+                           ? std::max(1u, config.num_workers - std::max(1u, config.num_workers / 4))
+                           : 1),
+      running_bulk_tasks(0), num_rejected(0), stopped(false)
+{
+    BOOST_ASSERT(config.num_workers > 0);
+}
+
+RequestScheduler::~RequestScheduler() { Stop(); }
+
+RequestClass RequestScheduler::Classify(const std::string &uri) const
+{
+    std::string request_string;
+    util::URIDecode(uri, request_string);
+
+    auto api_iterator = request_string.begin();
+    const auto maybe_parsed_url = api::parseURL(api_iterator, request_string.end());
+    if (!maybe_parsed_url || api_iterator != request_string.end())
+    {
+        // the request handler will reply with an error, which is cheap
+        return {RequestPriority::Interactive, 1};
+    }
+
+    return classifyRequest(*maybe_parsed_url, config.heavy_request_cost);
+}
+
+bool RequestScheduler::Submit(const RequestClass request_class, Task task, Task reject)
+{
+    const auto index = static_cast<std::size_t>(request_class.priority);
+    BOOST_ASSERT(index < NUM_PRIORITIES);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopped || queues[index].size() >= config.max_queue_size)
+        {
+            ++num_rejected;
+            return false;
+        }
+        queues[index].push_back({std::move(task), std::move(reject)});
+    }
+    task_available.notify_one();
+    return true;
+}
+
+void RequestScheduler::Start()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    BOOST_ASSERT(workers.empty());
+    stopped = false;
+    for (unsigned worker = 0; worker < config.num_workers; ++worker)
+    {
+        workers.emplace_back(&RequestScheduler::Work, this);
+    }
+}
+
+void RequestScheduler::Stop()
+{
+    // Stop can be called concurrently from the signal handler and the server thread
+    std::vector<std::thread> running_workers;
+    std::array<std::deque<QueuedTask>, NUM_PRIORITIES> queued_tasks;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+        queued_tasks.swap(queues);
+        running_workers.swap(workers);
+    }
+    task_available.notify_all();
+
+    // the clients of queued requests still get an answer
+    for (auto &queue : queued_tasks)
+    {
+        for (auto &task : queue)
+        {
+            if (!task.reject)
+                continue;
+
+            try
+            {
+                task.reject();
+            }
+            catch (const std::exception &e)
+            {
+                util::Log(logWARNING) << "[scheduler] rejecting request failed: " << e.what();
+            }
+        }
+    }
+
+    for (auto &worker : running_workers)
+    {
+        worker.join();
+    }
+}
+
+std::size_t RequestScheduler::GetNumRejected() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return num_rejected;
+}
+
+std::size_t RequestScheduler::NextQueue() const
+{
+    for (std::size_t index = 0; index < NUM_PRIORITIES; ++index)
+    {
+        if (queues[index].empty())
+            continue;
+        if (index == static_cast<std::size_t>(RequestPriority::Bulk) &&
+            running_bulk_tasks >= max_bulk_workers)
+            continue;
+        return index;
+    }
+    return NUM_PRIORITIES;
+}
+
+void RequestScheduler::Work()
+{
+    const auto bulk_index = static_cast<std::size_t>(RequestPriority::Bulk);
+
+    while (true)
+    {
+        Task task;
+        std::size_t index;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            task_available.wait(lock, [&] { return stopped || NextQueue() < NUM_PRIORITIES; });
+            if (stopped)
+                return;
+
+            index = NextQueue();
+            task = std::move(queues[index].front().run);
+            queues[index].pop_front();
+            if (index == bulk_index)
+                ++running_bulk_tasks;
+        }
+
+        try
+        {
+            task();
+        }
+        catch (const std::exception &e)
+        {
+            util::Log(logWARNING) << "[scheduler] request failed: " << e.what();
+        }
+
+        if (index == bulk_index)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                --running_bulk_tasks;
+            }
+            // a bulk task might have been waiting for a free slot
+            task_available.notify_one();
+        }
+    }
+}
+}
+}
@@ -6,16 +6,23 @@
 #include "util/timezones.hpp"
 #include "util/version.hpp"
 
+#include <boost/algorithm/string/join.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 #include <boost/program_options/errors.hpp>
+#include <boost/range/adaptor/transformed.hpp>
 
 #include <tbb/task_scheduler_init.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <exception>
+#include <iterator>
 #include <new>
 #include <ostream>
+#include <regex>
+#include <string>
+#include <vector>
 
 #include "util/meminfo.hpp"
 
@@ -28,6 +35,49 @@ enum class return_code : unsigned
     exit
 };
 
+struct WitnessSearchLimitsArgument
+{
+    std::vector<unsigned> value;
+};
+
+std::ostream &operator<<(std::ostream &os, const WitnessSearchLimitsArgument &arg)
+{
+    auto to_string = [](unsigned x) { return std::to_string(x); };
+    return os << boost::algorithm::join(arg.value | boost::adaptors::transformed(to_string), ",");
+}
+
+void validate(boost::any &v,
+              const std::vector<std::string> &values,
+              WitnessSearchLimitsArgument *,
+              int)
+{
+    using namespace boost::program_options;
+
+    // Make sure no previous assignment to 'v' was made.
+    validators::check_first_occurrence(v);
+    // Extract the first string from 'values'. If there is more than
+    // one string, it's an error, and exception will be thrown.
+    const std::string &s = validators::get_single_string(values);
+
+    std::regex re(",");
+    std::vector<unsigned> output;
+    std::transform(std::sregex_token_iterator(s.begin(), s.end(), re, -1),
+                   std::sregex_token_iterator(),
+                   std::back_inserter(output),
+                   [](const auto &x) {
+                       try
+                       {
+                           return boost::lexical_cast<unsigned>(x);
+                       }
+                       catch (const boost::bad_lexical_cast &)
+                       {
+                           throw validation_error(validation_error::invalid_option_value);
+                       }
+                   });
+
+    v = boost::any(WitnessSearchLimitsArgument{output});
+}
+
 return_code parseArguments(int argc, char *argv[], contractor::ContractorConfig &contractor_config)
 {
     // declare a group of options that will be allowed only on command line
@@ -57,7 +107,24 @@ return_code parseArguments(int argc, char *argv[], contractor::ContractorConfig
         "level-cache,o",
         boost::program_options::value<bool>(&contractor_config.use_cached_priority)
             ->default_value(false),
-        "Use .level file to retain the contaction level for each node from the last run.")(
+        "Use .level file to retain the contaction level for each node from the last run. The "
+        "contraction skips the node priority computation and only re-contracts the nodes in the "
+        "previous order, which is much faster for new weights.")(
+        "renumber-nodes",
+        boost::program_options::value<bool>(&contractor_config.renumber_nodes)
+            ->default_value(true),
+        "Renumber the nodes in the order of the hierarchy for a better cache locality of queries. "
+        "Skipped if the nodes were already renumbered by osrm-partition.")(
+        "witness-search-nodes",
+        boost::program_options::value<WitnessSearchLimitsArgument>()->default_value(
+            WitnessSearchLimitsArgument{contractor_config.witness_search_nodes}),
+        "Maximum numbers of nodes settled by a witness search, one for each phase of the "
+        "contraction. The phases split the contracted nodes evenly.")(
+        "witness-search-hops",
+        boost::program_options::value<WitnessSearchLimitsArgument>()->default_value(
+            WitnessSearchLimitsArgument{contractor_config.witness_search_hops}),
+        "Maximum numbers of edges of a witness path, one for each phase of the contraction. "
+        "0 does not limit the number of edges.")(
         "edge-weight-updates-over-factor",
         boost::program_options::value<double>(
             &contractor_config.updater_config.log_edge_updates_factor)
@@ -132,6 +199,23 @@ return_code parseArguments(int argc, char *argv[], contractor::ContractorConfig
         return return_code::fail;
     }
 
+    contractor_config.witness_search_nodes =
+        option_variables["witness-search-nodes"].as<WitnessSearchLimitsArgument>().value;
+    contractor_config.witness_search_hops =
+        option_variables["witness-search-hops"].as<WitnessSearchLimitsArgument>().value;
+
+    const auto &nodes = contractor_config.witness_search_nodes;
+    if (nodes.empty() || std::find(nodes.begin(), nodes.end(), 0) != nodes.end())
+    {
+        util::Log(logERROR) << "The witness searches must settle at least one node.";
+        return return_code::fail;
+    }
+    if (contractor_config.witness_search_hops.empty())
+    {
+        util::Log(logERROR) << "The witness search hop limits must not be empty.";
+        return return_code::fail;
+    }
+
     return return_code::ok;
 }
 
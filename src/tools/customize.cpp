@@ -36,6 +36,11 @@ parseArguments(int argc, char *argv[], customizer::CustomizationConfig &customiz
          boost::program_options::value<unsigned int>(&customization_config.requested_num_threads)
              ->default_value(tbb::task_scheduler_init::default_num_threads()),
          "Number of threads to use")(
+            "cch",
+            boost::program_options::bool_switch(&customization_config.customize_cch)
+                ->default_value(false),
+            "Build a customizable contraction hierarchy in the node order of the partition and "
+            "write it as .hsgr for the CH algorithm instead of customizing the cells for MLD")(
             "segment-speed-file",
             boost::program_options::value<std::vector<std::string>>(
                 &customization_config.updater_config.segment_speed_lookup_paths)
@@ -6,12 +6,15 @@
 
 #include <tbb/task_scheduler_init.h>
 
+#include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
 #include <cstdlib>
 #include <exception>
 #include <new>
+#include <string>
+#include <vector>
 
 #include "util/meminfo.hpp"
 
@@ -30,6 +33,8 @@ return_code parseArguments(int argc, char *argv[], extractor::ExtractorConfig &e
     boost::program_options::options_description generic_options("Options");
     generic_options.add_options()("version,v", "Show version")("help,h", "Show this help message");
 
+    std::string stages;
+
     // declare a group of options that will be allowed both on command line
     boost::program_options::options_description config_options("Configuration");
     config_options.add_options()(
@@ -56,7 +61,38 @@ return_code parseArguments(int argc, char *argv[], extractor::ExtractorConfig &e
             ->implicit_value(true)
             ->default_value(false),
         "Save conditional restrictions found during extraction to disk for use "
-        "during contraction");
+        "during contraction")(
+        "sort-memory",
+        boost::program_options::value<std::size_t>(&extractor_config.sort_memory)
+            ->default_value(4096),
+        "Memory in MiB used for sorting. Larger data is sorted in runs stored next to the "
+        "output files.")(
+        "change-file",
+        boost::program_options::value<std::vector<boost::filesystem::path>>(
+            &extractor_config.change_file_paths)
+            ->composing(),
+        "OSM change files (.osc) that are applied to the input file while it is read, in the "
+        "given order. The input file has to be sorted by type and id. The complete merged "
+        "input is extracted, the extraction is not incremental.")(
+        "check-change-merge",
+        boost::program_options::bool_switch(&extractor_config.check_change_merge)
+            ->default_value(false),
+        "Self-check of --change-file: compare the merged input against a merge of all objects "
+        "in memory before extracting. Only checks the input, not the extraction, and is limited "
+        "to input files of up to 1 GiB.")(
+        "stages",
+        boost::program_options::value<std::string>(&stages)->default_value("parse,expand,rtree"),
+        "Comma separated stages to run: parse, expand and rtree. If not all stages are run, "
+        "every stage stores a checkpoint that the next stage reads.")(
+        "resume",
+        boost::program_options::bool_switch(&extractor_config.resume)->default_value(false),
+        "Store checkpoints and skip stages whose checkpoint from an earlier run was written "
+        "with the same options and profile, is newer than their inputs and whose outputs "
+        "exist.")(
+        "keep-checkpoints",
+        boost::program_options::bool_switch(&extractor_config.keep_checkpoints)
+            ->default_value(false),
+        "Keep the checkpoints after the last stage finished.");
 
     bool dummy;
     // hidden options, will be allowed on command line, but will not be
@@ -114,6 +150,25 @@ return_code parseArguments(int argc, char *argv[], extractor::ExtractorConfig &e
 
     boost::program_options::notify(option_variables);
 
+    extractor_config.stages.clear();
+    std::vector<std::string> stage_names;
+    boost::split(stage_names, stages, boost::is_any_of(","));
+    for (const auto &stage_name : stage_names)
+    {
+        if (stage_name == "parse")
+            extractor_config.stages.push_back(extractor::ExtractorConfig::Stage::Parse);
+        else if (stage_name == "expand")
+            extractor_config.stages.push_back(extractor::ExtractorConfig::Stage::Expand);
+        else if (stage_name == "rtree")
+            extractor_config.stages.push_back(extractor::ExtractorConfig::Stage::RTree);
+        else
+        {
+            util::Log(logERROR) << "Unknown stage " << stage_name
+                                << ", valid stages are parse, expand and rtree";
+            return return_code::fail;
+        }
+    }
+
     if (!option_variables.count("input"))
     {
         std::cout << visible_options;
@@ -155,6 +210,15 @@ int main(int argc, char *argv[]) try
         return EXIT_FAILURE;
     }
 
+    for (const auto &change_file : extractor_config.change_file_paths)
+    {
+        if (!boost::filesystem::is_regular_file(change_file))
+        {
+            util::Log(logERROR) << "Change file " << change_file.string() << " not found!";
+            return EXIT_FAILURE;
+        }
+    }
+
     if (!boost::filesystem::is_regular_file(extractor_config.profile_path))
     {
         util::Log(logERROR) << "Profile " << extractor_config.profile_path.string()
@@ -103,11 +103,21 @@ return_code parseArguments(int argc, char *argv[], partition::PartitionConfig &c
              ->default_value(config.small_component_size),
          "Size threshold for small components.")
         //
+        ("refinement-passes",
+         boost::program_options::value<std::size_t>(&config.num_refinement_passes)
+             ->default_value(config.num_refinement_passes),
+         "Number of Fiduccia-Mattheyses passes to reduce the boundary of every bisection")
+        //
         ("max-cell-sizes",
          boost::program_options::value<MaxCellSizesArgument>()->default_value(
              MaxCellSizesArgument{config.max_cell_sizes}),
          "Maximum cell sizes starting from the level 1. The first cell size value is a bisection "
-         "termination citerion");
+         "termination citerion")
+        //
+        ("report",
+         boost::program_options::value<boost::filesystem::path>(&config.report_path),
+         "Write a JSON report on the boundary nodes, clique sizes, customization cost and query "
+         "size of every level to this file");
 
     // hidden options, will be allowed on command line, but will not be
     // shown to the user
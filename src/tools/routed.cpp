@@ -76,7 +76,9 @@ inline unsigned generateServerProgramOptions(const int argc,
                                              int &max_locations_viaroute,
                                              int &max_locations_distance_table,
                                              int &max_locations_map_matching,
-                                             int &max_results_nearest)
+                                             int &max_results_nearest,
+                                             std::size_t &phantom_node_cache_size,
+                                             server::SchedulerConfig &scheduler_config)
 {
     using boost::program_options::value;
     using boost::filesystem::path;
@@ -119,7 +121,18 @@ inline unsigned generateServerProgramOptions(const int argc,
          "Max. locations supported in map matching query") //
         ("max-nearest-size",
          value<int>(&max_results_nearest)->default_value(100),
-         "Max. results supported in nearest query");
+         "Max. results supported in nearest query") //
+        ("phantom-node-cache-size",
+         value<std::size_t>(&phantom_node_cache_size)->default_value(0),
+         "Number of snapping results to cache for repeatedly requested coordinates, 0 disables "
+         "the cache") //
+        ("max-queue-size",
+         value<std::size_t>(&scheduler_config.max_queue_size)->default_value(1024),
+         "Max. number of requests waiting per priority class before new ones are rejected with "
+         "503") //
+        ("heavy-request-cost",
+         value<std::size_t>(&scheduler_config.heavy_request_cost)->default_value(2500),
+         "Requests with more source/destination pairs are scheduled with the lowest priority");
 
     // hidden options, will be allowed on command line, but will not be shown to the user
     boost::program_options::options_description hidden_options("Hidden options");
@@ -195,6 +208,7 @@ int main(int argc, const char *argv[]) try
     int ip_port, requested_thread_num;
 
     EngineConfig config;
+    server::SchedulerConfig scheduler_config;
     boost::filesystem::path base_path;
     std::string algorithm;
     const unsigned init_result = generateServerProgramOptions(argc,
@@ -210,7 +224,9 @@ int main(int argc, const char *argv[]) try
                                                               config.max_locations_viaroute,
                                                               config.max_locations_distance_table,
                                                               config.max_locations_map_matching,
-                                                              config.max_results_nearest);
+                                                              config.max_results_nearest,
+                                                              config.phantom_node_cache_size,
+                                                              scheduler_config);
     if (init_result == INIT_OK_DO_NOT_START_ENGINE)
     {
         return EXIT_SUCCESS;
@@ -248,6 +264,11 @@ int main(int argc, const char *argv[]) try
     util::Log() << "Threads: " << requested_thread_num;
     util::Log() << "IP address: " << ip_address;
     util::Log() << "IP port: " << ip_port;
+    util::Log() << "Max. queue size: " << scheduler_config.max_queue_size;
+    if (config.phantom_node_cache_size > 0)
+    {
+        util::Log() << "Phantom node cache size: " << config.phantom_node_cache_size;
+    }
 
 #ifndef _WIN32
     int sig = 0;
@@ -257,7 +278,8 @@ int main(int argc, const char *argv[]) try
     pthread_sigmask(SIG_BLOCK, &new_mask, &old_mask);
 #endif
 
-    auto routing_server = server::Server::CreateServer(ip_address, ip_port, requested_thread_num);
+    auto routing_server = server::Server::CreateServer(
+        ip_address, ip_port, requested_thread_num, scheduler_config);
     auto service_handler = std::make_unique<server::ServiceHandler>(config);
 
     routing_server->RegisterServiceHandler(std::move(service_handler));
@@ -542,4 +542,24 @@ test('route: throws on bad approaches', function(assert) {
         approaches: [10, 15]
     }, function(err, route) {}) },
         /Approach must be a string: \[curb, unrestricted\] or null/);
-});
\ No newline at end of file
+});
+
+test('route: routes a batch of queries in order', function(assert) {
+    assert.plan(7);
+    var osrm = new OSRM(monaco_path);
+    var options = [
+        {coordinates: two_test_coordinates},
+        {coordinates: three_test_coordinates},
+        {coordinates: [[0, 0], [0.001, 0]], radiuses: [1, 1]}
+    ];
+    osrm.routeBatch(options, function(err, results) {
+        assert.ifError(err);
+        assert.equal(results.length, 3);
+        assert.equal(results[0].waypoints.length, 2);
+        assert.equal(results[1].waypoints.length, 3);
+        assert.notOk(results[0].code);
+        assert.equal(results[2].code, 'NoSegment');
+        assert.throws(function() { osrm.routeBatch({coordinates: two_test_coordinates}, function(err, results) {}); },
+            /First arg must be an array of objects/);
+    });
+});
@@ -1,6 +1,7 @@
 var OSRM = require('../../');
 var test = require('tape');
 var data_path = require('./constants').data_path;
+var corech_data_path = require('./constants').corech_data_path;
 var three_test_coordinates = require('./constants').three_test_coordinates;
 var two_test_coordinates = require('./constants').two_test_coordinates;
 
@@ -35,6 +36,22 @@ test('table: distance table in Monaco', function(assert) {
     });
 });
 
+test('table: distance table in Monaco on CoreCH matches CH', function(assert) {
+    assert.plan(3);
+    var osrm = new OSRM(data_path);
+    var corech = new OSRM({path: corech_data_path, algorithm: 'CoreCH'});
+    var options = {
+        coordinates: three_test_coordinates
+    };
+    osrm.table(options, function(err, table) {
+        assert.ifError(err);
+        corech.table(options, function(err, corech_table) {
+            assert.ifError(err);
+            assert.deepEqual(corech_table.durations, table.durations);
+        });
+    });
+});
+
 test('table: distance table in Monaco with sources/destinations', function(assert) {
     assert.plan(7);
     var osrm = new OSRM(data_path);
@@ -166,3 +183,19 @@ test('table: distance table in Monaco without hints', function(assert) {
         table.destinations.map(assertHasNoHints);
     });
 });
+
+test('table: distance tables for a batch of queries in order', function(assert) {
+    assert.plan(5);
+    var osrm = new OSRM(data_path);
+    var options = [
+        {coordinates: three_test_coordinates},
+        {coordinates: two_test_coordinates, sources: [0]}
+    ];
+    osrm.tableBatch(options, function(err, results) {
+        assert.ifError(err);
+        assert.equal(results.length, 2);
+        assert.equal(results[0].durations.length, 3);
+        assert.equal(results[1].durations.length, 1);
+        assert.equal(results[1].durations[0].length, 2);
+    });
+});
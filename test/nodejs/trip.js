@@ -1,6 +1,7 @@
 var OSRM = require('../../');
 var test = require('tape');
 var data_path = require('./constants').data_path;
+var corech_data_path = require('./constants').corech_data_path;
 var three_test_coordinates = require('./constants').three_test_coordinates;
 var two_test_coordinates = require('./constants').two_test_coordinates;
 
@@ -16,6 +17,17 @@ test('trip: trip in Monaco', function(assert) {
     });
 });
 
+test('trip: trip in Monaco on CoreCH', function(assert) {
+    assert.plan(2);
+    var osrm = new OSRM({path: corech_data_path, algorithm: 'CoreCH'});
+    osrm.trip({coordinates: two_test_coordinates}, function(err, trip) {
+        assert.ifError(err);
+        for (t = 0; t < trip.trips.length; t++) {
+            assert.ok(trip.trips[t].geometry);
+        }
+    });
+});
+
 test('trip: trip with many locations in Monaco', function(assert) {
     assert.plan(2);
 
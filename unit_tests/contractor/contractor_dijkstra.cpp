@@ -0,0 +1,76 @@
+#include <boost/test/unit_test.hpp>
+
+#include "contractor/contractor_dijkstra.hpp"
+
+#include <vector>
+
+using namespace osrm;
+using namespace osrm::contractor;
+
+namespace
+{
+// a path 0 -> 1 -> 2 -> 3 of weight 3 and a direct edge 0 -> 3 of weight 10
+ContractorGraph makeGraph()
+{
+    std::vector<ContractorEdge> edges;
+    const auto add_edge = [&](const NodeID source, const NodeID target, const EdgeWeight weight) {
+        edges.emplace_back(source, target, weight, weight, 1, edges.size(), false, true, false);
+    };
+    add_edge(0, 1, 1);
+    add_edge(0, 3, 10);
+    add_edge(1, 2, 1);
+    add_edge(2, 3, 1);
+    return ContractorGraph{4, edges};
+}
+
+EdgeWeight search(const ContractorGraph &graph,
+                  ContractorDijkstra &dijkstra,
+                  const int node_limit,
+                  const unsigned hop_limit)
+{
+    dijkstra.Clear();
+    dijkstra.Insert(0, 0, ContractorHeapData{0, false});
+    dijkstra.Insert(3, INVALID_EDGE_WEIGHT, ContractorHeapData{0, true});
+    dijkstra.Run(1, node_limit, hop_limit, INVALID_EDGE_WEIGHT, SPECIAL_NODEID, graph);
+    return dijkstra.GetKey(3);
+}
+}
+
+BOOST_AUTO_TEST_SUITE(contractor_dijkstra_tests)
+
+BOOST_AUTO_TEST_CASE(hop_limit)
+{
+    const auto graph = makeGraph();
+    ContractorDijkstra dijkstra(graph.GetNumberOfNodes());
+
+    BOOST_CHECK_EQUAL(search(graph, dijkstra, 100, 0), 3);
+    BOOST_CHECK_EQUAL(search(graph, dijkstra, 100, 3), 3);
+    // the path over three edges is not found and the direct edge remains
+    BOOST_CHECK_EQUAL(search(graph, dijkstra, 100, 2), 10);
+    BOOST_CHECK_EQUAL(search(graph, dijkstra, 100, 1), 10);
+
+    const auto &stats = dijkstra.GetStats();
+    BOOST_CHECK_EQUAL(stats.searches, 4);
+    BOOST_CHECK_EQUAL(stats.stopped_at_node_limit, 0);
+    BOOST_CHECK_GT(stats.pruned_at_hop_limit, 0);
+}
+
+BOOST_AUTO_TEST_CASE(node_limit)
+{
+    const auto graph = makeGraph();
+    ContractorDijkstra dijkstra(graph.GetNumberOfNodes());
+
+    // the target is inserted with the weight of the direct edge before the search
+    dijkstra.Clear();
+    dijkstra.Insert(0, 0, ContractorHeapData{0, false});
+    dijkstra.Insert(3, 10, ContractorHeapData{0, true});
+    dijkstra.Run(1, 2, 0, INVALID_EDGE_WEIGHT, SPECIAL_NODEID, graph);
+    BOOST_CHECK_EQUAL(dijkstra.GetKey(3), 10);
+
+    const auto &stats = dijkstra.GetStats();
+    BOOST_CHECK_EQUAL(stats.searches, 1);
+    BOOST_CHECK_EQUAL(stats.settled_nodes, 2);
+    BOOST_CHECK_EQUAL(stats.stopped_at_node_limit, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,86 @@
+#include <boost/test/unit_test.hpp>
+
+#include "contractor/graph_contractor.hpp"
+#include "contractor/graph_contractor_adaptors.hpp"
+
+#include "extractor/edge_based_edge.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace osrm;
+using namespace osrm::contractor;
+
+namespace
+{
+// a grid with edges in both directions between neighboring nodes, with weights from a formula
+std::vector<extractor::EdgeBasedEdge> makeGrid(const NodeID size, const EdgeWeight offset)
+{
+    std::vector<extractor::EdgeBasedEdge> edges;
+    const auto add_edge = [&](const NodeID source, const NodeID target) {
+        const EdgeWeight weight = 10 + (source * 7 + target * 13 + offset) % 50;
+        const NodeID turn_id = edges.size();
+        edges.emplace_back(source, target, turn_id, weight, weight, true, false);
+        edges.emplace_back(target, source, turn_id + 1, weight, weight, true, false);
+    };
+    for (NodeID row = 0; row < size; ++row)
+    {
+        for (NodeID column = 0; column < size; ++column)
+        {
+            const auto node = row * size + column;
+            if (column + 1 < size)
+                add_edge(node, node + 1);
+            if (row + 1 < size)
+                add_edge(node, node + size);
+        }
+    }
+    return edges;
+}
+
+auto contract(const NodeID number_of_nodes,
+              const std::vector<extractor::EdgeBasedEdge> &edges,
+              std::vector<float> &node_levels)
+{
+    GraphContractor graph_contractor(number_of_nodes,
+                                     adaptToContractorInput(edges),
+                                     std::move(node_levels),
+                                     std::vector<EdgeWeight>(number_of_nodes, 0));
+    graph_contractor.Run();
+
+    util::DeallocatingVector<QueryEdge> contracted_edges;
+    graph_contractor.GetEdges(contracted_edges);
+    graph_contractor.GetNodeLevels(node_levels);
+    return contracted_edges;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(graph_contractor_tests)
+
+BOOST_AUTO_TEST_CASE(recontract_in_level_order)
+{
+    const NodeID size = 10;
+    const NodeID number_of_nodes = size * size;
+
+    std::vector<float> node_levels;
+    const auto edges = contract(number_of_nodes, makeGrid(size, 0), node_levels);
+    BOOST_REQUIRE_EQUAL(node_levels.size(), number_of_nodes);
+
+    // every edge is stored at the node that was contracted first
+    for (const auto &edge : edges)
+        BOOST_CHECK_LT(node_levels[edge.source], node_levels[edge.target]);
+    // the node that was left over is the top of the hierarchy
+    BOOST_CHECK_EQUAL(std::count(node_levels.begin(),
+                                 node_levels.end(),
+                                 *std::max_element(node_levels.begin(), node_levels.end())),
+                      1);
+
+    // re-contract with different weights in the order of the first contraction
+    const auto cached_levels = node_levels;
+    const auto recontracted_edges = contract(number_of_nodes, makeGrid(size, 17), node_levels);
+    BOOST_CHECK(node_levels.empty());
+    BOOST_CHECK_GT(recontracted_edges.size(), 0);
+    for (const auto &edge : recontracted_edges)
+        BOOST_CHECK_LE(cached_levels[edge.source], cached_levels[edge.target]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
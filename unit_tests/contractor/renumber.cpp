@@ -0,0 +1,83 @@
+#include <boost/test/unit_test.hpp>
+
+#include "contractor/renumber.hpp"
+
+#include "../common/range_tools.hpp"
+
+using namespace osrm;
+using namespace osrm::contractor;
+
+namespace
+{
+struct MockEdge
+{
+    NodeID source;
+    NodeID target;
+    NodeID turn_id;
+    bool shortcut;
+};
+
+auto makeEdges(const std::vector<MockEdge> &mock_edges)
+{
+    util::DeallocatingVector<QueryEdge> edges;
+    for (const auto &m : mock_edges)
+    {
+        QueryEdge edge;
+        edge.source = m.source;
+        edge.target = m.target;
+        edge.data.turn_id = m.turn_id;
+        edge.data.shortcut = m.shortcut;
+        edge.data.forward = true;
+        edge.data.backward = true;
+        edges.push_back(edge);
+    }
+    return edges;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(renumber_tests)
+
+BOOST_AUTO_TEST_CASE(depth_first_order)
+{
+    // node 4 is the top of the hierarchy, edges point to the higher node:
+    //  0 -> 2, 1 -> 2, 2 -> 4, 3 -> 4 and the shortcut 0 -> 4 over 2
+    auto edges = makeEdges({{0, 2, 10, false},
+                            {1, 2, 11, false},
+                            {2, 4, 12, false},
+                            {3, 4, 13, false},
+                            {0, 4, 2, true}});
+
+    // node:       0  1  2  3  4
+    // preorder:   4  2  0  1  3
+    auto permutation = makePermutation(5, edges, {});
+    CHECK_EQUAL_RANGE(permutation, 2, 3, 1, 4, 0);
+
+    renumber(edges, permutation);
+    const auto &shortcut = edges[4];
+    BOOST_CHECK_EQUAL(shortcut.source, 2);
+    BOOST_CHECK_EQUAL(shortcut.target, 0);
+    // the middle node of the shortcut is renumbered, the turn ids of the other edges are kept
+    BOOST_CHECK_EQUAL(shortcut.data.turn_id, 1);
+    BOOST_CHECK_EQUAL(edges[0].data.turn_id, 10);
+}
+
+BOOST_AUTO_TEST_CASE(core_first)
+{
+    // node 0 is below the core of 1 and 2, node 3 is not connected
+    auto edges = makeEdges({{0, 2, 10, false}, {1, 2, 11, false}, {2, 1, 12, false}});
+
+    // node:       0  1  2  3
+    // preorder:   1  2  0  3
+    auto permutation = makePermutation(4, edges, {false, true, true, false});
+    CHECK_EQUAL_RANGE(permutation, 2, 0, 1, 3);
+
+    std::vector<bool> is_core_node{false, true, true, false};
+    renumber(is_core_node, permutation);
+    CHECK_EQUAL_RANGE(is_core_node, true, true, false, false);
+
+    std::vector<float> node_levels{0, 1, 2, 3};
+    renumber(node_levels, permutation);
+    CHECK_EQUAL_RANGE(node_levels, 1, 2, 0, 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
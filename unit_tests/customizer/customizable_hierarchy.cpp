@@ -0,0 +1,224 @@
+#include <boost/test/unit_test.hpp>
+
+#include "customizer/customizable_hierarchy.hpp"
+
+#include "util/integer_range.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+using namespace osrm;
+using namespace osrm::customizer;
+
+namespace
+{
+struct MockEdge
+{
+    NodeID source;
+    NodeID target;
+    EdgeWeight weight;
+};
+
+auto makeEdges(const std::vector<MockEdge> &mock_edges)
+{
+    std::vector<extractor::EdgeBasedEdge> edges;
+    for (const auto &m : mock_edges)
+        edges.emplace_back(m.source, m.target, edges.size(), m.weight, m.weight, true, true);
+    return edges;
+}
+
+const contractor::QueryEdge &findEdge(const util::DeallocatingVector<contractor::QueryEdge> &edges,
+                                      const NodeID source,
+                                      const NodeID target)
+{
+    const auto iter = std::find_if(edges.begin(), edges.end(), [&](const auto &edge) {
+        return edge.source == source && edge.target == target;
+    });
+    BOOST_REQUIRE(iter != edges.end());
+    return *iter;
+}
+
+using QueueEntry = std::pair<EdgeWeight, NodeID>;
+using Queue = std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>>;
+
+// distances from a node with Dijkstra's algorithm on the edges, or on the upward edges of a
+// contracted graph if adjacent is given
+std::vector<EdgeWeight>
+dijkstra(const std::size_t number_of_nodes,
+         const NodeID start,
+         const std::function<void(NodeID, std::function<void(NodeID, EdgeWeight)>)> &adjacent)
+{
+    std::vector<EdgeWeight> distances(number_of_nodes, INVALID_EDGE_WEIGHT);
+    Queue queue;
+    distances[start] = 0;
+    queue.emplace(0, start);
+    while (!queue.empty())
+    {
+        const auto entry = queue.top();
+        queue.pop();
+        if (entry.first > distances[entry.second])
+            continue;
+        adjacent(entry.second, [&](const NodeID target, const EdgeWeight weight) {
+            if (entry.first + weight < distances[target])
+            {
+                distances[target] = entry.first + weight;
+                queue.emplace(distances[target], target);
+            }
+        });
+    }
+    return distances;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(customizable_hierarchy_tests)
+
+BOOST_AUTO_TEST_CASE(square)
+{
+    // node:                0  1  2  3
+    std::vector<CellID> l1{{0, 0, 1, 1}};
+    partition::MultiLevelPartition mlp{{l1}, {2}};
+
+    //  0 - 1
+    //  |   |  the edge 3 - 0 is expensive
+    //  3 - 2
+    auto edges = makeEdges({{0, 1, 1}, {1, 2, 1}, {2, 3, 1}, {3, 0, 10}});
+
+    // 2 and 3 separate the cells, 0 has the lowest degree in the first cell
+    const auto ranks = makeNestedDissectionOrder(4, mlp, edges);
+    BOOST_CHECK_EQUAL(ranks[0], 0);
+    BOOST_CHECK_EQUAL(ranks[1], 1);
+    BOOST_CHECK_EQUAL(ranks[2], 2);
+    BOOST_CHECK_EQUAL(ranks[3], 3);
+
+    // contracting 0 connects 1 and 3
+    CustomizableHierarchy hierarchy(ranks, edges);
+    BOOST_CHECK_EQUAL(hierarchy.GetNumberOfArcs(), 5);
+
+    const std::vector<EdgeWeight> node_weights(4, 0);
+    hierarchy.Customize(edges, node_weights);
+    auto contracted_edges = hierarchy.GetEdges();
+    BOOST_CHECK_EQUAL(contracted_edges.size(), 5);
+
+    const auto &shortcut = findEdge(contracted_edges, 1, 3);
+    BOOST_CHECK(shortcut.data.shortcut);
+    BOOST_CHECK_EQUAL(shortcut.data.turn_id, 0);
+    BOOST_CHECK_EQUAL(shortcut.data.weight, 11);
+    BOOST_CHECK(shortcut.data.forward && shortcut.data.backward);
+
+    const auto &edge = findEdge(contracted_edges, 0, 3);
+    BOOST_CHECK(!edge.data.shortcut);
+    BOOST_CHECK_EQUAL(edge.data.turn_id, 3);
+    BOOST_CHECK_EQUAL(edge.data.weight, 10);
+
+    // a new metric only needs a new customization
+    edges[3].data.weight = 2;
+    hierarchy.Customize(edges, node_weights);
+    contracted_edges = hierarchy.GetEdges();
+    BOOST_CHECK_EQUAL(findEdge(contracted_edges, 1, 3).data.weight, 3);
+}
+
+BOOST_AUTO_TEST_CASE(one_way_and_blocked_edges)
+{
+    std::vector<CellID> l1{{0, 0, 1}};
+    partition::MultiLevelPartition mlp{{l1}, {2}};
+
+    // 0 -> 1 is one way, 1 - 2 is blocked
+    std::vector<extractor::EdgeBasedEdge> edges;
+    edges.emplace_back(0, 1, 0, 5, 5, true, false);
+    edges.emplace_back(1, 2, 1, INVALID_EDGE_WEIGHT, 1, true, true);
+
+    CustomizableHierarchy hierarchy(makeNestedDissectionOrder(3, mlp, edges), edges);
+    hierarchy.Customize(edges, std::vector<EdgeWeight>(3, 0));
+    const auto contracted_edges = hierarchy.GetEdges();
+
+    BOOST_REQUIRE_EQUAL(contracted_edges.size(), 1);
+    const auto &edge = contracted_edges[0];
+    BOOST_CHECK_EQUAL(edge.data.weight, 5);
+    // the edge is stored at the lower node
+    if (edge.source == 0)
+        BOOST_CHECK(edge.data.forward && !edge.data.backward);
+    else
+        BOOST_CHECK(!edge.data.forward && edge.data.backward);
+}
+
+BOOST_AUTO_TEST_CASE(grid_distances)
+{
+    // a grid of 8x8 nodes in four cells on the first level and two cells on the second level
+    const NodeID size = 8;
+    const NodeID number_of_nodes = size * size;
+    std::vector<CellID> l1(number_of_nodes), l2(number_of_nodes);
+    for (const auto node : util::irange<NodeID>(0, number_of_nodes))
+    {
+        l1[node] = node / size / 4 * 2 + node % size / 4;
+        l2[node] = node % size / 4;
+    }
+    partition::MultiLevelPartition mlp{{l1, l2}, {4, 2}};
+
+    // every fifth street is one way
+    std::vector<extractor::EdgeBasedEdge> edges;
+    const auto add_street = [&](const NodeID source, const NodeID target) {
+        const EdgeWeight weight = 1 + (source * 7 + target * 13) % 20;
+        edges.emplace_back(source, target, edges.size(), weight, weight, true, edges.size() % 5);
+    };
+    for (const auto node : util::irange<NodeID>(0, number_of_nodes))
+    {
+        if (node % size + 1 < size)
+            add_street(node, node + 1);
+        if (node + size < number_of_nodes)
+            add_street(node, node + size);
+    }
+
+    CustomizableHierarchy hierarchy(makeNestedDissectionOrder(number_of_nodes, mlp, edges),
+                                    edges);
+    hierarchy.Customize(edges, std::vector<EdgeWeight>(number_of_nodes, 0));
+    const auto contracted_edges = hierarchy.GetEdges();
+
+    std::vector<std::vector<extractor::EdgeBasedEdge>> adjacent_edges(number_of_nodes);
+    for (const auto &edge : edges)
+    {
+        adjacent_edges[edge.source].push_back(edge);
+        if (edge.data.backward)
+            adjacent_edges[edge.target].emplace_back(
+                edge.target, edge.source, 0, edge.data.weight, edge.data.duration, true, false);
+    }
+    std::vector<std::vector<contractor::QueryEdge>> upward_edges(number_of_nodes);
+    for (const auto &edge : contracted_edges)
+        upward_edges[edge.source].push_back(edge);
+
+    const auto upward_search = [&](const NodeID start, const bool forward) {
+        return dijkstra(number_of_nodes, start, [&](const NodeID node, const auto &relax) {
+            for (const auto &edge : upward_edges[node])
+                if (forward ? edge.data.forward : edge.data.backward)
+                    relax(edge.target, edge.data.weight);
+        });
+    };
+
+    std::vector<std::vector<EdgeWeight>> backward(number_of_nodes);
+    for (const auto target : util::irange<NodeID>(0, number_of_nodes))
+        backward[target] = upward_search(target, false);
+
+    for (const auto source : util::irange<NodeID>(0, number_of_nodes))
+    {
+        const auto distances =
+            dijkstra(number_of_nodes, source, [&](const NodeID node, const auto &relax) {
+                for (const auto &edge : adjacent_edges[node])
+                    relax(edge.target, edge.data.weight);
+            });
+        const auto forward = upward_search(source, true);
+        for (const auto target : util::irange<NodeID>(0, number_of_nodes))
+        {
+            // the searches meet at the highest node of the shortest path
+            EdgeWeight distance = INVALID_EDGE_WEIGHT;
+            for (const auto node : util::irange<NodeID>(0, number_of_nodes))
+                if (forward[node] != INVALID_EDGE_WEIGHT &&
+                    backward[target][node] != INVALID_EDGE_WEIGHT)
+                    distance = std::min(distance, forward[node] + backward[target][node]);
+            BOOST_CHECK_EQUAL(distance, distances[target]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
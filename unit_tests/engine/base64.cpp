@@ -75,4 +75,71 @@ BOOST_AUTO_TEST_CASE(hint_encoding_decoding_roundtrip_bytewise)
                            reinterpret_cast<const unsigned char *>(&decoded)));
 }
 
+BOOST_AUTO_TEST_CASE(compact_hint_encoding_decoding_roundtrip)
+{
+    using namespace osrm::engine;
+    using namespace osrm::util;
+
+    const osrm::test::MockDataFacade<osrm::engine::routing_algorithms::ch::Algorithm> facade{};
+
+    const Coordinate input_coordinate{FloatLongitude{7.419758}, FloatLatitude{43.731142}};
+    PhantomNode phantom;
+    phantom.forward_segment_id = {5, true};
+    phantom.reverse_segment_id = {6, true};
+    phantom.fwd_segment_position = 2;
+    phantom.location = {FloatLongitude{7.419759}, FloatLatitude{43.731143}};
+    phantom.input_location = input_coordinate;
+
+    const Hint hint{phantom, facade.GetCheckSum()};
+    const auto base64 = hint.ToCompactBase64();
+
+    BOOST_CHECK_EQUAL(base64.size(), ENCODED_COMPACT_HINT_SIZE);
+    BOOST_CHECK(0 == std::count(begin(base64), end(base64), '+'));
+    BOOST_CHECK(0 == std::count(begin(base64), end(base64), '/'));
+
+    const auto decoded = Hint::FromBase64(base64);
+    BOOST_CHECK(decoded.IsCompact());
+    BOOST_CHECK_EQUAL(decoded.phantom.forward_segment_id.id, 5);
+    BOOST_CHECK(decoded.phantom.forward_segment_id.enabled);
+    BOOST_CHECK_EQUAL(decoded.phantom.reverse_segment_id.id, 6);
+    BOOST_CHECK(decoded.phantom.reverse_segment_id.enabled);
+    BOOST_CHECK_EQUAL(decoded.phantom.fwd_segment_position, 2);
+
+    // compact hints are bound to the input coordinate they were generated for
+    BOOST_CHECK(decoded.IsValid(input_coordinate, facade));
+    BOOST_CHECK(!decoded.IsValid(phantom.location, facade));
+}
+
+BOOST_AUTO_TEST_CASE(unpadded_hints_are_rejected)
+{
+    using namespace osrm::engine;
+    using namespace osrm::util;
+
+    const osrm::test::MockDataFacade<osrm::engine::routing_algorithms::ch::Algorithm> facade{};
+
+    const Coordinate input_coordinate{FloatLongitude{7.419758}, FloatLatitude{43.731142}};
+    PhantomNode phantom;
+    phantom.forward_segment_id = {5, true};
+    phantom.reverse_segment_id = {6, true};
+    phantom.location = {FloatLongitude{7.419759}, FloatLatitude{43.731143}};
+    phantom.input_location = input_coordinate;
+    const Hint hint{phantom, facade.GetCheckSum()};
+
+    // without the padding 24 characters decode to 18 bytes instead of 16
+    auto compact = hint.ToCompactBase64();
+    BOOST_REQUIRE_EQUAL(compact.substr(ENCODED_COMPACT_HINT_SIZE - 2), "==");
+    compact.replace(ENCODED_COMPACT_HINT_SIZE - 2, 2, "AA");
+    const auto decoded_compact = Hint::FromBase64(compact);
+    BOOST_CHECK(!decoded_compact.IsValid(input_coordinate, facade));
+
+    auto full = hint.ToBase64();
+    BOOST_REQUIRE_EQUAL(full.back(), '=');
+    full.back() = 'A';
+    const auto decoded_full = Hint::FromBase64(full);
+    BOOST_CHECK(!decoded_full.IsValid(input_coordinate, facade));
+
+    const auto unpadded = Hint::FromBase64(std::string(ENCODED_COMPACT_HINT_SIZE, 'A'));
+    BOOST_CHECK(!unpadded.IsValid(input_coordinate, facade));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
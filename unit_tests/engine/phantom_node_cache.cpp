@@ -0,0 +1,168 @@
+#include "engine/phantom_node_cache.hpp"
+#include "engine/api/route_parameters.hpp"
+#include "engine/plugins/plugin_base.hpp"
+
+#include "mocks/mock_datafacade.hpp"
+
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <utility>
+
+BOOST_AUTO_TEST_SUITE(phantom_node_cache)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+PhantomNodeQuery makeQuery(const int lon, const int lat, const int bearing = -1)
+{
+    return {util::FixedLongitude{lon}, util::FixedLatitude{lat}, 0, 100., bearing, -1,
+            Approach::UNRESTRICTED, false};
+}
+
+PhantomNodeCache::Result makeResult(const double distance)
+{
+    PhantomNodeWithDistance phantom_with_distance;
+    phantom_with_distance.distance = distance;
+    return {phantom_with_distance};
+}
+
+// Snaps like the contiguous facade, every coordinate is looked up in the cache first
+class CachingDataFacade final : public test::MockBaseDataFacade
+{
+  public:
+    using test::MockBaseDataFacade::NearestPhantomNodeWithAlternativeFromBigComponent;
+
+    explicit CachingDataFacade(const std::size_t cache_size) : cache(cache_size), num_queries(0)
+    {
+    }
+
+    std::pair<PhantomNode, PhantomNode>
+    NearestPhantomNodeWithAlternativeFromBigComponent(const util::Coordinate input_coordinate,
+                                                      const Approach approach) const override
+    {
+        const PhantomNodeQuery query{
+            input_coordinate.lon, input_coordinate.lat, 1, -1., -1, -1, approach, true};
+        return cache.GetWithAlternative(query, [&] {
+            ++num_queries;
+            PhantomNode phantom_node;
+            phantom_node.location = input_coordinate;
+            phantom_node.input_location = input_coordinate;
+            return std::make_pair(phantom_node, phantom_node);
+        });
+    }
+
+    PhantomNodeCache cache;
+    mutable int num_queries;
+};
+
+// The route, table and trip plugins snap their coordinates with BasePlugin::GetPhantomNodes
+struct SnappingPlugin : plugins::BasePlugin
+{
+    using plugins::BasePlugin::GetPhantomNodes;
+};
+}
+
+BOOST_AUTO_TEST_CASE(cache_hit_and_miss)
+{
+    PhantomNodeCache cache(64);
+    int num_queries = 0;
+    const auto query = [&](const double distance) {
+        return [&num_queries, distance] {
+            ++num_queries;
+            return makeResult(distance);
+        };
+    };
+
+    auto result = cache.Get(makeQuery(1, 2), query(1.));
+    BOOST_CHECK_EQUAL(result.front().distance, 1.);
+    result = cache.Get(makeQuery(1, 2), query(2.));
+    BOOST_CHECK_EQUAL(result.front().distance, 1.);
+    BOOST_CHECK_EQUAL(num_queries, 1);
+
+    // different parameters are different queries
+    result = cache.Get(makeQuery(1, 2, 90), query(3.));
+    BOOST_CHECK_EQUAL(result.front().distance, 3.);
+    BOOST_CHECK_EQUAL(num_queries, 2);
+
+    BOOST_CHECK_EQUAL(cache.GetNumberOfHits(), 1);
+    BOOST_CHECK_EQUAL(cache.GetNumberOfMisses(), 2);
+    BOOST_CHECK_CLOSE(cache.GetHitRatio(), 1. / 3., 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(cache_is_bounded)
+{
+    const std::size_t capacity = 32;
+    PhantomNodeCache cache(capacity);
+    int num_queries = 0;
+    const auto query = [&] {
+        ++num_queries;
+        return makeResult(0.);
+    };
+
+    for (int i = 0; i < 1000; ++i)
+        cache.Get(makeQuery(i, i), query);
+    BOOST_CHECK_EQUAL(num_queries, 1000);
+
+    // the most recently used entry is kept
+    cache.Get(makeQuery(999, 999), query);
+    BOOST_CHECK_EQUAL(num_queries, 1000);
+
+    // the oldest entries were evicted
+    cache.Get(makeQuery(0, 0), query);
+    BOOST_CHECK_EQUAL(num_queries, 1001);
+}
+
+BOOST_AUTO_TEST_CASE(disabled_cache)
+{
+    PhantomNodeCache cache(0);
+    BOOST_CHECK(!cache.IsEnabled());
+
+    int num_queries = 0;
+    const auto query = [&] {
+        ++num_queries;
+        return makeResult(0.);
+    };
+    cache.Get(makeQuery(1, 2), query);
+    cache.Get(makeQuery(1, 2), query);
+    BOOST_CHECK_EQUAL(num_queries, 2);
+    BOOST_CHECK_EQUAL(cache.GetHitRatio(), 0.);
+}
+
+BOOST_AUTO_TEST_CASE(route_snapping_uses_cache)
+{
+    CachingDataFacade facade(64);
+    SnappingPlugin plugin;
+    api::RouteParameters parameters;
+    parameters.coordinates = {{util::FloatLongitude{7.41}, util::FloatLatitude{43.73}},
+                              {util::FloatLongitude{7.42}, util::FloatLatitude{43.74}}};
+
+    auto phantom_nodes = plugin.GetPhantomNodes(facade, parameters);
+    BOOST_CHECK_EQUAL(phantom_nodes.size(), 2);
+    BOOST_CHECK_EQUAL(facade.num_queries, 2);
+    BOOST_CHECK_EQUAL(facade.cache.GetNumberOfMisses(), 2);
+
+    // the same request again is snapped from the cache
+    phantom_nodes = plugin.GetPhantomNodes(facade, parameters);
+    BOOST_CHECK_EQUAL(phantom_nodes.size(), 2);
+    BOOST_CHECK_EQUAL(facade.num_queries, 2);
+    BOOST_CHECK_EQUAL(facade.cache.GetNumberOfHits(), 2);
+    BOOST_CHECK(phantom_nodes[0].first.location == parameters.coordinates[0]);
+    BOOST_CHECK(phantom_nodes[1].second.location == parameters.coordinates[1]);
+
+    // nearest queries of the same coordinate are cached separately
+    PhantomNodeQuery nearest_query{parameters.coordinates[0].lon,
+                                   parameters.coordinates[0].lat,
+                                   1,
+                                   -1.,
+                                   -1,
+                                   -1,
+                                   Approach::UNRESTRICTED,
+                                   false};
+    facade.cache.Get(nearest_query, [] { return makeResult(0.); });
+    BOOST_CHECK_EQUAL(facade.cache.GetNumberOfMisses(), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
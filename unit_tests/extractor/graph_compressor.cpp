@@ -128,6 +128,41 @@ BOOST_AUTO_TEST_CASE(loop_test)
     BOOST_CHECK(graph.FindEdge(4, 5) != SPECIAL_EDGEID);
 }
 
+BOOST_AUTO_TEST_CASE(parallel_edges_test)
+{
+    //
+    //         /---\
+    // 2---0        1
+    //         \---/
+    //
+    GraphCompressor compressor;
+
+    std::unordered_set<NodeID> barrier_nodes;
+    std::unordered_set<NodeID> traffic_lights;
+    RestrictionMap map;
+    CompressedEdgeContainer container;
+
+    std::vector<InputEdge> edges = {MakeUnitEdge(0, 1),
+                                    MakeUnitEdge(0, 1),
+                                    MakeUnitEdge(0, 2),
+                                    MakeUnitEdge(1, 0),
+                                    MakeUnitEdge(1, 0),
+                                    MakeUnitEdge(2, 0)};
+
+    BOOST_ASSERT(edges[0].data.IsCompatibleTo(edges[1].data));
+    BOOST_ASSERT(edges[3].data.IsCompatibleTo(edges[4].data));
+
+    Graph graph(3, edges);
+    compressor.Compress(barrier_nodes, traffic_lights, map, graph, container);
+
+    // both edges of 1 lead to 0, compressing 1 would turn them into a loop at 0
+    BOOST_CHECK_EQUAL(graph.FindEdge(0, 0), SPECIAL_EDGEID);
+    BOOST_CHECK_EQUAL(graph.GetOutDegree(1), 2);
+    BOOST_CHECK(graph.FindEdge(0, 1) != SPECIAL_EDGEID);
+    BOOST_CHECK(graph.FindEdge(1, 0) != SPECIAL_EDGEID);
+    BOOST_CHECK(graph.FindEdge(0, 2) != SPECIAL_EDGEID);
+}
+
 BOOST_AUTO_TEST_CASE(t_intersection)
 {
     //
@@ -213,4 +248,105 @@ BOOST_AUTO_TEST_CASE(direction_changes)
     BOOST_CHECK(graph.FindEdge(1, 2) != SPECIAL_EDGEID);
 }
 
+BOOST_AUTO_TEST_CASE(compressed_geometry)
+{
+    //
+    // 0---1---2---3
+    //     *
+    //
+    // with a traffic light at 1 and weights 1, 2, 3 from left to right
+    GraphCompressor compressor;
+
+    std::unordered_set<NodeID> barrier_nodes;
+    std::unordered_set<NodeID> traffic_lights = {1};
+    RestrictionMap map;
+    CompressedEdgeContainer container;
+
+    std::vector<InputEdge> edges = {MakeUnitEdge(0, 1),
+                                    MakeUnitEdge(1, 0),
+                                    MakeUnitEdge(1, 2),
+                                    MakeUnitEdge(2, 1),
+                                    MakeUnitEdge(2, 3),
+                                    MakeUnitEdge(3, 2)};
+    edges[2].data.weight = edges[3].data.weight = 2;
+    edges[4].data.weight = edges[5].data.weight = 3;
+
+    Graph graph(4, edges);
+    compressor.Compress(barrier_nodes, traffic_lights, map, graph, container);
+
+    BOOST_CHECK(graph.FindEdge(0, 1) != SPECIAL_EDGEID);
+    BOOST_CHECK_EQUAL(graph.FindEdge(1, 2), SPECIAL_EDGEID);
+    BOOST_CHECK_EQUAL(graph.GetEdgeData(graph.FindEdge(1, 3)).weight, 5);
+
+    const auto &forward = container.GetBucketReference(graph.FindEdge(1, 3));
+    BOOST_REQUIRE_EQUAL(forward.size(), 2);
+    BOOST_CHECK_EQUAL(forward[0].node_id, 2);
+    BOOST_CHECK_EQUAL(forward[0].weight, 2);
+    BOOST_CHECK_EQUAL(forward[1].node_id, 3);
+    BOOST_CHECK_EQUAL(forward[1].weight, 3);
+
+    const auto &reverse = container.GetBucketReference(graph.FindEdge(3, 1));
+    BOOST_REQUIRE_EQUAL(reverse.size(), 2);
+    BOOST_CHECK_EQUAL(reverse[0].node_id, 2);
+    BOOST_CHECK_EQUAL(reverse[0].weight, 3);
+    BOOST_CHECK_EQUAL(reverse[1].node_id, 1);
+    BOOST_CHECK_EQUAL(reverse[1].weight, 2);
+
+    // the edge that was not compressed has a trivial geometry
+    BOOST_CHECK_EQUAL(container.GetBucketReference(graph.FindEdge(0, 1)).size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(compressed_geometry_of_long_chain)
+{
+    //
+    // 0---1---2---3---4---5---6
+    //     *
+    //
+    // with a traffic light at 1 and weights 1, 2, 3, 4, 5, 6 from left to right
+    GraphCompressor compressor;
+
+    std::unordered_set<NodeID> barrier_nodes;
+    std::unordered_set<NodeID> traffic_lights = {1};
+    RestrictionMap map;
+    CompressedEdgeContainer container;
+
+    std::vector<InputEdge> edges;
+    for (NodeID node = 0; node < 6; ++node)
+    {
+        edges.push_back(MakeUnitEdge(node, node + 1));
+        edges.back().data.weight = node + 1;
+        edges.push_back(MakeUnitEdge(node + 1, node));
+        edges.back().data.weight = node + 1;
+    }
+
+    Graph graph(7, edges);
+    compressor.Compress(barrier_nodes, traffic_lights, map, graph, container);
+
+    for (NodeID node = 2; node < 6; ++node)
+    {
+        BOOST_CHECK_EQUAL(graph.GetOutDegree(node), 0);
+    }
+    BOOST_CHECK_EQUAL(graph.GetEdgeData(graph.FindEdge(1, 6)).weight, 2 + 3 + 4 + 5 + 6);
+    BOOST_CHECK_EQUAL(graph.GetEdgeData(graph.FindEdge(6, 1)).weight, 2 + 3 + 4 + 5 + 6);
+
+    // the geometry lists the nodes after the source with the weights of the segments to them
+    const auto &forward = container.GetBucketReference(graph.FindEdge(1, 6));
+    BOOST_REQUIRE_EQUAL(forward.size(), 5);
+    for (std::size_t index = 0; index < forward.size(); ++index)
+    {
+        BOOST_CHECK_EQUAL(forward[index].node_id, index + 2);
+        BOOST_CHECK_EQUAL(forward[index].weight, index + 2);
+    }
+
+    const auto &reverse = container.GetBucketReference(graph.FindEdge(6, 1));
+    BOOST_REQUIRE_EQUAL(reverse.size(), 5);
+    for (std::size_t index = 0; index < reverse.size(); ++index)
+    {
+        BOOST_CHECK_EQUAL(reverse[index].node_id, 5 - index);
+        BOOST_CHECK_EQUAL(reverse[index].weight, 6 - index);
+    }
+
+    BOOST_CHECK_EQUAL(container.GetBucketReference(graph.FindEdge(0, 1)).size(), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,158 @@
+#include "extractor/osm_change_applier.hpp"
+#include "util/exception.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <osmium/io/xml_input.hpp>
+#include <osmium/osm/node.hpp>
+#include <osmium/osm/way.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(osm_change_applier)
+
+using namespace osrm;
+using namespace osrm::extractor;
+
+namespace
+{
+osmium::memory::Buffer readBase()
+{
+    osmium::io::Reader reader(OSRM_FIXTURES_DIR "/changes_base.osm");
+    // the fixture is small enough to be read in a single buffer
+    auto buffer = reader.read();
+    BOOST_REQUIRE(!reader.read());
+    reader.close();
+    return buffer;
+}
+
+// objects of the buffers as "n1v1", "w10v2" etc.
+std::vector<std::string> describe(const std::vector<osmium::memory::Buffer> &buffers)
+{
+    std::vector<std::string> objects;
+    for (const auto &buffer : buffers)
+    {
+        for (const auto &object : buffer.select<osmium::OSMObject>())
+        {
+            objects.push_back(osmium::item_type_to_char(object.type()) +
+                              std::to_string(object.id()) + "v" +
+                              std::to_string(object.version()));
+        }
+    }
+    return objects;
+}
+}
+
+BOOST_AUTO_TEST_CASE(apply_single_change_file)
+{
+    OSMChangeApplier applier({OSRM_FIXTURES_DIR "/changes_1.osc"});
+    BOOST_CHECK_EQUAL(applier.GetNumberOfChanges(), 4);
+
+    std::vector<osmium::memory::Buffer> buffers;
+    buffers.push_back(applier.Apply(readBase()));
+    buffers.push_back(applier.Finish());
+
+    const std::vector<std::string> expected{"n1v1", "n2v1", "n3v1", "n4v1", "n5v1", "w11v2"};
+    const auto objects = describe(buffers);
+    BOOST_CHECK_EQUAL_COLLECTIONS(objects.begin(), objects.end(), expected.begin(), expected.end());
+
+    BOOST_CHECK_EQUAL(applier.GetNumberOfModifiedObjects(), 1);
+    BOOST_CHECK_EQUAL(applier.GetNumberOfDeletedObjects(), 1);
+    BOOST_CHECK_EQUAL(applier.GetNumberOfCreatedObjects(), 2);
+
+    // the modified way has the nodes of the change
+    const auto &way = *buffers[0].select<osmium::Way>().begin();
+    BOOST_CHECK_EQUAL(way.id(), 11);
+    BOOST_CHECK_EQUAL(way.nodes().size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(apply_change_files_in_order)
+{
+    OSMChangeApplier applier(
+        {OSRM_FIXTURES_DIR "/changes_1.osc", OSRM_FIXTURES_DIR "/changes_2.osc"});
+
+    std::vector<osmium::memory::Buffer> buffers;
+    buffers.push_back(applier.Apply(readBase()));
+    // way 12 is ordered after all objects of the base file
+    buffers.push_back(applier.Finish());
+
+    const std::vector<std::string> expected{
+        "n1v1", "n2v1", "n3v1", "n4v1", "n5v1", "w11v3", "w12v1"};
+    const auto objects = describe(buffers);
+    BOOST_CHECK_EQUAL_COLLECTIONS(objects.begin(), objects.end(), expected.begin(), expected.end());
+
+    const auto &way = *buffers[0].select<osmium::Way>().begin();
+    BOOST_CHECK_EQUAL(way.tags().get_value_by_key("highway"), std::string("secondary"));
+}
+
+BOOST_AUTO_TEST_CASE(reject_unsorted_input)
+{
+    OSMChangeApplier applier({OSRM_FIXTURES_DIR "/changes_1.osc"});
+
+    applier.Apply(readBase());
+    // the second buffer starts again with node 1
+    BOOST_CHECK_THROW(applier.Apply(readBase()), util::exception);
+}
+
+BOOST_AUTO_TEST_CASE(timestamp_of_newest_change)
+{
+    OSMChangeApplier applier(
+        {OSRM_FIXTURES_DIR "/changes_1.osc", OSRM_FIXTURES_DIR "/changes_2.osc"});
+    BOOST_CHECK_EQUAL(applier.GetTimestamp(), "2017-05-02T00:00:00Z");
+
+    OSMChangeApplier without_timestamps({OSRM_FIXTURES_DIR "/changes_base.osm"});
+    BOOST_CHECK_EQUAL(without_timestamps.GetTimestamp(), "");
+}
+
+BOOST_AUTO_TEST_CASE(keep_newer_base_objects)
+{
+    // way 11 of the input is newer than its change in changes_1.osc, way 10 has the same version
+    // as its deletion
+    const auto directory = boost::filesystem::temp_directory_path() /
+                           boost::filesystem::unique_path("osrm-changes-%%%%-%%%%");
+    boost::filesystem::create_directories(directory);
+    const auto base_file = directory / "newer_base.osm";
+    {
+        std::ofstream base(base_file.string());
+        base << "<?xml version='1.0' encoding='UTF-8'?>\n"
+             << "<osm version=\"0.6\" generator=\"osrm-test\">\n"
+             << "  <node id=\"2\" version=\"1\" lat=\"52.5\" lon=\"13.41\"/>\n"
+             << "  <node id=\"4\" version=\"1\" lat=\"52.5\" lon=\"13.43\"/>\n"
+             << "  <way id=\"10\" version=\"2\"><nd ref=\"2\"/><nd ref=\"4\"/></way>\n"
+             << "  <way id=\"11\" version=\"5\"><nd ref=\"2\"/><nd ref=\"4\"/></way>\n"
+             << "</osm>\n";
+    }
+
+    OSMChangeApplier applier({OSRM_FIXTURES_DIR "/changes_1.osc"});
+    std::vector<osmium::memory::Buffer> buffers;
+    {
+        osmium::io::Reader reader(base_file.string());
+        buffers.push_back(applier.Apply(reader.read()));
+        reader.close();
+    }
+    buffers.push_back(applier.Finish());
+
+    // the deletion of way 10 has the same version and the modification of way 11 is older
+    const std::vector<std::string> expected{"n2v1", "n3v1", "n4v1", "n5v1", "w10v2", "w11v5"};
+    const auto objects = describe(buffers);
+    BOOST_CHECK_EQUAL_COLLECTIONS(objects.begin(), objects.end(), expected.begin(), expected.end());
+    BOOST_CHECK_EQUAL(applier.GetNumberOfOutdatedChanges(), 2);
+    BOOST_CHECK_EQUAL(applier.GetNumberOfModifiedObjects(), 0);
+    BOOST_CHECK_EQUAL(applier.GetNumberOfDeletedObjects(), 0);
+
+    BOOST_CHECK_EQUAL(checkChangeMerge(base_file, {OSRM_FIXTURES_DIR "/changes_1.osc"}), 0);
+    boost::filesystem::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_CASE(check_merge_against_in_memory_merge)
+{
+    BOOST_CHECK_EQUAL(checkChangeMerge(OSRM_FIXTURES_DIR "/changes_base.osm",
+                                       {OSRM_FIXTURES_DIR "/changes_1.osc",
+                                        OSRM_FIXTURES_DIR "/changes_2.osc"}),
+                      0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
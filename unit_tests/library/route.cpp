@@ -11,6 +11,7 @@
 #include "osrm/json_container.hpp"
 #include "osrm/json_container.hpp"
 #include "osrm/osrm.hpp"
+#include "osrm/results.hpp"
 #include "osrm/route_parameters.hpp"
 #include "osrm/status.hpp"
 
@@ -447,4 +448,97 @@ BOOST_AUTO_TEST_CASE(test_manual_setting_of_annotations_property)
     BOOST_CHECK_EQUAL(annotations.size(), 5);
 }
 
+BOOST_AUTO_TEST_CASE(test_route_batch_matches_single_requests)
+{
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    using namespace osrm;
+
+    const auto small_component = get_locations_in_small_component();
+    const auto big_component = get_locations_in_big_component();
+
+    std::vector<RouteParameters> batch;
+    for (const auto &locations : {small_component, big_component, small_component})
+    {
+        RouteParameters params;
+        params.coordinates = locations;
+        batch.push_back(params);
+    }
+    // a failing request does not affect the others
+    RouteParameters invalid_coordinates;
+    invalid_coordinates.coordinates = {{Longitude{0}, Latitude{0}},
+                                       {Longitude{1000}, Latitude{1000}}};
+    batch.push_back(invalid_coordinates);
+
+    std::vector<json::Object> results;
+    const auto rc = osrm.RouteBatch(batch, results);
+    BOOST_CHECK(rc == Status::Error);
+    BOOST_REQUIRE_EQUAL(results.size(), batch.size());
+
+    for (const auto index : {0, 1, 2})
+    {
+        json::Object reference;
+        BOOST_CHECK(osrm.Route(batch[index], reference) == Status::Ok);
+        CHECK_EQUAL_JSON(reference, results[index]);
+    }
+
+    const auto code = results[3].values.at("code").get<json::String>().value;
+    BOOST_CHECK_EQUAL(code, "InvalidValue");
+}
+
+BOOST_AUTO_TEST_CASE(test_route_plain_result_matches_json)
+{
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    using namespace osrm;
+
+    RouteParameters params;
+    params.overview = RouteParameters::OverviewType::Full;
+    params.geometries = RouteParameters::GeometriesType::GeoJSON;
+    for (const auto &location : get_locations_in_big_component())
+        params.coordinates.push_back(location);
+
+    json::Object json_result;
+    BOOST_CHECK(osrm.Route(params, json_result) == Status::Ok);
+
+    RouteResult result;
+    BOOST_CHECK(osrm.Route(params, result) == Status::Ok);
+    BOOST_CHECK_EQUAL(result.code, "Ok");
+    BOOST_CHECK_EQUAL(result.waypoints.size(), params.coordinates.size());
+    BOOST_REQUIRE_EQUAL(result.routes.size(), 1);
+
+    const auto &json_route =
+        json_result.values.at("routes").get<json::Array>().values.at(0).get<json::Object>();
+    const auto &route = result.routes.front();
+    BOOST_CHECK_CLOSE(
+        route.distance, json_route.values.at("distance").get<json::Number>().value, 1e-3);
+    BOOST_CHECK_CLOSE(
+        route.duration, json_route.values.at("duration").get<json::Number>().value, 1e-3);
+    BOOST_CHECK_EQUAL(route.legs.size(), params.coordinates.size() - 1);
+
+    const auto &json_coordinates = json_route.values.at("geometry")
+                                       .get<json::Object>()
+                                       .values.at("coordinates")
+                                       .get<json::Array>()
+                                       .values;
+    BOOST_CHECK_EQUAL(route.geometry.size(), json_coordinates.size());
+
+    const auto &json_waypoints = json_result.values.at("waypoints").get<json::Array>().values;
+    for (std::size_t index = 0; index < json_waypoints.size(); ++index)
+    {
+        const auto &json_waypoint = json_waypoints[index].get<json::Object>();
+        BOOST_CHECK_EQUAL(result.waypoints[index].name,
+                          json_waypoint.values.at("name").get<json::String>().value);
+        BOOST_CHECK(result.waypoints[index].hint);
+    }
+
+    // errors carry the same code as the JSON response
+    RouteParameters invalid_params;
+    invalid_params.coordinates = {{Longitude{0}, Latitude{0}}, {Longitude{1000}, Latitude{1000}}};
+    RouteResult invalid_result;
+    BOOST_CHECK(osrm.Route(invalid_params, invalid_result) == Status::Error);
+    BOOST_CHECK_EQUAL(invalid_result.code, "InvalidValue");
+    BOOST_CHECK(invalid_result.routes.empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
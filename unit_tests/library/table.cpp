@@ -2,6 +2,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include "coordinates.hpp"
+#include "equal_json.hpp"
 #include "fixture.hpp"
 #include "waypoint_check.hpp"
 
@@ -11,6 +12,7 @@
 #include "osrm/engine_config.hpp"
 #include "osrm/json_container.hpp"
 #include "osrm/osrm.hpp"
+#include "osrm/results.hpp"
 #include "osrm/status.hpp"
 
 BOOST_AUTO_TEST_SUITE(table)
@@ -174,4 +176,67 @@ BOOST_AUTO_TEST_CASE(test_table_no_segment_for_some_coordinates)
     BOOST_CHECK_EQUAL(code, "NoSegment");
 }
 
+BOOST_AUTO_TEST_CASE(test_table_batch_matches_single_requests)
+{
+    using namespace osrm;
+
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    std::vector<TableParameters> batch;
+    for (const auto &locations :
+         {get_locations_in_big_component(), get_locations_in_small_component()})
+    {
+        TableParameters params;
+        params.coordinates = locations;
+        params.sources.push_back(0);
+        batch.push_back(params);
+    }
+
+    std::vector<json::Object> results;
+    const auto rc = osrm.TableBatch(batch, results);
+    BOOST_CHECK(rc == Status::Ok);
+    BOOST_REQUIRE_EQUAL(results.size(), batch.size());
+
+    for (const auto index : {0, 1})
+    {
+        json::Object reference;
+        BOOST_CHECK(osrm.Table(batch[index], reference) == Status::Ok);
+        CHECK_EQUAL_JSON(reference, results[index]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_table_plain_result_matches_json)
+{
+    using namespace osrm;
+
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    TableParameters params;
+    params.coordinates = get_locations_in_big_component();
+    params.sources.push_back(1);
+
+    json::Object json_result;
+    BOOST_CHECK(osrm.Table(params, json_result) == Status::Ok);
+
+    TableResult result;
+    BOOST_CHECK(osrm.Table(params, result) == Status::Ok);
+    BOOST_CHECK_EQUAL(result.code, "Ok");
+    BOOST_CHECK_EQUAL(result.number_of_sources, 1);
+    BOOST_CHECK_EQUAL(result.number_of_destinations, params.coordinates.size());
+    BOOST_CHECK_EQUAL(result.sources.size(), 1);
+    BOOST_CHECK_EQUAL(result.destinations.size(), params.coordinates.size());
+    BOOST_CHECK_EQUAL(result.durations.size(), params.coordinates.size());
+
+    const auto &json_row = json_result.values.at("durations")
+                               .get<json::Array>()
+                               .values.at(0)
+                               .get<json::Array>()
+                               .values;
+    for (std::size_t destination = 0; destination < json_row.size(); ++destination)
+    {
+        BOOST_CHECK_EQUAL(result.GetDuration(0, destination) / 10.,
+                          json_row[destination].get<json::Number>().value);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -151,6 +151,15 @@ class MockBaseDataFacade : public engine::datafacade::BaseDataFacade
         return {};
     }
 
+    std::vector<engine::PhantomNodeWithDistance>
+    PhantomNodeFromSegment(const util::Coordinate /*input_coordinate*/,
+                           const SegmentID /*forward_segment_id*/,
+                           const SegmentID /*reverse_segment_id*/,
+                           const unsigned short /*fwd_segment_position*/) const override
+    {
+        return {};
+    }
+
     std::pair<engine::PhantomNode, engine::PhantomNode>
     NearestPhantomNodeWithAlternativeFromBigComponent(
         const util::Coordinate /*input_coordinate*/,
@@ -0,0 +1,84 @@
+#include <boost/test/unit_test.hpp>
+
+#include "partition/annotated_partition.hpp"
+#include "partition/cell_storage.hpp"
+#include "partition/multi_level_partition.hpp"
+#include "util/static_graph.hpp"
+
+using namespace osrm;
+using namespace osrm::partition;
+
+namespace
+{
+struct MockEdge
+{
+    NodeID start;
+    NodeID target;
+};
+
+auto makeGraph(const std::vector<MockEdge> &mock_edges)
+{
+    struct EdgeData
+    {
+        bool forward;
+        bool backward;
+    };
+    using Edge = util::static_graph_details::SortableEdgeWithData<EdgeData>;
+    std::vector<Edge> edges;
+    std::size_t max_id = 0;
+    for (const auto &m : mock_edges)
+    {
+        max_id = std::max<std::size_t>(max_id, std::max(m.start, m.target));
+        edges.push_back(Edge{m.start, m.target, true, true});
+        edges.push_back(Edge{m.target, m.start, true, true});
+    }
+    std::sort(edges.begin(), edges.end());
+    return util::StaticGraph<EdgeData>(max_id + 1, edges);
+}
+}
+
+BOOST_AUTO_TEST_SUITE(annotated_partition_tests)
+
+BOOST_AUTO_TEST_CASE(cell_level_metrics)
+{
+    // node:                0  1  2  3  4  5  6  7
+    std::vector<CellID> l1{{0, 0, 1, 1, 2, 2, 3, 3}};
+    std::vector<CellID> l2{{0, 0, 0, 0, 1, 1, 1, 1}};
+    MultiLevelPartition mlp{{l1, l2}, {4, 2}};
+
+    // a path through all nodes
+    auto graph = makeGraph({{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}, {5, 6}, {6, 7}});
+    CellStorage storage(mlp, graph);
+
+    const auto metrics = AnnotatedPartition::AnalyseCells(graph, mlp, storage, {2, 3});
+    BOOST_REQUIRE_EQUAL(metrics.size(), 2);
+
+    const auto &level_1 = metrics[0];
+    BOOST_CHECK_EQUAL(level_1.max_cell_size, 2);
+    BOOST_CHECK_EQUAL(level_1.number_of_cells, 4);
+    BOOST_CHECK_EQUAL(level_1.largest_cell, 2);
+    BOOST_CHECK_EQUAL(level_1.oversized_cells, 0);
+    // nodes 1 | 2, 3 | 4, 5 | 6
+    BOOST_CHECK_EQUAL(level_1.boundary_nodes, 6);
+    BOOST_CHECK_EQUAL(level_1.max_boundary_nodes_per_cell, 2);
+    BOOST_CHECK_EQUAL(level_1.clique_entries, 1 + 4 + 4 + 1);
+    BOOST_CHECK_EQUAL(level_1.max_clique_entries, 4);
+    // every cell contains a single edge in both directions
+    BOOST_CHECK_EQUAL(level_1.customization_cost, 1 * 2 + 2 * 2 + 2 * 2 + 1 * 2);
+    BOOST_CHECK_EQUAL(level_1.query_nodes_per_cell, 2.);
+
+    const auto &level_2 = metrics[1];
+    BOOST_CHECK_EQUAL(level_2.number_of_cells, 2);
+    BOOST_CHECK_EQUAL(level_2.largest_cell, 4);
+    BOOST_CHECK_EQUAL(level_2.oversized_cells, 2);
+    // nodes 3 | 4
+    BOOST_CHECK_EQUAL(level_2.boundary_nodes, 2);
+    BOOST_CHECK_EQUAL(level_2.clique_entries, 2);
+    // the cliques of the children and the edge between them in both directions
+    BOOST_CHECK_EQUAL(level_2.customization_cost, 1 * (1 + 4 + 2) + 1 * (4 + 1 + 2));
+    BOOST_CHECK_EQUAL(level_2.query_nodes_per_cell, 3.);
+
+    BOOST_CHECK_EQUAL(AnnotatedPartition::EstimateQueryNodes(metrics), 2 + 2 * (2. + 3.));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -63,8 +63,8 @@ BOOST_AUTO_TEST_CASE(horizontal_cut_between_two_grids)
 
     for (int i = 0; i < 10; ++i)
     {
-        sources.insert(static_cast<NodeID>(i));
-        sinks.insert(static_cast<NodeID>(1000 + i));
+        sources.push_back(static_cast<NodeID>(i));
+        sinks.push_back(static_cast<NodeID>(1000 + i));
     }
 
     DinicMaxFlow flow;
@@ -72,4 +72,46 @@ BOOST_AUTO_TEST_CASE(horizontal_cut_between_two_grids)
     BOOST_CHECK(cut.num_edges == 4);
 }
 
+BOOST_AUTO_TEST_CASE(prefer_balanced_sink_side_cut)
+{
+    //
+    // 0---1---2---3---4---5---6---7
+    //                         | X |
+    //                         8---9
+    //
+    // Every edge of the path is a minimal cut. The cut next to the source only has the source on
+    // its source side, the cut next to the fully connected block of sinks is balanced.
+    auto graph = [&]() {
+        std::vector<Coordinate> coordinates;
+        for (int i = 0; i < 7; ++i)
+            coordinates.push_back(makeCoordinate(i, 0, 0.01));
+        coordinates.push_back(makeCoordinate(7, 0, 0.01));
+        coordinates.push_back(makeCoordinate(6, 1, 0.01));
+        coordinates.push_back(makeCoordinate(7, 1, 0.01));
+
+        std::vector<EdgeWithSomeAdditionalData> edges;
+        const auto connect = [&edges](const NodeID from, const NodeID to) {
+            edges.push_back({from, to, 1});
+            edges.push_back({to, from, 1});
+        };
+        for (NodeID node = 0; node < 6; ++node)
+            connect(node, node + 1);
+        for (NodeID from = 6; from < 10; ++from)
+            for (NodeID to = from + 1; to < 10; ++to)
+                connect(from, to);
+
+        groupEdgesBySource(edges.begin(), edges.end());
+        return makeBisectionGraph(coordinates, adaptToBisectionEdge(std::move(edges)));
+    }();
+
+    GraphView view(graph);
+
+    DinicMaxFlow flow;
+    const auto cut = flow(view, {0}, {9});
+    BOOST_CHECK_EQUAL(cut.num_edges, 1);
+    BOOST_CHECK_EQUAL(cut.num_nodes_source, 6);
+    for (NodeID node = 0; node < 10; ++node)
+        BOOST_CHECK_EQUAL(cut.flags[node], node < 6);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,78 @@
+#include "partition/fm_refinement.hpp"
+#include "partition/graph_generator.hpp"
+#include "partition/graph_view.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace osrm::partition;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_SUITE(fm_refinement)
+
+namespace
+{
+auto makeGrid(const int rows, const int cols)
+{
+    auto coordinates = makeGridCoordinates(rows, cols, 0.01, 0, 0);
+    auto edges = makeGridEdges(rows, cols, 0);
+    groupEdgesBySource(edges.begin(), edges.end());
+    return makeBisectionGraph(coordinates, adaptToBisectionEdge(std::move(edges)));
+}
+}
+
+BOOST_AUTO_TEST_CASE(straighten_zigzag_cut)
+{
+    const int rows = 10;
+    const int cols = 10;
+    auto graph = makeGrid(rows, cols);
+    GraphView view(graph);
+
+    // the left half of the grid, with the boundary shifted by one column in every other row:
+    //  xxxxx.....
+    //  xxxx......
+    //  xxxxx.....
+    DinicMaxFlow::MinCut cut;
+    cut.flags.resize(rows * cols);
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < cols; ++c)
+            cut.flags[r * cols + c] = c + r % 2 < cols / 2;
+    cut.num_nodes_source = std::count(cut.flags.begin(), cut.flags.end(), true);
+    cut.num_edges = 0;
+
+    const auto refined = refineCut(view, cut, 1.2, 10);
+
+    // one edge per row for the straight cut, instead of 10 + 9 for the zigzag
+    BOOST_CHECK_EQUAL(refined.num_edges, rows);
+    BOOST_CHECK_EQUAL(refined.num_nodes_source,
+                      std::count(refined.flags.begin(), refined.flags.end(), true));
+    BOOST_CHECK_LE(refined.num_nodes_source, 60);
+    BOOST_CHECK_GE(refined.num_nodes_source, 40);
+}
+
+BOOST_AUTO_TEST_CASE(respect_balance)
+{
+    const int rows = 10;
+    const int cols = 10;
+    auto graph = makeGrid(rows, cols);
+    GraphView view(graph);
+
+    // three columns on the source side, the sink side is larger than the balance allows
+    DinicMaxFlow::MinCut cut;
+    cut.flags.resize(rows * cols, false);
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < 3; ++c)
+            cut.flags[r * cols + c] = true;
+    cut.num_nodes_source = 30;
+    cut.num_edges = 0;
+
+    const auto refined = refineCut(view, cut, 1.2, 10);
+
+    // the sink side cannot grow any further
+    BOOST_CHECK_GE(refined.num_nodes_source, 30);
+    BOOST_CHECK_LE(refined.num_edges, rows);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
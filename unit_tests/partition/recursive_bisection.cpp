@@ -66,7 +66,7 @@ BOOST_AUTO_TEST_CASE(dividing_four_grid_cells)
         return makeBisectionGraph(grid_coordinates, adaptToBisectionEdge(std::move(grid_edges)));
     }();
 
-    RecursiveBisection bisection(graph, 120, 1.1, 0.25, 10, 1);
+    RecursiveBisection bisection(graph, 120, 1.1, 0.25, 10, 1, 0);
 
     const auto result = bisection.BisectionIDs();
     // all same IDs withing a group
@@ -95,6 +95,27 @@ BOOST_AUTO_TEST_CASE(valid_route_hint)
         util::Coordinate(util::FloatLongitude{7.432251}, util::FloatLatitude{43.745995}));
 }
 
+BOOST_AUTO_TEST_CASE(valid_compact_route_hint)
+{
+    engine::PhantomNode phantom;
+    phantom.forward_segment_id = {42, true};
+    phantom.reverse_segment_id = {43, false};
+    phantom.location = {util::FloatLongitude{7.432251}, util::FloatLatitude{43.745995}};
+    phantom.input_location = {util::FloatLongitude{1}, util::FloatLatitude{2}};
+    const auto compact_hint = engine::Hint{phantom, 0}.ToCompactBase64();
+
+    auto result = parseParameters<RouteParameters>(
+        "1,2;3,4?hints=" + compact_hint +
+        ";ZgYAgP___38EAAAAIAAAAD4AAAAdAAAABAAAACAAAAA-"
+        "AAAAHQAAABQAAABqaHEAt4KbAjtocQDLgpsCBQAPAJDIe3E=");
+    BOOST_CHECK(result);
+    BOOST_CHECK_EQUAL(result->hints.size(), 2);
+    BOOST_CHECK(result->hints[0]->IsCompact());
+    BOOST_CHECK_EQUAL(result->hints[0]->phantom.forward_segment_id.id, 42);
+    BOOST_CHECK(!result->hints[0]->phantom.reverse_segment_id.enabled);
+    BOOST_CHECK(!result->hints[1]->IsCompact());
+}
+
 BOOST_AUTO_TEST_CASE(valid_route_urls)
 {
     std::vector<util::Coordinate> coords_1 = {{util::FloatLongitude{1}, util::FloatLatitude{2}},
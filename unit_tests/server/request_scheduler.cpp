@@ -0,0 +1,198 @@
+#include "server/request_scheduler.hpp"
+#include "server/api/parsed_url.hpp"
+
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(request_scheduler)
+
+using namespace osrm;
+using namespace osrm::server;
+
+BOOST_AUTO_TEST_CASE(classify_by_service_and_coordinates)
+{
+    const std::size_t heavy_cost = 100;
+
+    auto nearest = classifyRequest({"nearest", 1, "car", "1,2?number=3", 17UL}, heavy_cost);
+    BOOST_CHECK(nearest.priority == RequestPriority::Interactive);
+
+    auto route = classifyRequest({"route", 1, "car", "1,2;3,4;5,6", 15UL}, heavy_cost);
+    BOOST_CHECK(route.priority == RequestPriority::Normal);
+    BOOST_CHECK_EQUAL(route.cost, 3);
+
+    auto small_table = classifyRequest({"table", 1, "car", "1,2;3,4;5,6", 15UL}, heavy_cost);
+    BOOST_CHECK(small_table.priority == RequestPriority::Normal);
+    BOOST_CHECK_EQUAL(small_table.cost, 9);
+
+    std::string coordinates = "0,0";
+    for (auto i = 0; i < 19; ++i)
+        coordinates += ";1,1";
+    auto large_table = classifyRequest({"table", 1, "car", coordinates, 15UL}, heavy_cost);
+    BOOST_CHECK(large_table.priority == RequestPriority::Bulk);
+    BOOST_CHECK_EQUAL(large_table.cost, 400);
+
+    auto one_to_many = classifyRequest(
+        {"table", 1, "car", coordinates + "?sources=0&destinations=all", 15UL}, heavy_cost);
+    BOOST_CHECK(one_to_many.priority == RequestPriority::Normal);
+    BOOST_CHECK_EQUAL(one_to_many.cost, 20);
+
+    auto trip = classifyRequest({"trip", 1, "car", coordinates, 15UL}, heavy_cost);
+    BOOST_CHECK(trip.priority == RequestPriority::Bulk);
+
+    // _p~iF~ps|U_ulLnnqC_mqNvxq`@ encodes three coordinates
+    auto polyline = classifyRequest(
+        {"route", 1, "car", "polyline(_p~iF~ps|U_ulLnnqC_mqNvxq`@)", 15UL}, heavy_cost);
+    BOOST_CHECK_EQUAL(polyline.cost, 3);
+}
+
+BOOST_AUTO_TEST_CASE(reject_when_queue_full)
+{
+    SchedulerConfig config;
+    config.num_workers = 1;
+    config.max_queue_size = 2;
+    RequestScheduler scheduler(config);
+
+    // not started, so nothing is dequeued
+    BOOST_CHECK(scheduler.Submit({RequestPriority::Bulk, 1000}, [] {}));
+    BOOST_CHECK(scheduler.Submit({RequestPriority::Bulk, 1000}, [] {}));
+    BOOST_CHECK(!scheduler.Submit({RequestPriority::Bulk, 1000}, [] {}));
+    BOOST_CHECK_EQUAL(scheduler.GetNumRejected(), 1);
+
+    // other classes have their own queue
+    BOOST_CHECK(scheduler.Submit({RequestPriority::Interactive, 1}, [] {}));
+}
+
+BOOST_AUTO_TEST_CASE(reject_queued_tasks_on_stop)
+{
+    SchedulerConfig config;
+    config.num_workers = 1;
+    RequestScheduler scheduler(config);
+
+    // not started, so both tasks are still queued when the scheduler stops
+    int num_run = 0;
+    int num_rejected = 0;
+    BOOST_CHECK(scheduler.Submit(
+        {RequestPriority::Bulk, 1000}, [&] { ++num_run; }, [&] { ++num_rejected; }));
+    BOOST_CHECK(scheduler.Submit(
+        {RequestPriority::Interactive, 1}, [&] { ++num_run; }, [&] { ++num_rejected; }));
+    BOOST_CHECK(scheduler.Submit({RequestPriority::Normal, 10}, [&] { ++num_run; }));
+    scheduler.Stop();
+
+    BOOST_CHECK_EQUAL(num_run, 0);
+    BOOST_CHECK_EQUAL(num_rejected, 2);
+    BOOST_CHECK_EQUAL(scheduler.GetNumRejected(), 0);
+
+    // a stopped scheduler doesn't accept new tasks
+    BOOST_CHECK(!scheduler.Submit(
+        {RequestPriority::Interactive, 1}, [&] { ++num_run; }, [&] { ++num_rejected; }));
+    BOOST_CHECK_EQUAL(num_rejected, 2);
+}
+
+BOOST_AUTO_TEST_CASE(serve_by_priority)
+{
+    SchedulerConfig config;
+    config.num_workers = 1;
+    RequestScheduler scheduler(config);
+
+    std::mutex mutex;
+    std::condition_variable done;
+    std::vector<RequestPriority> order;
+    const auto record = [&](const RequestPriority priority) {
+        return [&, priority] {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(priority);
+            done.notify_one();
+        };
+    };
+
+    scheduler.Submit({RequestPriority::Bulk, 1000}, record(RequestPriority::Bulk));
+    scheduler.Submit({RequestPriority::Normal, 10}, record(RequestPriority::Normal));
+    scheduler.Submit({RequestPriority::Interactive, 1}, record(RequestPriority::Interactive));
+    scheduler.Start();
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&] { return order.size() == 3; });
+    }
+    scheduler.Stop();
+
+    BOOST_CHECK(order[0] == RequestPriority::Interactive);
+    BOOST_CHECK(order[1] == RequestPriority::Normal);
+    BOOST_CHECK(order[2] == RequestPriority::Bulk);
+}
+
+BOOST_AUTO_TEST_CASE(bulk_requests_leave_a_worker_free)
+{
+    SchedulerConfig config;
+    config.num_workers = 2;
+    RequestScheduler scheduler(config);
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool release_bulk = false;
+    unsigned running_bulk = 0;
+    bool interactive_done = false;
+
+    const auto bulk = [&] {
+        std::unique_lock<std::mutex> lock(mutex);
+        ++running_bulk;
+        changed.notify_all();
+        changed.wait(lock, [&] { return release_bulk; });
+    };
+    scheduler.Submit({RequestPriority::Bulk, 1000}, bulk);
+    scheduler.Submit({RequestPriority::Bulk, 1000}, bulk);
+    scheduler.Start();
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&] { return running_bulk > 0; });
+    }
+
+    // the second bulk request waits, so the interactive one finds a free worker
+    scheduler.Submit({RequestPriority::Interactive, 1}, [&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        interactive_done = true;
+        changed.notify_all();
+    });
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        BOOST_CHECK(changed.wait_for(
+            lock, std::chrono::seconds(10), [&] { return interactive_done; }));
+        BOOST_CHECK_EQUAL(running_bulk, 1);
+        release_bulk = true;
+    }
+    changed.notify_all();
+    scheduler.Stop();
+}
+
+BOOST_AUTO_TEST_CASE(throwing_task_keeps_worker_alive)
+{
+    SchedulerConfig config;
+    config.num_workers = 1;
+    RequestScheduler scheduler(config);
+
+    std::mutex mutex;
+    std::condition_variable done;
+    bool second_done = false;
+
+    scheduler.Submit({RequestPriority::Normal, 1}, [] { throw std::runtime_error("failed"); });
+    scheduler.Submit({RequestPriority::Normal, 1}, [&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        second_done = true;
+        done.notify_one();
+    });
+    scheduler.Start();
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        BOOST_CHECK(done.wait_for(lock, std::chrono::seconds(10), [&] { return second_done; }));
+    }
+    scheduler.Stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,65 @@
+#include "util/concurrent_interner.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(concurrent_interner_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(intern_returns_same_entry)
+{
+    ConcurrentInterner<std::string, unsigned> interner;
+
+    auto &first = interner.Intern("Hauptstraße", [] { return 42u; });
+    auto &second = interner.Intern("Hauptstraße", [] { return 23u; });
+    auto &other = interner.Intern("Nebenstraße");
+
+    BOOST_CHECK_EQUAL(&first, &second);
+    BOOST_CHECK_EQUAL(first.first, "Hauptstraße");
+    BOOST_CHECK_EQUAL(first.second, 42u);
+    BOOST_CHECK_NE(&first, &other);
+    BOOST_CHECK_EQUAL(other.second, 0u);
+    BOOST_CHECK_EQUAL(interner.Size(), 2);
+
+    // values can be changed through the entries
+    first.second = 7;
+    BOOST_CHECK_EQUAL(interner.Intern("Hauptstraße").second, 7u);
+}
+
+BOOST_AUTO_TEST_CASE(intern_concurrently)
+{
+    ConcurrentInterner<std::string, unsigned> interner;
+
+    const std::size_t num_keys = 1000;
+    const std::size_t num_lookups = 100000;
+    std::atomic<unsigned> num_created{0};
+    std::vector<ConcurrentInterner<std::string, unsigned>::Entry *> entries(num_lookups);
+
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, num_lookups),
+                      [&](const tbb::blocked_range<std::size_t> &range) {
+                          for (auto index = range.begin(); index != range.end(); ++index)
+                          {
+                              entries[index] = &interner.Intern(
+                                  std::to_string(index % num_keys), [&] { return num_created++; });
+                          }
+                      });
+
+    // every key was created exactly once and all lookups share its entry
+    BOOST_CHECK_EQUAL(num_created, num_keys);
+    BOOST_CHECK_EQUAL(interner.Size(), num_keys);
+    for (std::size_t index = 0; index < num_lookups; ++index)
+    {
+        BOOST_CHECK_EQUAL(entries[index], entries[index % num_keys]);
+        BOOST_CHECK_EQUAL(entries[index]->first, std::to_string(index % num_keys));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
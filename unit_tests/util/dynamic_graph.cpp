@@ -120,4 +120,70 @@ BOOST_AUTO_TEST_CASE(renumber_test)
     BOOST_CHECK_EQUAL(simple_graph.GetEdgeData(eit).id, 2);
 }
 
+BOOST_AUTO_TEST_CASE(insert_edges_test)
+{
+    std::vector<TestInputEdge> input_edges = {TestInputEdge{0, 1, TestData{1}},
+                                              TestInputEdge{3, 0, TestData{2}},
+                                              TestInputEdge{3, 4, TestData{3}},
+                                              TestInputEdge{4, 3, TestData{4}}};
+    TestDynamicGraph simple_graph(5, input_edges);
+
+    // the edges are stored without free space, all three nodes move to the end of the edge list
+    std::vector<TestInputEdge> new_edges = {TestInputEdge{0, 2, TestData{5}},
+                                            TestInputEdge{0, 3, TestData{6}},
+                                            TestInputEdge{2, 1, TestData{7}},
+                                            TestInputEdge{4, 0, TestData{8}}};
+    simple_graph.InsertEdges(new_edges);
+
+    BOOST_CHECK_EQUAL(simple_graph.GetNumberOfEdges(), 8);
+    BOOST_CHECK_EQUAL(simple_graph.GetOutDegree(0), 3);
+    BOOST_CHECK_EQUAL(simple_graph.GetOutDegree(2), 1);
+    BOOST_CHECK_EQUAL(simple_graph.GetOutDegree(3), 2);
+    BOOST_CHECK_EQUAL(simple_graph.GetOutDegree(4), 2);
+
+    BOOST_CHECK_EQUAL(simple_graph.GetEdgeData(simple_graph.FindEdge(0, 1)).id, 1);
+    BOOST_CHECK_EQUAL(simple_graph.GetEdgeData(simple_graph.FindEdge(0, 2)).id, 5);
+    BOOST_CHECK_EQUAL(simple_graph.GetEdgeData(simple_graph.FindEdge(0, 3)).id, 6);
+    BOOST_CHECK_EQUAL(simple_graph.GetEdgeData(simple_graph.FindEdge(2, 1)).id, 7);
+    BOOST_CHECK_EQUAL(simple_graph.GetEdgeData(simple_graph.FindEdge(3, 0)).id, 2);
+    BOOST_CHECK_EQUAL(simple_graph.GetEdgeData(simple_graph.FindEdge(3, 4)).id, 3);
+    BOOST_CHECK_EQUAL(simple_graph.GetEdgeData(simple_graph.FindEdge(4, 0)).id, 8);
+    BOOST_CHECK_EQUAL(simple_graph.GetEdgeData(simple_graph.FindEdge(4, 3)).id, 4);
+
+    // the free space behind a node is used before the node moves again
+    simple_graph.InsertEdges(std::vector<TestInputEdge>{TestInputEdge{0, 4, TestData{9}}});
+    BOOST_CHECK_EQUAL(simple_graph.GetOutDegree(0), 4);
+    BOOST_CHECK_EQUAL(simple_graph.GetEdgeData(simple_graph.FindEdge(0, 4)).id, 9);
+    BOOST_CHECK_EQUAL(simple_graph.GetEdgeData(simple_graph.FindEdge(0, 1)).id, 1);
+}
+
+BOOST_AUTO_TEST_CASE(insert_edges_at_node_without_edges_test)
+{
+    std::vector<TestInputEdge> input_edges = {TestInputEdge{0, 1, TestData{1}},
+                                              TestInputEdge{0, 2, TestData{2}},
+                                              TestInputEdge{1, 0, TestData{3}},
+                                              TestInputEdge{2, 0, TestData{4}}};
+    TestDynamicGraph simple_graph(4, input_edges);
+
+    // node 1 loses its only edge, its first edge now points into the free space behind node 0
+    simple_graph.DeleteEdgesTo(0, 2);
+    simple_graph.DeleteEdgesTo(1, 0);
+    BOOST_REQUIRE_EQUAL(simple_graph.GetOutDegree(1), 0);
+
+    // node 0 needs both free edges behind it, node 1 must not use the second one
+    std::vector<TestInputEdge> new_edges = {TestInputEdge{0, 2, TestData{5}},
+                                            TestInputEdge{0, 3, TestData{6}},
+                                            TestInputEdge{1, 2, TestData{7}}};
+    simple_graph.InsertEdges(new_edges);
+
+    BOOST_CHECK_EQUAL(simple_graph.GetNumberOfEdges(), 5);
+    BOOST_CHECK_EQUAL(simple_graph.GetOutDegree(0), 3);
+    BOOST_CHECK_EQUAL(simple_graph.GetOutDegree(1), 1);
+    BOOST_CHECK_EQUAL(simple_graph.GetEdgeData(simple_graph.FindEdge(0, 1)).id, 1);
+    BOOST_CHECK_EQUAL(simple_graph.GetEdgeData(simple_graph.FindEdge(0, 2)).id, 5);
+    BOOST_CHECK_EQUAL(simple_graph.GetEdgeData(simple_graph.FindEdge(0, 3)).id, 6);
+    BOOST_CHECK_EQUAL(simple_graph.GetEdgeData(simple_graph.FindEdge(1, 2)).id, 7);
+    BOOST_CHECK_EQUAL(simple_graph.GetEdgeData(simple_graph.FindEdge(2, 0)).id, 4);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,130 @@
+#include "../common/range_tools.hpp"
+
+#include "util/external_sort.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(external_sort_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+namespace
+{
+struct KeyValue
+{
+    std::uint32_t key;
+    std::uint32_t value;
+};
+
+std::vector<KeyValue> randomKeyValues(const std::size_t size, const std::uint32_t max_key)
+{
+    std::mt19937 generator(1337);
+    std::uniform_int_distribution<std::uint32_t> key_distribution(0, max_key);
+
+    std::vector<KeyValue> values(size);
+    for (std::size_t index = 0; index < size; ++index)
+    {
+        values[index] = {key_distribution(generator), static_cast<std::uint32_t>(index)};
+    }
+    return values;
+}
+
+const auto compare_keys = [](const KeyValue &lhs, const KeyValue &rhs) {
+    return lhs.key < rhs.key;
+};
+
+// A new directory for the runs of a test, so the check for leftover runs does not depend on other
+// users of the system temp directory
+struct TemporaryDirectory
+{
+    TemporaryDirectory()
+        : path(boost::filesystem::temp_directory_path() /
+               boost::filesystem::unique_path("osrm-external-sort-test-%%%%-%%%%"))
+    {
+        boost::filesystem::create_directories(path);
+    }
+    ~TemporaryDirectory() { boost::filesystem::remove_all(path); }
+
+    const boost::filesystem::path path;
+};
+
+std::vector<std::uint32_t> keys(const std::vector<KeyValue> &values)
+{
+    std::vector<std::uint32_t> result(values.size());
+    std::transform(values.begin(), values.end(), result.begin(), [](const KeyValue &value) {
+        return value.key;
+    });
+    return result;
+}
+}
+
+BOOST_AUTO_TEST_CASE(sort_in_memory)
+{
+    auto values = randomKeyValues(10000, 1000);
+    auto reference = values;
+    std::stable_sort(reference.begin(), reference.end(), compare_keys);
+
+    ExternalSortConfig config;
+    externalSort(values.begin(), values.end(), compare_keys, config);
+
+    const auto sorted_keys = keys(values);
+    const auto reference_keys = keys(reference);
+    CHECK_EQUAL_COLLECTIONS(sorted_keys, reference_keys);
+}
+
+BOOST_AUTO_TEST_CASE(sort_with_runs_on_disk)
+{
+    auto values = randomKeyValues(20003, 5000);
+    auto reference = values;
+    std::stable_sort(reference.begin(), reference.end(), compare_keys);
+
+    TemporaryDirectory directory;
+    ExternalSortConfig config;
+    config.temporary_directory = directory.path;
+    // 1000 elements fit into memory, so 41 runs are merged
+    config.memory_budget = 1000 * sizeof(KeyValue);
+    externalSort(values.begin(), values.end(), compare_keys, config);
+
+    const auto sorted_keys = keys(values);
+    const auto reference_keys = keys(reference);
+    CHECK_EQUAL_COLLECTIONS(sorted_keys, reference_keys);
+
+    // no element got lost or duplicated
+    std::vector<std::uint32_t> original_indices(values.size());
+    std::transform(values.begin(), values.end(), original_indices.begin(), [](const KeyValue &v) {
+        return v.value;
+    });
+    std::sort(original_indices.begin(), original_indices.end());
+    for (std::size_t index = 0; index < original_indices.size(); ++index)
+    {
+        BOOST_CHECK_EQUAL(original_indices[index], index);
+    }
+
+    // all temporary runs and their directory are removed
+    BOOST_CHECK(boost::filesystem::is_empty(directory.path));
+}
+
+BOOST_AUTO_TEST_CASE(sort_small_ranges)
+{
+    ExternalSortConfig config;
+    config.memory_budget = 0;
+
+    std::vector<KeyValue> empty;
+    externalSort(empty.begin(), empty.end(), compare_keys, config);
+    BOOST_CHECK(empty.empty());
+
+    std::vector<KeyValue> values{{3, 0}, {1, 1}, {2, 2}};
+    externalSort(values.begin(), values.end(), compare_keys, config);
+    BOOST_CHECK_EQUAL(values[0].key, 1);
+    BOOST_CHECK_EQUAL(values[1].key, 2);
+    BOOST_CHECK_EQUAL(values[2].key, 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
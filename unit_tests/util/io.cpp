@@ -19,6 +19,7 @@ const static std::string IO_CORRUPT_FINGERPRINT_FILE = "corrupt_fingerprint_file
 const static std::string IO_INCOMPATIBLE_FINGERPRINT_FILE =
     "incompatible_fingerprint_file_test_io.tmp";
 const static std::string IO_TEXT_FILE = "plain_text_file.tmp";
+const static std::string IO_MAPPED_FILE = "mapped_test_io.tmp";
 
 BOOST_AUTO_TEST_SUITE(osrm_io)
 
@@ -185,4 +186,48 @@ BOOST_AUTO_TEST_CASE(io_read_lines)
     }
 }
 
+BOOST_AUTO_TEST_CASE(io_mapped_data)
+{
+    std::vector<int> data_in(53);
+    std::iota(begin(data_in), end(data_in), 0);
+
+    {
+        osrm::storage::io::FileWriter outfile(IO_MAPPED_FILE,
+                                              osrm::storage::io::FileWriter::GenerateFingerprint);
+        outfile.WriteElementCount64(42);
+        osrm::storage::serialization::write(outfile, data_in);
+    }
+
+    osrm::storage::io::MappedFileReader infile(
+        IO_MAPPED_FILE, osrm::storage::io::MappedFileReader::VerifyFingerprint);
+    BOOST_CHECK_EQUAL(infile.ReadElementCount64(), 42);
+    const auto data_out = infile.ReadVectorView<int>();
+
+    BOOST_REQUIRE_EQUAL(data_in.size(), data_out.size());
+    BOOST_CHECK_EQUAL_COLLECTIONS(data_out.begin(), data_out.end(), data_in.begin(), data_in.end());
+
+    // reading past the end of the file
+    BOOST_CHECK_THROW(infile.ReadOne<int>(), osrm::util::RuntimeError);
+}
+
+BOOST_AUTO_TEST_CASE(io_mapped_corrupt_fingerprint)
+{
+    {
+        osrm::storage::io::FileWriter outfile(IO_MAPPED_FILE,
+                                              osrm::storage::io::FileWriter::HasNoFingerprint);
+        outfile.WriteOne(0xDEADBEEFCAFEFACE);
+    }
+
+    try
+    {
+        osrm::storage::io::MappedFileReader infile(
+            IO_MAPPED_FILE, osrm::storage::io::MappedFileReader::VerifyFingerprint);
+        BOOST_REQUIRE_MESSAGE(false, "Should not get here");
+    }
+    catch (const osrm::util::RuntimeError &e)
+    {
+        BOOST_REQUIRE(e.GetCode() == osrm::ErrorCode::InvalidFingerprint);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()